@@ -34,6 +34,7 @@
 #include <liblangutil/Exceptions.h>
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/Parallel.h>
 #include <libsolutil/StringUtils.h>
 
 #include <fmt/format.h>
@@ -685,8 +686,26 @@ AssemblyItem Assembly::newImmutableAssignment(std::string const& _identifier)
 	return AssemblyItem{AssignImmutable, h};
 }
 
-Assembly& Assembly::optimise(OptimiserSettings const& _settings)
+Assembly& Assembly::optimise(OptimiserSettings const& _settings, size_t _concurrency)
 {
+	if (util::effectiveConcurrency(_concurrency) > 1 && !m_tagReplacements)
+	{
+		// Sub-assemblies are independent of each other, so all sub-assemblies of the same height
+		// are optimised concurrently, starting with the leaves. Each of them receives the tags
+		// referenced by the assembly the serial traversal in optimiseInternal reaches it from first.
+		// Their tag replacements are cached and applied to the super-assemblies in the same order
+		// as without concurrency, so the result is identical.
+		std::map<Assembly const*, std::set<size_t>> tagsReferencedFromOutside;
+		auto const subAssemblies = subAssembliesByHeight([&](Assembly const& _parent, size_t _subId) {
+			tagsReferencedFromOutside[_parent.m_subs[_subId].get()] =
+				JumpdestRemover::referencedTags(_parent.m_items, _subId);
+		});
+		for (std::vector<Assembly*> const& level: subAssemblies)
+			util::parallelFor(_concurrency, level.size(), [&](size_t _index) {
+				Assembly& sub = *level[_index];
+				sub.optimiseInternal(_settings, tagsReferencedFromOutside.at(&sub));
+			});
+	}
 	optimiseInternal(_settings, {});
 	return *this;
 }
@@ -834,16 +853,52 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 	return *m_tagReplacements;
 }
 
-LinkerObject const& Assembly::assemble() const
+std::vector<std::vector<Assembly*>> Assembly::subAssembliesByHeight(
+	std::function<void(Assembly const& _parent, size_t _subId)> const& _onFirstVisit
+) const
+{
+	std::vector<std::vector<Assembly*>> subAssemblies;
+	std::map<Assembly const*, size_t> heights;
+	std::function<size_t(Assembly const&)> visit = [&](Assembly const& _assembly) -> size_t {
+		size_t height = 0;
+		for (size_t subId = 0; subId < _assembly.m_subs.size(); ++subId)
+		{
+			Assembly& sub = *_assembly.m_subs[subId];
+			auto it = heights.find(&sub);
+			if (it == heights.end())
+			{
+				if (_onFirstVisit)
+					_onFirstVisit(_assembly, subId);
+				size_t subHeight = visit(sub);
+				it = heights.emplace(&sub, subHeight).first;
+				if (subAssemblies.size() <= subHeight)
+					subAssemblies.resize(subHeight + 1);
+				subAssemblies[subHeight].push_back(&sub);
+			}
+			height = std::max(height, it->second + 1);
+		}
+		return height;
+	};
+	visit(*this);
+	return subAssemblies;
+}
+
+LinkerObject const& Assembly::assemble(size_t _concurrency) const
 {
 	assertThrow(!m_invalid, AssemblyException, "Attempted to assemble invalid Assembly object.");
 	// Return the already assembled object, if present.
-	if (!m_assembledObject.bytecode.empty())
-		return m_assembledObject;
-	// Otherwise ensure the object is actually clear.
-	assertThrow(m_assembledObject.linkReferences.empty(), AssemblyException, "Unexpected link references.");
+	if (m_assembledObject)
+		return *m_assembledObject;
+
+	// Sub-assemblies are assembled (and cached) bottom-up, all sub-assemblies of the same height
+	// concurrently. Only linking them into this assembly below is serial.
+	if (util::effectiveConcurrency(_concurrency) > 1)
+		for (std::vector<Assembly*> const& level: subAssembliesByHeight())
+			util::parallelFor(_concurrency, level.size(), [&](size_t _index) {
+				level[_index]->assemble();
+			});
 
-	LinkerObject& ret = m_assembledObject;
+	LinkerObject ret;
 
 	size_t subTagSize = 1;
 	std::map<u256, std::pair<std::string, std::vector<size_t>>> immutableReferencesBySub;
@@ -1125,7 +1180,8 @@ LinkerObject const& Assembly::assemble() const
 		bytesRef r(ret.bytecode.data() + pos, bytesPerDataRef);
 		toBigEndian(ret.bytecode.size(), r);
 	}
-	return ret;
+	m_assembledObject = std::move(ret);
+	return *m_assembledObject;
 }
 
 std::vector<size_t> Assembly::decodeSubPath(size_t _subObjectId) const
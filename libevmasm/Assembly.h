@@ -34,10 +34,12 @@
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <memory>
 #include <map>
+#include <optional>
 #include <utility>
 
 namespace solidity::evmasm
@@ -114,7 +116,9 @@ public:
 	langutil::EVMVersion const& evmVersion() const { return m_evmVersion; }
 
 	/// Assembles the assembly into bytecode. The assembly should not be modified after this call, since the assembled version is cached.
-	LinkerObject const& assemble() const;
+	/// @param _concurrency maximum number of threads used to assemble different sub-assemblies
+	///                     concurrently. Zero selects the number of hardware threads.
+	LinkerObject const& assemble(size_t _concurrency = 1) const;
 
 	struct OptimiserSettings
 	{
@@ -134,7 +138,10 @@ public:
 
 	/// Modify and return the current assembly such that creation and execution gas usage
 	/// is optimised according to the settings in @a _settings.
-	Assembly& optimise(OptimiserSettings const& _settings);
+	/// @param _concurrency maximum number of threads used to optimise different sub-assemblies
+	///                     concurrently. Zero selects the number of hardware threads.
+	///                     The result does not depend on it.
+	Assembly& optimise(OptimiserSettings const& _settings, size_t _concurrency = 1);
 
 	/// Create a text representation of the assembly.
 	std::string assemblyString(
@@ -181,6 +188,15 @@ protected:
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> const& optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
 
+	/// @returns the distinct sub-assemblies of this assembly at any depth, grouped by their height
+	/// in the assembly tree, so that every sub-assembly comes after all of its own sub-assemblies.
+	/// Sub-assemblies shared by several assemblies are included once, when the depth-first
+	/// traversal of optimiseInternal and assemble first reaches them. @a _onFirstVisit is then
+	/// called with the assembly it reaches them from and their index in it.
+	std::vector<std::vector<Assembly*>> subAssembliesByHeight(
+		std::function<void(Assembly const& _parent, size_t _subId)> const& _onFirstVisit = {}
+	) const;
+
 	unsigned codeSize(unsigned subTagSize) const;
 
 	/// Add all assembly items from given JSON array. This function imports the items by iterating through
@@ -234,7 +250,9 @@ protected:
 	/// If set, it means the optimizer has run and we will not run it again.
 	std::optional<std::map<u256, u256>> m_tagReplacements;
 
-	mutable LinkerObject m_assembledObject;
+	/// The result of assemble(). Set once assembling is complete, so that the object is only
+	/// assembled once even if it is a sub-assembly of several assemblies.
+	mutable std::optional<LinkerObject> m_assembledObject;
 	mutable std::vector<size_t> m_tagPositionsInBytecode;
 
 	langutil::EVMVersion m_evmVersion;
@@ -51,6 +51,8 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+
 using namespace solidity;
 using namespace solidity::langutil;
 
@@ -81,39 +83,20 @@ char CharStream::setPosition(size_t _location)
 std::string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = std::string::size_type;
-	size_type searchStart = std::min<size_type>(m_source.size(), size_type(_position));
-	if (searchStart > 0)
-		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == std::string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	std::string line = m_source.substr(
-		lineStart,
-		std::min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
-	if (!line.empty() && line.back() == '\r')
-		line.pop_back();
-	return line;
+	size_t const line = lineIndex(std::min<size_t>(m_source.size(), static_cast<size_t>(_position)));
+	size_t const lineStart = m_lineStarts[line];
+	size_t const lineEnd = line + 1 < m_lineStarts.size() ? m_lineStarts[line + 1] - 1 : m_source.size();
+	std::string lineText = m_source.substr(lineStart, lineEnd - lineStart);
+	if (!lineText.empty() && lineText.back() == '\r')
+		lineText.pop_back();
+	return lineText;
 }
 
 LineColumn CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = std::string::size_type;
-	using diff_type = std::string::difference_type;
-	size_type searchPosition = std::min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == std::string::npos ? 0 : lineStart + 1;
-	}
-	return LineColumn{lineNumber, static_cast<int>(searchPosition - lineStart)};
+	size_t const searchPosition = std::min<size_t>(m_source.size(), static_cast<size_t>(_position));
+	size_t const line = lineIndex(searchPosition);
+	return LineColumn{static_cast<int>(line), static_cast<int>(searchPosition - m_lineStarts[line])};
 }
 
 std::string_view CharStream::text(SourceLocation const& _location) const
@@ -146,7 +129,18 @@ std::string CharStream::singleLineSnippet(std::string const& _sourceCode, Source
 
 std::optional<int> CharStream::translateLineColumnToPosition(LineColumn const& _lineColumn) const
 {
-	return translateLineColumnToPosition(m_source, _lineColumn);
+	if (_lineColumn.line < 0 || _lineColumn.column < 0)
+		return std::nullopt;
+
+	size_t const line = static_cast<size_t>(_lineColumn.line);
+	if (line >= m_lineStarts.size())
+		return std::nullopt;
+
+	size_t const lineStart = m_lineStarts[line];
+	size_t const endOfLine = line + 1 < m_lineStarts.size() ? m_lineStarts[line + 1] - 1 : m_source.size();
+	if (lineStart + static_cast<size_t>(_lineColumn.column) > endOfLine)
+		return std::nullopt;
+	return static_cast<int>(lineStart + static_cast<size_t>(_lineColumn.column));
 }
 
 std::optional<int> CharStream::translateLineColumnToPosition(std::string const& _text, LineColumn const& _input)
@@ -172,3 +166,16 @@ std::optional<int> CharStream::translateLineColumnToPosition(std::string const&
 	return offset + static_cast<size_t>(_input.column);
 }
 
+std::vector<size_t> CharStream::computeLineStarts(std::string const& _source)
+{
+	std::vector<size_t> lineStarts{0};
+	for (size_t position = _source.find('\n'); position != std::string::npos; position = _source.find('\n', position + 1))
+		lineStarts.push_back(position + 1);
+	return lineStarts;
+}
+
+size_t CharStream::lineIndex(size_t _position) const
+{
+	solAssert(_position <= m_source.size());
+	return static_cast<size_t>(std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), _position) - m_lineStarts.begin()) - 1;
+}
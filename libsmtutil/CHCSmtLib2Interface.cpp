@@ -36,6 +36,7 @@
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <string_view>
 
 using namespace solidity;
 using namespace solidity::util;
@@ -96,17 +97,37 @@ std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Inte
 {
 	std::string query = dumpQuery(_block);
 	std::string response = querySolver(query);
+	return queryResult(response);
+}
+
+std::function<std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph>()> CHCSmtLib2Interface::deferredQuery(Expression const& _block)
+{
+	if (m_smtCallback)
+		setupSmtCallback();
+	// Only the (short) parts of the query that change when rules are added are copied,
+	// the rules are read from the accumulated output when the query is solved.
+	return [
+		this,
+		header = createHeaderAndDeclarations(),
+		rulesSize = m_accumulatedOutput.size(),
+		queryAssertion = createQueryAssertion(_block.name)
+	]() {
+		return queryResult(querySolver(composeQuery(header, rulesSize, queryAssertion), true));
+	};
+}
 
+std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::queryResult(std::string const& _response) const
+{
 	CheckResult result;
 	// TODO proper parsing
-	if (boost::starts_with(response, "sat"))
+	if (boost::starts_with(_response, "sat"))
 	{
-		auto maybeInvariants = invariantsFromSolverResponse(response);
+		auto maybeInvariants = invariantsFromSolverResponse(_response);
 		return {CheckResult::UNSATISFIABLE, maybeInvariants.value_or(Expression(true)), {}};
 	}
-	else if (boost::starts_with(response, "unsat"))
+	else if (boost::starts_with(_response, "unsat"))
 		result = CheckResult::SATISFIABLE;
-	else if (boost::starts_with(response, "unknown"))
+	else if (boost::starts_with(_response, "unknown"))
 		result = CheckResult::UNKNOWN;
 	else
 		result = CheckResult::ERROR;
@@ -178,7 +199,7 @@ void CHCSmtLib2Interface::write(std::string _data)
 	m_accumulatedOutput += std::move(_data) + "\n";
 }
 
-std::string CHCSmtLib2Interface::querySolver(std::string const& _input)
+std::string CHCSmtLib2Interface::querySolver(std::string const& _input, bool _concurrent)
 {
 	util::h256 inputHash = util::keccak256(_input);
 	if (m_queryResponses.count(inputHash))
@@ -186,24 +207,38 @@ std::string CHCSmtLib2Interface::querySolver(std::string const& _input)
 
 	if (m_smtCallback)
 	{
-		setupSmtCallback();
+		std::unique_lock lock(m_smtCallbackMutex, std::defer_lock);
+		if (!_concurrent)
+			setupSmtCallback();
+		else if (!smtCallbackIsThreadSafe())
+			lock.lock();
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
 			return result.responseOrErrorMessage;
 	}
 
+	std::lock_guard lock(m_unhandledQueriesMutex);
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
 }
 
 std::string CHCSmtLib2Interface::dumpQuery(Expression const& _expr)
+{
+	return composeQuery(createHeaderAndDeclarations(), m_accumulatedOutput.size(), createQueryAssertion(_expr.name));
+}
+
+std::string CHCSmtLib2Interface::composeQuery(
+	std::string const& _header,
+	size_t _rulesSize,
+	std::string const& _queryAssertion
+) const
 {
 	std::stringstream s;
 
 	s
-		<< createHeaderAndDeclarations()
-		<< m_accumulatedOutput << std::endl
-		<< createQueryAssertion(_expr.name) << std::endl
+		<< _header
+		<< std::string_view(m_accumulatedOutput).substr(0, _rulesSize) << std::endl
+		<< _queryAssertion << std::endl
 		<< "(check-sat)" << std::endl;
 
 	return s.str();
@@ -26,6 +26,8 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <mutex>
+
 namespace solidity::smtutil
 {
 
@@ -48,6 +50,8 @@ public:
 	/// @returns solving result, an invariant, and counterexample graph, if possible.
 	std::tuple<CheckResult, Expression, CexGraph> query(Expression const& _expr) override;
 
+	std::function<std::tuple<CheckResult, Expression, CexGraph>()> deferredQuery(Expression const& _expr) override;
+
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
 
 	std::string dumpQuery(Expression const& _expr);
@@ -72,14 +76,27 @@ protected:
 	std::string createQueryAssertion(std::string name);
 	std::string createHeaderAndDeclarations();
 
+	/// Composes the query consisting of the header, the first @a _rulesSize characters of the
+	/// accumulated output and the assertion @a _queryAssertion.
+	std::string composeQuery(std::string const& _header, size_t _rulesSize, std::string const& _queryAssertion) const;
+
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
-	std::string querySolver(std::string const& _input);
+	/// Unless @a _concurrent, sets up the callback first. Otherwise it has to be set up already
+	/// and the function can be called concurrently with itself. The calls of the callback are
+	/// then serialised, unless smtCallbackIsThreadSafe().
+	std::string querySolver(std::string const& _input, bool _concurrent = false);
+
+	/// Translates the response of the solver to the result of the query.
+	std::tuple<CheckResult, Expression, CexGraph> queryResult(std::string const& _response) const;
 
 	/// Translates CHC solver response with a model to our representation of invariants. Returns None on error.
 	std::optional<smtutil::Expression> invariantsFromSolverResponse(std::string const& response) const;
 
 	/// Hook to setup external solver call
 	virtual void setupSmtCallback() {}
+	/// @returns true if the callback can be called from several threads at once.
+	/// The callbacks given by users of the compiler in general cannot.
+	virtual bool smtCallbackIsThreadSafe() const { return false; }
 
 	/// Used to access toSmtLibSort, SExpr, and handle variables.
 	std::unique_ptr<SMTLib2Interface> m_smtlib2;
@@ -89,8 +106,11 @@ protected:
 
 	std::map<util::h256, std::string> m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
+	std::mutex m_unhandledQueriesMutex;
 
 	frontend::ReadCallback::Callback m_smtCallback;
+	/// Serialises the concurrent calls of a callback that is not thread-safe.
+	std::mutex m_smtCallbackMutex;
 };
 
 }
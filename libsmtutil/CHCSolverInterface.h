@@ -24,6 +24,7 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -59,6 +60,14 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// Takes a function application _expr and returns a function that checks it for reachability
+	/// in the system of rules added so far, like query.
+	/// Unlike query, the returned function can be invoked on another thread and concurrently with
+	/// the functions returned for other queries, as long as the interface is not modified meanwhile.
+	virtual std::function<std::tuple<CheckResult, Expression, CexGraph>()> deferredQuery(
+		Expression const& _expr
+	) = 0;
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
 };
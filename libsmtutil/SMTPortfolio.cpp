@@ -20,6 +20,11 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsolutil/Common.h>
+#include <libsolutil/Parallel.h>
+
+#include <mutex>
+
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
@@ -27,9 +32,10 @@ using namespace solidity::smtutil;
 
 SMTPortfolio::SMTPortfolio(
 	std::vector<std::unique_ptr<SolverInterface>> _solvers,
-	std::optional<unsigned> _queryTimeout
+	std::optional<unsigned> _queryTimeout,
+	Mode _mode
 ):
-	SolverInterface(_queryTimeout), m_solvers(std::move(_solvers))
+	SolverInterface(_queryTimeout), m_solvers(std::move(_solvers)), m_mode(_mode)
 {}
 
 
@@ -64,6 +70,25 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
 		s->addAssertion(_expr);
 }
 
+std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector<Expression> const& _expressionsToEvaluate)
+{
+	if (m_mode == Mode::Race && m_solvers.size() > 1)
+		return race(_expressionsToEvaluate);
+	return waitForAll(_expressionsToEvaluate);
+}
+
+void SMTPortfolio::interrupt()
+{
+	for (auto const& s: m_solvers)
+		s->interrupt();
+}
+
+void SMTPortfolio::clearInterrupt()
+{
+	for (auto const& s: m_solvers)
+		s->clearInterrupt();
+}
+
 /*
  * Broadcasts the SMT query to all solvers and returns a single result.
  * This comment explains how this result is decided.
@@ -94,7 +119,7 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *
  *   If all solvers return ERROR, the result is ERROR.
 */
-std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector<Expression> const& _expressionsToEvaluate)
+std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::waitForAll(std::vector<Expression> const& _expressionsToEvaluate)
 {
 	CheckResult lastResult = CheckResult::ERROR;
 	std::vector<std::string> finalValues;
@@ -122,6 +147,58 @@ std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector
 	return std::make_pair(lastResult, finalValues);
 }
 
+/*
+ * Sends the SMT query to all solvers at the same time, each of them on its own thread.
+ * The first solver that answers the query (SAT or UNSAT) decides the result
+ * and the solvers that are still running are interrupted.
+ * Answers of solvers that finish later are ignored, so conflicts are not detected.
+ * If no solver answers the query, the result is UNKNOWN or ERROR as in waitForAll.
+ *
+ * A solver may be interrupted just before its check starts or just after it finished.
+ * The solvers then give up on the check right away or ignore the interrupt, respectively,
+ * and the interrupts are withdrawn after the race so that they do not affect the next query.
+ */
+std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::race(std::vector<Expression> const& _expressionsToEvaluate)
+{
+	std::mutex mutex;
+	std::vector<bool> running(m_solvers.size(), true);
+	std::optional<std::pair<CheckResult, std::vector<std::string>>> answer;
+	CheckResult lastResult = CheckResult::ERROR;
+	ScopeGuard clearInterrupts([&]() { clearInterrupt(); });
+
+	util::parallelFor(m_solvers.size(), m_solvers.size(), [&](size_t _index) {
+		std::pair<CheckResult, std::vector<std::string>> result;
+		try
+		{
+			result = m_solvers[_index]->check(_expressionsToEvaluate);
+		}
+		catch (...)
+		{
+			std::lock_guard lock(mutex);
+			running[_index] = false;
+			throw;
+		}
+
+		std::lock_guard lock(mutex);
+		running[_index] = false;
+		if (answer)
+			return;
+		if (solverAnswered(result.first))
+		{
+			answer = std::move(result);
+			for (size_t other = 0; other < m_solvers.size(); ++other)
+				if (running[other])
+					m_solvers[other]->interrupt();
+		}
+		else if (result.first == CheckResult::UNKNOWN)
+			lastResult = result.first;
+	});
+
+	if (answer)
+		return std::move(*answer);
+	return std::make_pair(lastResult, std::vector<std::string>{});
+}
+
 std::vector<std::string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
@@ -32,8 +32,8 @@ namespace solidity::smtutil
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
- * It also checks whether different solvers give conflicting answers
- * to SMT queries.
+ * Depending on the mode, it either checks whether different solvers give
+ * conflicting answers to SMT queries or races the solvers against each other.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -42,7 +42,19 @@ public:
 	SMTPortfolio(SMTPortfolio const&) = delete;
 	SMTPortfolio& operator=(SMTPortfolio const&) = delete;
 
-	SMTPortfolio(std::vector<std::unique_ptr<SolverInterface>> solvers, std::optional<unsigned> _queryTimeout);
+	enum class Mode
+	{
+		/// Queries the solvers one after the other and reports conflicting answers.
+		WaitForAll,
+		/// Queries the solvers concurrently, uses the first answer and interrupts the other solvers.
+		Race
+	};
+
+	SMTPortfolio(
+		std::vector<std::unique_ptr<SolverInterface>> solvers,
+		std::optional<unsigned> _queryTimeout,
+		Mode _mode = Mode::WaitForAll
+	);
 
 	void reset() override;
 
@@ -54,6 +66,8 @@ public:
 	void addAssertion(Expression const& _expr) override;
 
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
+	void clearInterrupt() override;
 
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
@@ -63,7 +77,11 @@ public:
 private:
 	static bool solverAnswered(CheckResult result);
 
+	std::pair<CheckResult, std::vector<std::string>> waitForAll(std::vector<Expression> const& _expressionsToEvaluate);
+	std::pair<CheckResult, std::vector<std::string>> race(std::vector<Expression> const& _expressionsToEvaluate);
+
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	Mode m_mode = Mode::WaitForAll;
 
 	std::vector<Expression> m_assertions;
 };
@@ -536,6 +536,13 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a check running on another thread to give up as soon as possible,
+	/// which then returns UNKNOWN or ERROR. If no check is running, the next check gives up
+	/// right away instead. The request stays in effect until clearInterrupt() is called.
+	virtual void interrupt() {}
+	/// Withdraws the requests of interrupt(). Must not be called while a check is running.
+	virtual void clearInterrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
@@ -20,17 +20,19 @@
 
 #include <libsolutil/CommonIO.h>
 
+#include <mutex>
 #include <set>
 #include <stack>
 
 using namespace solidity;
 using namespace solidity::smtutil;
 
-Z3CHCInterface::Z3CHCInterface(std::optional<unsigned> _queryTimeout):
+Z3CHCInterface::Z3CHCInterface(std::optional<unsigned> _queryTimeout, bool _recordHistory):
 	CHCSolverInterface(_queryTimeout),
 	m_z3Interface(std::make_unique<Z3Interface>(m_queryTimeout)),
 	m_context(m_z3Interface->context()),
-	m_solver(*m_context)
+	m_solver(*m_context),
+	m_recordHistory(_recordHistory)
 {
 	Z3_get_version(
 		&std::get<0>(m_version),
@@ -59,12 +61,16 @@ void Z3CHCInterface::declareVariable(std::string const& _name, SortPointer const
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
 	smtAssert(_expr.sort->kind == Kind::Function);
+	if (m_recordHistory)
+		m_history.push_back({_expr, std::nullopt, m_z3Interface->declarations().size()});
 	m_z3Interface->declareVariable(_expr.name, _expr.sort);
 	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, std::string const& _name)
 {
+	if (m_recordHistory)
+		m_history.push_back({_expr, _name, m_z3Interface->declarations().size()});
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
 	if (m_z3Interface->constants().empty())
 		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
@@ -79,6 +85,63 @@ void Z3CHCInterface::addRule(Expression const& _expr, std::string const& _name)
 }
 
 std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression const& _expr)
+{
+	auto [result, invariant, cex] = solve(_expr);
+	if (result == CheckResult::SATISFIABLE)
+	{
+		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
+		// We now disable those optimizations and check whether we can still solve the problem.
+		setSpacerOptions(false);
+		auto [resultNoOpt, invariantNoOpt, cexNoOpt] = solve(_expr);
+		if (resultNoOpt == CheckResult::SATISFIABLE)
+			cex = std::move(cexNoOpt);
+		setSpacerOptions(true);
+	}
+	return {result, std::move(invariant), std::move(cex)};
+}
+
+std::function<std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph>()> Z3CHCInterface::deferredQuery(Expression const& _expr)
+{
+	smtAssert(m_recordHistory, "Deferred queries require the history of the system of rules.");
+	return [this, _expr, historySize = m_history.size(), declarations = m_z3Interface->declarations().size()]() {
+		// The constructor sets global parameters.
+		static std::mutex constructionMutex;
+		std::unique_ptr<Z3CHCInterface> solver;
+		{
+			std::lock_guard lock(constructionMutex);
+			solver = std::make_unique<Z3CHCInterface>(m_queryTimeout);
+		}
+		replay(*solver, historySize, declarations);
+		return solver->query(_expr);
+	};
+}
+
+void Z3CHCInterface::replay(Z3CHCInterface& _solver, size_t _historySize, size_t _declarations) const
+{
+	auto const& declarations = m_z3Interface->declarations();
+	size_t declared = 0;
+	auto declareUpTo = [&](size_t _count) {
+		for (; declared < _count; ++declared)
+			_solver.declareVariable(declarations[declared].first, declarations[declared].second);
+	};
+
+	for (size_t i = 0; i < _historySize; ++i)
+	{
+		HistoryEntry const& entry = m_history[i];
+		declareUpTo(entry.declarations);
+		if (entry.ruleName)
+			_solver.addRule(entry.expression, *entry.ruleName);
+		else
+		{
+			_solver.registerRelation(entry.expression);
+			// Registering the relation declared it.
+			++declared;
+		}
+	}
+	declareUpTo(_declarations);
+}
+
+std::tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::solve(Expression const& _expr)
 {
 	CheckResult result;
 	try
@@ -25,6 +25,7 @@
 #include <libsmtutil/CHCSolverInterface.h>
 #include <libsmtutil/Z3Interface.h>
 
+#include <optional>
 #include <tuple>
 #include <vector>
 
@@ -34,7 +35,9 @@ namespace solidity::smtutil
 class Z3CHCInterface: public CHCSolverInterface
 {
 public:
-	Z3CHCInterface(std::optional<unsigned> _queryTimeout = {});
+	/// Deferred queries can only be created if @a _recordHistory, which keeps a copy of all
+	/// relations and rules, so that they can be replayed in another Z3 context.
+	Z3CHCInterface(std::optional<unsigned> _queryTimeout = {}, bool _recordHistory = false);
 
 	/// Forwards variable declaration to Z3Interface.
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
@@ -43,13 +46,33 @@ public:
 
 	void addRule(Expression const& _expr, std::string const& _name) override;
 
+	/// If the query is satisfiable, the counterexample is taken from a second query
+	/// with Spacer's pre processing disabled, if that is still satisfiable.
 	std::tuple<CheckResult, Expression, CexGraph> query(Expression const& _expr) override;
 
+	/// Solves the query in a new Z3 context, into which the relations and rules are copied first.
+	std::function<std::tuple<CheckResult, Expression, CexGraph>()> deferredQuery(Expression const& _expr) override;
+
 	Z3Interface* z3Interface() const { return m_z3Interface.get(); }
 
 	void setSpacerOptions(bool _preProcessing = true);
 
 private:
+	/// Relation registered (without rule name) or rule added to the solver,
+	/// together with the number of variables declared before.
+	struct HistoryEntry
+	{
+		Expression expression;
+		std::optional<std::string> ruleName;
+		size_t declarations;
+	};
+
+	std::tuple<CheckResult, Expression, CexGraph> solve(Expression const& _expr);
+
+	/// Declares the variables and adds the relations and rules that this interface
+	/// contained at the given sizes of the history and of the declarations to @a _solver.
+	void replay(Z3CHCInterface& _solver, size_t _historySize, size_t _declarations) const;
+
 	/// Constructs a nonlinear counterexample graph from the refutation.
 	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof);
 	/// @returns the fact from a proof node.
@@ -67,6 +90,9 @@ private:
 	z3::fixedpoint m_solver;
 
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
+
+	bool m_recordHistory = false;
+	std::vector<HistoryEntry> m_history;
 };
 
 }
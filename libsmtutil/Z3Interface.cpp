@@ -18,6 +18,7 @@
 
 #include <libsmtutil/Z3Interface.h>
 
+#include <libsolutil/Common.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
@@ -55,6 +56,7 @@ void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_declarations.clear();
 	m_solver.reset();
 }
 
@@ -71,6 +73,7 @@ void Z3Interface::pop()
 void Z3Interface::declareVariable(std::string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	m_declarations.emplace_back(_name, _sort);
 	if (_sort->kind == Kind::Function)
 		declareFunction(_name, *_sort);
 	else if (m_constants.count(_name))
@@ -96,6 +99,17 @@ void Z3Interface::addAssertion(Expression const& _expr)
 
 std::pair<CheckResult, std::vector<std::string>> Z3Interface::check(std::vector<Expression> const& _expressionsToEvaluate)
 {
+	{
+		std::lock_guard lock(m_interruptMutex);
+		if (m_interrupted)
+			return std::make_pair(CheckResult::UNKNOWN, std::vector<std::string>{});
+		m_checking = true;
+	}
+	ScopeGuard stopChecking([&]() {
+		std::lock_guard lock(m_interruptMutex);
+		m_checking = false;
+	});
+
 	CheckResult result;
 	std::vector<std::string> values;
 	try
@@ -139,6 +153,21 @@ std::pair<CheckResult, std::vector<std::string>> Z3Interface::check(std::vector<
 	return std::make_pair(result, values);
 }
 
+void Z3Interface::interrupt()
+{
+	std::lock_guard lock(m_interruptMutex);
+	m_interrupted = true;
+	// The interrupted check returns unknown or throws "canceled".
+	if (m_checking)
+		m_context.interrupt();
+}
+
+void Z3Interface::clearInterrupt()
+{
+	std::lock_guard lock(m_interruptMutex);
+	m_interrupted = false;
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
@@ -21,6 +21,8 @@
 #include <libsmtutil/SolverInterface.h>
 #include <z3++.h>
 
+#include <mutex>
+
 namespace solidity::smtutil
 {
 
@@ -44,12 +46,16 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
+	void clearInterrupt() override;
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
 
 	std::map<std::string, z3::expr> constants() const { return m_constants; }
 	std::map<std::string, z3::func_decl> functions() const { return m_functions; }
+	/// @returns all variables and functions in the order in which they were declared since the last reset.
+	std::vector<std::pair<std::string, SortPointer>> const& declarations() const { return m_declarations; }
 
 	z3::context* context() { return &m_context; }
 
@@ -68,8 +74,17 @@ private:
 	z3::context m_context;
 	z3::solver m_solver;
 
+	/// Protects m_checking and m_interrupted, which interrupt() reads and writes from another thread.
+	std::mutex m_interruptMutex;
+	/// True while the solver is checking. The context is only interrupted then, since an interrupt
+	/// of the context outside of a check could also cancel the next one.
+	bool m_checking = false;
+	/// True if interrupt() was called since the last clearInterrupt().
+	bool m_interrupted = false;
+
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
 };
 
 }
@@ -130,6 +130,13 @@ void GlobalContext::setCurrentContract(ContractDefinition const& _contract)
 	m_currentContract = &_contract;
 }
 
+void GlobalContext::forgetContract(ContractDefinition const& _contract)
+{
+	solAssert(m_currentContract != &_contract);
+	m_thisPointer.erase(&_contract);
+	m_superPointer.erase(&_contract);
+}
+
 std::vector<Declaration const*> GlobalContext::declarations() const
 {
 	std::vector<Declaration const*> declarations;
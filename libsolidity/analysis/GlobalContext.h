@@ -53,6 +53,9 @@ public:
 	void resetCurrentContract() { m_currentContract = nullptr; }
 	MagicVariableDeclaration const* currentThis() const;
 	MagicVariableDeclaration const* currentSuper() const;
+	/// Removes the "this" and "super" declarations created for @a _contract. Has to be called
+	/// before the contract is destroyed if the global context is used any further.
+	void forgetContract(ContractDefinition const& _contract);
 
 	/// @returns a vector of all implicit global declarations excluding "this".
 	std::vector<Declaration const*> declarations() const;
@@ -26,6 +26,7 @@
 #include <libsolidity/analysis/TypeChecker.h>
 #include <libsolidity/ast/AST.h>
 #include <liblangutil/ErrorReporter.h>
+#include <libsolutil/CommonData.h>
 #include <libsolutil/StringUtils.h>
 #include <boost/algorithm/string.hpp>
 #include <unordered_set>
@@ -625,7 +626,8 @@ void DeclarationRegistrationHelper::endVisit(VariableDeclarationStatement& _vari
 	// This does not fit here perfectly, but it saves us another AST visit.
 	solAssert(m_currentFunction, "Variable declaration without function.");
 	for (ASTPointer<VariableDeclaration> const& var: _variableDeclarationStatement.declarations())
-		if (var)
+		// Source units whose analysis is reused by CompilerStack are registered again.
+		if (var && !util::contains(m_currentFunction->localVariables(), var.get()))
 			m_currentFunction->addLocalVariable(*var);
 	ASTVisitor::endVisit(_variableDeclarationStatement);
 }
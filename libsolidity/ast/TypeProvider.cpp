@@ -21,10 +21,111 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
 
+#include <type_traits>
+
 using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
+namespace
+{
+
+/// Builder for the keys under which types are interned, made of the data a type is created from.
+/// Types that are part of this data are represented by their address, since they are interned as well.
+class TypeKey
+{
+public:
+	explicit TypeKey(char const* _kind) { add(std::string(_kind)); }
+
+	template <typename T>
+	TypeKey& add(T const& _value)
+	{
+		static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>);
+		m_key.append(reinterpret_cast<char const*>(&_value), sizeof(_value));
+		return *this;
+	}
+	TypeKey& add(std::string const& _value)
+	{
+		add(_value.size());
+		m_key += _value;
+		return *this;
+	}
+	TypeKey& add(u256 const& _value) { return add(_value.str()); }
+	TypeKey& add(rational const& _value) { return add(_value.numerator().str()).add(_value.denominator().str()); }
+	template <typename T>
+	TypeKey& add(std::vector<T> const& _values)
+	{
+		add(_values.size());
+		for (T const& value: _values)
+			add(value);
+		return *this;
+	}
+	TypeKey& add(FunctionType::Options const& _options)
+	{
+		return add(_options.arbitraryParameters)
+			.add(_options.gasSet)
+			.add(_options.valueSet)
+			.add(_options.saltSet)
+			.add(_options.hasBoundFirstArgument);
+	}
+
+	std::string const& str() const { return m_key; }
+
+private:
+	std::string m_key;
+};
+
+std::string arrayKey(
+	DataLocation _location,
+	bool _isPointer,
+	bool _isByteArray,
+	bool _isString,
+	Type const* _baseType,
+	bool _isDynamicallySized,
+	u256 const& _length
+)
+{
+	return TypeKey("array")
+		.add(_location)
+		.add(_isPointer)
+		.add(_isByteArray)
+		.add(_isString)
+		.add(_baseType)
+		.add(_isDynamicallySized)
+		.add(_length)
+		.str();
+}
+
+std::string structKey(StructDefinition const& _struct, DataLocation _location, bool _isPointer)
+{
+	return TypeKey("struct").add(&_struct).add(_location).add(_isPointer).str();
+}
+
+std::string functionKey(
+	TypePointers const& _parameterTypes,
+	TypePointers const& _returnParameterTypes,
+	strings const& _parameterNames,
+	strings const& _returnParameterNames,
+	FunctionType::Kind _kind,
+	StateMutability _stateMutability,
+	Declaration const* _declaration,
+	FunctionType::Options const& _options
+)
+{
+	return TypeKey("function")
+		.add(_parameterTypes)
+		.add(_returnParameterTypes)
+		.add(_parameterNames)
+		.add(_returnParameterNames)
+		.add(_kind)
+		.add(_stateMutability)
+		.add(_declaration)
+		.add(_options)
+		.str();
+}
+
+}
+
 BoolType const TypeProvider::m_boolean{};
 InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
 
@@ -175,6 +276,17 @@ inline void clearCaches(Container& container)
 }
 
 void TypeProvider::reset()
+{
+	resetCaches();
+
+	instance().m_generalTypes.clear();
+	instance().m_internedTypes.clear();
+	instance().m_stringLiteralTypes.clear();
+	instance().m_ufixedMxN.clear();
+	instance().m_fixedMxN.clear();
+}
+
+void TypeProvider::resetCaches()
 {
 	clearCache(m_boolean);
 	clearCache(m_inaccessibleDynamic);
@@ -190,11 +302,15 @@ void TypeProvider::reset()
 	clearCaches(instance().m_uintM);
 	clearCaches(instance().m_bytesM);
 	clearCaches(instance().m_magics);
-
-	instance().m_generalTypes.clear();
-	instance().m_stringLiteralTypes.clear();
-	instance().m_ufixedMxN.clear();
-	instance().m_fixedMxN.clear();
+	clearCaches(instance().m_generalTypes);
+	for (auto const& [literal, type]: instance().m_stringLiteralTypes)
+		clearCache(type);
+	for (auto const& [size, type]: instance().m_ufixedMxN)
+		clearCache(type);
+	for (auto const& [size, type]: instance().m_fixedMxN)
+		clearCache(type);
+	// The keys might refer to destroyed AST nodes, whose addresses can be reused.
+	instance().m_internedTypes.clear();
 }
 
 template <typename T, typename... Args>
@@ -204,6 +320,43 @@ inline T const* TypeProvider::createAndGet(Args&& ... _args)
 	return static_cast<T const*>(instance().m_generalTypes.back().get());
 }
 
+template <typename T, typename... Args>
+inline T const* TypeProvider::createInterned(std::string _key, Args&& ... _args)
+{
+	auto& internedTypes = instance().m_internedTypes;
+	if (auto it = internedTypes.find(_key); it != internedTypes.end())
+		return static_cast<T const*>(it->second);
+
+	T const* type = createAndGet<T>(std::forward<Args>(_args)...);
+	internedTypes.emplace(std::move(_key), type);
+	return type;
+}
+
+FunctionType const* TypeProvider::intern(std::unique_ptr<FunctionType> _function)
+{
+	// Only types that are not attached to a first argument are created from the AST,
+	// so parameterNames() returns all names.
+	solAssert(!_function->hasBoundFirstArgument());
+	std::string key = functionKey(
+		_function->parameterTypesIncludingSelf(),
+		_function->returnParameterTypes(),
+		_function->parameterNames(),
+		_function->returnParameterNames(),
+		_function->kind(),
+		_function->stateMutability(),
+		_function->hasDeclaration() ? &_function->declaration() : nullptr,
+		FunctionType::Options::fromFunctionType(*_function)
+	);
+	auto& internedTypes = instance().m_internedTypes;
+	if (auto it = internedTypes.find(key); it != internedTypes.end())
+		return static_cast<FunctionType const*>(it->second);
+
+	instance().m_generalTypes.emplace_back(std::move(_function));
+	auto const* type = static_cast<FunctionType const*>(instance().m_generalTypes.back().get());
+	internedTypes.emplace(std::move(key), type);
+	return type;
+}
+
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability)
 {
 	solAssert(
@@ -404,7 +557,8 @@ TupleType const* TypeProvider::tuple(std::vector<Type const*> members)
 	if (members.empty())
 		return &m_emptyTuple;
 
-	return createAndGet<TupleType>(std::move(members));
+	std::string key = TypeKey("tuple").add(members).str();
+	return createInterned<TupleType>(std::move(key), std::move(members));
 }
 
 ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer)
@@ -412,33 +566,61 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
+	// Only references to storage can be non-pointers.
+	bool const isPointer = _location != DataLocation::Storage || _isPointer;
+	std::string key;
+	if (auto const* arrayType = dynamic_cast<ArrayType const*>(_type))
+	{
+		if (arrayType->isByteArrayOrString() && isPointer)
+			return array(_location, arrayType->isString());
+		key = arrayKey(
+			_location,
+			isPointer,
+			arrayType->isByteArray(),
+			arrayType->isString(),
+			withLocationIfReference(_location, arrayType->baseType()),
+			arrayType->isDynamicallySized(),
+			arrayType->isDynamicallySized() ? u256(0) : arrayType->length()
+		);
+	}
+	else if (auto const* structType = dynamic_cast<StructType const*>(_type))
+		key = structKey(structType->structDefinition(), _location, isPointer);
+	else
+		key = TypeKey("withLocation").add(_type).add(_location).add(isPointer).str();
+
+	auto& internedTypes = instance().m_internedTypes;
+	if (auto it = internedTypes.find(key); it != internedTypes.end())
+		return static_cast<ReferenceType const*>(it->second);
+
 	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	auto const* type = static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	internedTypes.emplace(std::move(key), type);
+	return type;
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, FunctionType::Kind _kind)
 {
-	return createAndGet<FunctionType>(_function, _kind);
+	return intern(std::make_unique<FunctionType>(_function, _kind));
 }
 
 FunctionType const* TypeProvider::function(VariableDeclaration const& _varDecl)
 {
-	return createAndGet<FunctionType>(_varDecl);
+	return intern(std::make_unique<FunctionType>(_varDecl));
 }
 
 FunctionType const* TypeProvider::function(EventDefinition const& _def)
 {
-	return createAndGet<FunctionType>(_def);
+	return intern(std::make_unique<FunctionType>(_def));
 }
 
 FunctionType const* TypeProvider::function(ErrorDefinition const& _def)
 {
-	return createAndGet<FunctionType>(_def);
+	return intern(std::make_unique<FunctionType>(_def));
 }
 
 FunctionType const* TypeProvider::function(FunctionTypeName const& _typeName)
 {
-	return createAndGet<FunctionType>(_typeName);
+	return intern(std::make_unique<FunctionType>(_typeName));
 }
 
 FunctionType const* TypeProvider::function(
@@ -451,7 +633,15 @@ FunctionType const* TypeProvider::function(
 {
 	// Can only use this constructor for "arbitraryParameters".
 	solAssert(!_options.valueSet && !_options.gasSet && !_options.saltSet && !_options.hasBoundFirstArgument);
-	return createAndGet<FunctionType>(
+	std::string key = TypeKey("plainFunction")
+		.add(_parameterTypes)
+		.add(_returnParameterTypes)
+		.add(_kind)
+		.add(_stateMutability)
+		.add(_options)
+		.str();
+	return createInterned<FunctionType>(
+		std::move(key),
 		_parameterTypes,
 		_returnParameterTypes,
 		_kind,
@@ -471,7 +661,18 @@ FunctionType const* TypeProvider::function(
 	FunctionType::Options _options
 )
 {
-	return createAndGet<FunctionType>(
+	std::string key = functionKey(
+		_parameterTypes,
+		_returnParameterTypes,
+		_parameterNames,
+		_returnParameterNames,
+		_kind,
+		_stateMutability,
+		_declaration,
+		_options
+	);
+	return createInterned<FunctionType>(
+		std::move(key),
 		_parameterTypes,
 		_returnParameterTypes,
 		_parameterNames,
@@ -485,7 +686,8 @@ FunctionType const* TypeProvider::function(
 
 RationalNumberType const* TypeProvider::rationalNumber(rational const& _value, Type const* _compatibleBytesType)
 {
-	return createAndGet<RationalNumberType>(_value, _compatibleBytesType);
+	std::string key = TypeKey("rational").add(_value).add(_compatibleBytesType).str();
+	return createInterned<RationalNumberType>(std::move(key), _value, _compatibleBytesType);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
@@ -504,52 +706,60 @@ ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
 		if (_location == DataLocation::Memory)
 			return bytesMemory();
 	}
-	return createAndGet<ArrayType>(_location, _isString);
+	std::string key = arrayKey(_location, true, !_isString, _isString, byte(), true, 0);
+	return createInterned<ArrayType>(std::move(key), _location, _isString);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType)
 {
-	return createAndGet<ArrayType>(_location, _baseType);
+	std::string key = arrayKey(_location, true, false, false, withLocationIfReference(_location, _baseType), true, 0);
+	return createInterned<ArrayType>(std::move(key), _location, _baseType);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType, u256 const& _length)
 {
-	return createAndGet<ArrayType>(_location, _baseType, _length);
+	std::string key = arrayKey(_location, true, false, false, withLocationIfReference(_location, _baseType), false, _length);
+	return createInterned<ArrayType>(std::move(key), _location, _baseType, _length);
 }
 
 ArraySliceType const* TypeProvider::arraySlice(ArrayType const& _arrayType)
 {
-	return createAndGet<ArraySliceType>(_arrayType);
+	return createInterned<ArraySliceType>(TypeKey("arraySlice").add(&_arrayType).str(), _arrayType);
 }
 
 ContractType const* TypeProvider::contract(ContractDefinition const& _contractDef, bool _isSuper)
 {
-	return createAndGet<ContractType>(_contractDef, _isSuper);
+	return createInterned<ContractType>(TypeKey("contract").add(&_contractDef).add(_isSuper).str(), _contractDef, _isSuper);
 }
 
 EnumType const* TypeProvider::enumType(EnumDefinition const& _enumDef)
 {
-	return createAndGet<EnumType>(_enumDef);
+	return createInterned<EnumType>(TypeKey("enum").add(&_enumDef).str(), _enumDef);
 }
 
 ModuleType const* TypeProvider::module(SourceUnit const& _source)
 {
-	return createAndGet<ModuleType>(_source);
+	return createInterned<ModuleType>(TypeKey("module").add(&_source).str(), _source);
 }
 
 TypeType const* TypeProvider::typeType(Type const* _actualType)
 {
-	return createAndGet<TypeType>(_actualType);
+	return createInterned<TypeType>(TypeKey("type").add(_actualType).str(), _actualType);
 }
 
 StructType const* TypeProvider::structType(StructDefinition const& _struct, DataLocation _location)
 {
-	return createAndGet<StructType>(_struct, _location);
+	return createInterned<StructType>(structKey(_struct, _location, true), _struct, _location);
 }
 
 ModifierType const* TypeProvider::modifier(ModifierDefinition const& _def)
 {
-	return createAndGet<ModifierType>(_def);
+	// The constructor reads the types of the parameters from the AST.
+	TypeKey key("modifier");
+	key.add(&_def).add(_def.parameters().size());
+	for (ASTPointer<VariableDeclaration> const& parameter: _def.parameters())
+		key.add(parameter->annotation().type);
+	return createInterned<ModifierType>(key.str(), _def);
 }
 
 MagicType const* TypeProvider::magic(MagicType::Kind _kind)
@@ -568,15 +778,16 @@ MagicType const* TypeProvider::meta(Type const* _type)
 		),
 		"Only enum, contracts or integer types supported for now."
 	);
-	return createAndGet<MagicType>(_type);
+	return createInterned<MagicType>(TypeKey("meta").add(_type).str(), _type);
 }
 
 MappingType const* TypeProvider::mapping(Type const* _keyType, ASTString _keyName, Type const* _valueType, ASTString _valueName)
 {
-	return createAndGet<MappingType>(_keyType, _keyName, _valueType, _valueName);
+	std::string key = TypeKey("mapping").add(_keyType).add(_keyName).add(_valueType).add(_valueName).str();
+	return createInterned<MappingType>(std::move(key), _keyType, _keyName, _valueType, _valueName);
 }
 
 UserDefinedValueType const* TypeProvider::userDefinedValueType(UserDefinedValueTypeDefinition const& _definition)
 {
-	return createAndGet<UserDefinedValueType>(_definition);
+	return createInterned<UserDefinedValueType>(TypeKey("userDefinedValueType").add(&_definition).str(), _definition);
 }
@@ -24,6 +24,8 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <string>
+#include <unordered_map>
 #include <utility>
 
 namespace solidity::frontend
@@ -37,6 +39,9 @@ namespace solidity::frontend
  *
  * It is not recommended to explicitly instantiate types unless you really know what and why
  * you are doing it.
+ *
+ * Types are only created once per set of constructor arguments, so types provided by this
+ * TypeProvider are usually equal if and only if they are identical.
  */
 class TypeProvider
 {
@@ -52,6 +57,14 @@ public:
 	/// This invalidates all dangling pointers to types provided by this TypeProvider.
 	static void reset();
 
+	/// Clears the lazily computed data (like member lists) of all types but keeps the types.
+	/// Needed if some AST nodes are destroyed while types referenced by other AST nodes have to be kept.
+	/// Types requested afterwards are created anew instead of being shared with the kept ones.
+	static void resetCaches();
+
+	/// @returns the number of types that were created for AST nodes and other non-elementary types.
+	static size_t generalTypeCount() { return instance().m_generalTypes.size(); }
+
 	/// @name Factory functions
 	/// Factory functions that convert an AST @ref TypeName to a Type.
 	static Type const* fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability = {});
@@ -210,6 +223,14 @@ private:
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
 
+	/// @returns the type created under @a _key, creating it from @a _args if there is none yet.
+	template <typename T, typename... Args>
+	static inline T const* createInterned(std::string _key, Args&& ... _args);
+
+	/// @returns the function type equal to @a _function, which is kept if there is none yet.
+	/// Used for function types whose constructor reads the types of their parameters from the AST.
+	static FunctionType const* intern(std::unique_ptr<FunctionType> _function);
+
 	static BoolType const m_boolean;
 	static InaccessibleDynamicType const m_inaccessibleDynamic;
 
@@ -232,6 +253,8 @@ private:
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+	/// The types in m_generalTypes, keyed by the data they were created from.
+	std::unordered_map<std::string, Type const*> m_internedTypes{};
 };
 
 }
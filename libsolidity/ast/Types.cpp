@@ -1697,6 +1697,8 @@ std::string ArrayType::richIdentifier() const
 
 bool ArrayType::operator==(Type const& _other) const
 {
+	if (this == &_other)
+		return true;
 	if (_other.category() != category())
 		return false;
 	ArrayType const& other = dynamic_cast<ArrayType const&>(_other);
@@ -2736,6 +2738,8 @@ std::string TupleType::richIdentifier() const
 
 bool TupleType::operator==(Type const& _other) const
 {
+	if (this == &_other)
+		return true;
 	if (auto tupleType = dynamic_cast<TupleType const*>(&_other))
 		return components() == tupleType->components();
 	else
@@ -3112,6 +3116,8 @@ std::string FunctionType::richIdentifier() const
 
 bool FunctionType::operator==(Type const& _other) const
 {
+	if (this == &_other)
+		return true;
 	if (_other.category() != category())
 		return false;
 	FunctionType const& other = dynamic_cast<FunctionType const&>(_other);
@@ -3823,6 +3829,8 @@ std::string MappingType::richIdentifier() const
 
 bool MappingType::operator==(Type const& _other) const
 {
+	if (this == &_other)
+		return true;
 	if (_other.category() != category())
 		return false;
 	MappingType const& other = dynamic_cast<MappingType const&>(_other);
@@ -3874,6 +3882,8 @@ std::string TypeType::richIdentifier() const
 
 bool TypeType::operator==(Type const& _other) const
 {
+	if (this == &_other)
+		return true;
 	if (_other.category() != category())
 		return false;
 	TypeType const& other = dynamic_cast<TypeType const&>(_other);
@@ -65,7 +65,11 @@ BMC::BMC(
 	if (_settings.solvers.z3 && Z3Interface::available())
 		solvers.emplace_back(std::make_unique<Z3Interface>(_settings.timeout));
 #endif
-	m_interface = std::make_unique<SMTPortfolio>(std::move(solvers), _settings.timeout);
+	m_interface = std::make_unique<SMTPortfolio>(
+		std::move(solvers),
+		_settings.timeout,
+		_settings.portfolio.isRace() ? SMTPortfolio::Mode::Race : SMTPortfolio::Mode::WaitForAll
+	);
 #if defined (HAVE_Z3)
 	if (m_settings.solvers.z3)
 		if (!_smtlib2Responses.empty())
@@ -941,6 +945,7 @@ void BMC::checkVerificationTargets()
 {
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target);
+	popTargetAssertions();
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -980,6 +985,7 @@ void BMC::checkConstantCondition(BMCVerificationTarget& _target)
 {
 	checkBooleanNotConstant(
 		*_target.expression,
+		_target.assertions,
 		_target.constraints,
 		_target.value,
 		_target.callStack
@@ -1095,14 +1101,18 @@ void BMC::addVerificationTarget(
 		{
 			_type,
 			_value,
-			currentPathConditions() && m_context.assertions()
+			currentPathConditions()
 		},
+		m_context.assertionList(),
 		_expression,
 		m_callStack,
 		modelExpressions()
 	};
 	if (_type == VerificationTargetType::ConstantCondition)
+	{
 		checkVerificationTarget(target);
+		popTargetAssertions();
+	}
 	else
 		m_verificationTargets.emplace_back(std::move(target));
 }
@@ -1121,6 +1131,7 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
+	addTargetAssertions(_target.assertions);
 	m_interface->push();
 	m_interface->addAssertion(_condition);
 
@@ -1210,6 +1221,7 @@ void BMC::checkCondition(
 
 void BMC::checkBooleanNotConstant(
 	Expression const& _condition,
+	std::vector<std::shared_ptr<smtutil::Expression const>> const& _assertions,
 	smtutil::Expression const& _constraints,
 	smtutil::Expression const& _value,
 	std::vector<SMTEncoder::CallStackEntry> const& _callStack
@@ -1219,6 +1231,8 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
+	addTargetAssertions(_assertions);
+
 	m_interface->push();
 	m_interface->addAssertion(_constraints && _value);
 	auto positiveResult = checkSatisfiable();
@@ -1311,6 +1325,42 @@ smtutil::CheckResult BMC::checkSatisfiable()
 	return checkSatisfiableAndGenerateModel({}).first;
 }
 
+void BMC::addTargetAssertions(std::vector<std::shared_ptr<smtutil::Expression const>> const& _assertions)
+{
+	size_t common = 0;
+	while (
+		common < std::min(m_solverAssertions.size(), _assertions.size()) &&
+		m_solverAssertions[common] == _assertions[common]
+	)
+		++common;
+
+	while (m_solverAssertions.size() > common)
+	{
+		solAssert(!m_solverContextSizes.empty());
+		m_interface->pop();
+		m_solverAssertions.resize(m_solverContextSizes.back());
+		m_solverContextSizes.pop_back();
+	}
+
+	if (m_solverAssertions.size() == _assertions.size())
+		return;
+
+	m_interface->push();
+	m_solverContextSizes.push_back(m_solverAssertions.size());
+	for (size_t i = m_solverAssertions.size(); i < _assertions.size(); ++i)
+	{
+		m_interface->addAssertion(*_assertions[i]);
+		m_solverAssertions.push_back(_assertions[i]);
+	}
+}
+
+void BMC::popTargetAssertions()
+{
+	for (; !m_solverContextSizes.empty(); m_solverContextSizes.pop_back())
+		m_interface->pop();
+	m_solverAssertions.clear();
+}
+
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
 {
 	auto oldVar = _symVar.currentValue();
@@ -142,8 +142,12 @@ private:
 
 	/// Verification targets.
 	//@{
+	/// The constraints of a BMC target only consist of the path condition. The assertions of the
+	/// encoding, most of which the target shares with the targets encountered before it, are kept
+	/// separately, so that they can be added to the solver incrementally.
 	struct BMCVerificationTarget: VerificationTarget
 	{
+		std::vector<std::shared_ptr<smtutil::Expression const>> assertions;
 		Expression const* expression;
 		std::vector<CallStackEntry> callStack;
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> modelExpressions;
@@ -192,6 +196,7 @@ private:
 	/// is a literal constant.
 	void checkBooleanNotConstant(
 		Expression const& _condition,
+		std::vector<std::shared_ptr<smtutil::Expression const>> const& _assertions,
 		smtutil::Expression const& _constraints,
 		smtutil::Expression const& _value,
 		std::vector<CallStackEntry> const& _callStack
@@ -200,6 +205,13 @@ private:
 	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
 
 	smtutil::CheckResult checkSatisfiable();
+
+	/// Adds @a _assertions to the solver in a new context, keeping the longest prefix of them
+	/// that is already part of the solver contexts from earlier targets.
+	void addTargetAssertions(std::vector<std::shared_ptr<smtutil::Expression const>> const& _assertions);
+	/// Removes all contexts added by addTargetAssertions from the solver.
+	/// Has to be called before the encoding continues, since the solver may scope declarations by context.
+	void popTargetAssertions();
 	//@}
 
 	smtutil::Expression mergeVariablesFromLoopCheckpoints();
@@ -213,6 +225,11 @@ private:
 
 	std::vector<BMCVerificationTarget> m_verificationTargets;
 
+	/// Assertions added to the solver by addTargetAssertions.
+	std::vector<std::shared_ptr<smtutil::Expression const>> m_solverAssertions;
+	/// Size of m_solverAssertions when each of the solver contexts added by addTargetAssertions was pushed.
+	std::vector<size_t> m_solverContextSizes;
+
 	/// Targets proved safe by this engine.
 	std::map<ASTNode const*, std::set<BMCVerificationTarget>, smt::EncodingContext::IdCompare> m_safeTargets;
 
@@ -36,6 +36,7 @@
 #include <libsmtutil/CHCSmtLib2Interface.h>
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/Parallel.h>
 #include <libsolutil/StringUtils.h>
 
 #ifdef HAVE_Z3_DLOPEN
@@ -1286,7 +1287,8 @@ void CHC::resetSourceAnalysis()
 	{
 #ifdef HAVE_Z3
 		// z3::fixedpoint does not have a reset mechanism, so we need to create another.
-		m_interface = std::make_unique<Z3CHCInterface>(m_settings.timeout);
+		// The worker threads replay the rules into their own solvers, which requires recording them.
+		m_interface = std::make_unique<Z3CHCInterface>(m_settings.timeout, effectiveConcurrency(m_settings.workers) > 1);
 		auto z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
 		solAssert(z3Interface, "");
 		m_context.setSolver(z3Interface->z3Interface());
@@ -1919,51 +1921,42 @@ void CHC::addRule(smtutil::Expression const& _rule, std::string const& _ruleName
 
 std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
 {
-	CheckResult result;
-	smtutil::Expression invariant(true);
-	CHCSolverInterface::CexGraph cex;
-	if (m_settings.printQuery)
-	{
-		auto smtLibInterface = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
-		solAssert(smtLibInterface, "Requested to print queries but CHCSmtLib2Interface not available");
-		std::string smtLibCode = smtLibInterface->dumpQuery(_query);
-		m_errorReporter.info(
-			2339_error,
-			"CHC: Requested query:\n" + smtLibCode
-		);
-	}
-	std::tie(result, invariant, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
-	{
-	// We still need the ifdef because of Z3CHCInterface.
-		if (m_settings.solvers.z3)
-		{
-#ifdef HAVE_Z3
-			// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
-			// We now disable those optimizations and check whether we can still solve the problem.
-			auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
-			solAssert(spacer, "");
-			spacer->setSpacerOptions(false);
+	printQuery(_query);
+	auto result = m_interface->query(_query);
+	reportQueryResult(std::get<CheckResult>(result), _location);
+	return result;
+}
 
-			CheckResult resultNoOpt;
-			smtutil::Expression invariantNoOpt(true);
-			CHCSolverInterface::CexGraph cexNoOpt;
-			std::tie(resultNoOpt, invariantNoOpt, cexNoOpt) = m_interface->query(_query);
+void CHC::printQuery(smtutil::Expression const& _query)
+{
+	if (std::optional<std::string> smtLibCode = queryToPrint(_query))
+		printQuery(*smtLibCode);
+}
 
-			if (resultNoOpt == CheckResult::SATISFIABLE)
-				cex = std::move(cexNoOpt);
+std::optional<std::string> CHC::queryToPrint(smtutil::Expression const& _query)
+{
+	if (!m_settings.printQuery)
+		return std::nullopt;
 
-			spacer->setSpacerOptions(true);
-#else
-			solAssert(false);
-#endif
-		}
-		break;
-	}
+	auto smtLibInterface = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
+	solAssert(smtLibInterface, "Requested to print queries but CHCSmtLib2Interface not available");
+	return smtLibInterface->dumpQuery(_query);
+}
+
+void CHC::printQuery(std::string const& _smtLibCode)
+{
+	m_errorReporter.info(
+		2339_error,
+		"CHC: Requested query:\n" + _smtLibCode
+	);
+}
+
+void CHC::reportQueryResult(CheckResult _result, langutil::SourceLocation const& _location)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
 	case CheckResult::UNSATISFIABLE:
-		break;
 	case CheckResult::UNKNOWN:
 		break;
 	case CheckResult::CONFLICTING:
@@ -1973,7 +1966,6 @@ std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
 		break;
 	}
-	return {result, invariant, cex};
 }
 
 void CHC::verificationTargetEncountered(
@@ -2076,14 +2068,19 @@ void CHC::checkVerificationTargets()
 	}
 
 	std::set<unsigned> checkedErrorIds;
-	for (auto const& [targetId, placeholders]: targetEntryPoints)
-	{
-		auto const& target = m_verificationTargets.at(targetId);
-		auto [errorType, errorReporterId] = targetDescription(target);
+	for (unsigned targetId: targetEntryPoints | ranges::views::keys)
+		checkedErrorIds.insert(m_verificationTargets.at(targetId).errorId);
 
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
-		checkedErrorIds.insert(target.errorId);
-	}
+	if (effectiveConcurrency(m_settings.workers) > 1 && targetEntryPoints.size() > 1)
+		checkTargetsConcurrently(targetEntryPoints);
+	else
+		for (auto const& [targetId, placeholders]: targetEntryPoints)
+		{
+			auto const& target = m_verificationTargets.at(targetId);
+			auto [errorType, errorReporterId] = targetDescription(target);
+
+			checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		}
 
 	auto toReport = m_unsafeTargets;
 	if (m_settings.showUnproved)
@@ -2196,6 +2193,62 @@ void CHC::checkVerificationTargets()
 		m_safeTargets[m_verificationTargets.at(id).errorNode].insert(m_verificationTargets.at(id));
 }
 
+void CHC::checkTargetsConcurrently(std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints)
+{
+	// All rules are added to the solver first, so that the queries of all targets can be solved by
+	// the workers concurrently. Each query only depends on the rules added before it, so the results
+	// are the same no matter how the queries are scheduled. They are reported in the order of the targets,
+	// which makes the output deterministic, but does not skip the queries of targets already shown to be
+	// unsafe via other entry points as the sequential analysis does.
+	struct TargetQuery
+	{
+		CHCVerificationTarget const& target;
+		std::string errorPredicate;
+		std::function<std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph>()> solve;
+		std::optional<std::tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph>> result;
+		/// The query as printed by the sequential analysis, which only contains the rules added before it.
+		std::optional<std::string> printedQuery;
+	};
+	std::vector<TargetQuery> queries;
+	for (auto const& [targetId, placeholders]: _targetEntryPoints)
+	{
+		createTargetErrorBlock(m_verificationTargets.at(targetId), placeholders);
+		queries.push_back({
+			m_verificationTargets.at(targetId),
+			error().name,
+			m_interface->deferredQuery(error()),
+			std::nullopt,
+			queryToPrint(error())
+		});
+	}
+
+	parallelFor(m_settings.workers, queries.size(), [&](size_t _index) {
+		queries[_index].result = queries[_index].solve();
+	});
+
+	for (TargetQuery& query: queries)
+	{
+		if (m_unsafeTargets.count(query.target.errorNode) && m_unsafeTargets.at(query.target.errorNode).count(query.target.type))
+			continue;
+
+		if (query.printedQuery)
+			printQuery(*query.printedQuery);
+		auto const& [result, invariant, model] = *query.result;
+		reportQueryResult(result, query.target.errorNode->location());
+		auto [errorType, errorReporterId] = targetDescription(query.target);
+		reportTarget(
+			query.target,
+			result,
+			invariant,
+			model,
+			query.errorPredicate,
+			errorReporterId,
+			errorType + " happens here.",
+			errorType + " might happen here."
+		);
+	}
+}
+
 void CHC::checkAndReportTarget(
 	CHCVerificationTarget const& _target,
 	std::vector<CHCQueryPlaceholder> const& _placeholders,
@@ -2207,6 +2260,13 @@ void CHC::checkAndReportTarget(
 	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
 		return;
 
+	createTargetErrorBlock(_target, _placeholders);
+	auto [result, invariant, model] = query(error(), _target.errorNode->location());
+	reportTarget(_target, result, invariant, model, error().name, _errorReporterId, std::move(_satMsg), std::move(_unknownMsg));
+}
+
+void CHC::createTargetErrorBlock(CHCVerificationTarget const& _target, std::vector<CHCQueryPlaceholder> const& _placeholders)
+{
 	createErrorBlock();
 	for (auto const& placeholder: _placeholders)
 		connectBlocks(
@@ -2214,9 +2274,21 @@ void CHC::checkAndReportTarget(
 			error(),
 			placeholder.constraints && placeholder.errorExpression == _target.errorId
 		);
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	CheckResult _result,
+	smtutil::Expression const& _invariant,
+	CHCSolverInterface::CexGraph const& _model,
+	std::string const& _errorPredicate,
+	ErrorId _errorReporterId,
+	std::string _satMsg,
+	std::string _unknownMsg
+)
+{
 	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
-	if (result == CheckResult::UNSATISFIABLE)
+	if (_result == CheckResult::UNSATISFIABLE)
 	{
 		m_safeTargets[_target.errorNode].insert(_target);
 		std::set<Predicate const*> predicates;
@@ -2224,14 +2296,14 @@ void CHC::checkAndReportTarget(
 			predicates.insert(pred);
 		for (auto const* pred: m_nondetInterfaces | ranges::views::values)
 			predicates.insert(pred);
-		std::map<Predicate const*, std::set<std::string>> invariants = collectInvariants(invariant, predicates, m_settings.invariants);
+		std::map<Predicate const*, std::set<std::string>> invariants = collectInvariants(_invariant, predicates, m_settings.invariants);
 		for (auto pred: invariants | ranges::views::keys)
 			m_invariants[pred] += std::move(invariants.at(pred));
 	}
-	else if (result == CheckResult::SATISFIABLE)
+	else if (_result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
+		auto cex = generateCounterexample(_model, _errorPredicate);
 		if (cex)
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
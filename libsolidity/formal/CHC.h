@@ -297,6 +297,14 @@ private:
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
 	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Reports @a _query as info if requested by the settings.
+	void printQuery(smtutil::Expression const& _query);
+	/// @returns the SMT-LIB2 code of @a _query if the settings request printing it, nullopt otherwise.
+	std::optional<std::string> queryToPrint(smtutil::Expression const& _query);
+	/// Reports the SMT-LIB2 code of a query as info.
+	void printQuery(std::string const& _smtLibCode);
+	/// Warns about solver errors and conflicting answers.
+	void reportQueryResult(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -310,6 +318,21 @@ private:
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Checks the targets by solving their queries on up to m_settings.workers threads.
+	void checkTargetsConcurrently(std::map<unsigned, std::vector<CHCQueryPlaceholder>> const& _targetEntryPoints);
+	/// Creates a fresh error block and connects the entry points of @a _target to it.
+	void createTargetErrorBlock(CHCVerificationTarget const& _target, std::vector<CHCQueryPlaceholder> const& _placeholders);
+	/// Records @a _target as safe, unsafe or unproved depending on the result of its query.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		smtutil::CheckResult _result,
+		smtutil::Expression const& _invariant,
+		smtutil::CHCSolverInterface::CexGraph const& _model,
+		std::string const& _errorPredicate,
+		langutil::ErrorId _errorReporterId,
+		std::string _satMsg,
+		std::string _unknownMsg
+	);
 
 	std::pair<std::string, langutil::ErrorId> targetDescription(CHCVerificationTarget const& _target);
 
@@ -33,3 +33,15 @@ void Cvc5SMTLib2Interface::setupSmtCallback() {
 	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
 		universalCallback->smtCommand().setCvc5(m_queryTimeout);
 }
+
+void Cvc5SMTLib2Interface::interrupt()
+{
+	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
+		universalCallback->smtCommand().interrupt();
+}
+
+void Cvc5SMTLib2Interface::clearInterrupt()
+{
+	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
+		universalCallback->smtCommand().clearInterrupt();
+}
@@ -30,6 +30,10 @@ public:
 		frontend::ReadCallback::Callback _smtCallback = {},
 		std::optional<unsigned> _queryTimeout = {}
 	);
+
+	void interrupt() override;
+	void clearInterrupt() override;
+
 private:
 	void setupSmtCallback() override;
 };
@@ -35,3 +35,8 @@ void EldaricaCHCSmtLib2Interface::setupSmtCallback()
 	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
 		universalCallback->smtCommand().setEldarica(m_queryTimeout, m_computeInvariants);
 }
+
+bool EldaricaCHCSmtLib2Interface::smtCallbackIsThreadSafe() const
+{
+	return m_smtCallback.target<frontend::UniversalCallback>() != nullptr;
+}
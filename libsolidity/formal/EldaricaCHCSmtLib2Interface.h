@@ -34,6 +34,8 @@ public:
 
 private:
 	void setupSmtCallback() override;
+	/// The solver command of solc solves queries concurrently, other callbacks are serialised.
+	bool smtCallbackIsThreadSafe() const override;
 
 	bool m_computeInvariants;
 };
@@ -36,6 +36,8 @@ void EncodingContext::reset()
 	m_globalContext.clear();
 	m_state.reset();
 	m_assertions.clear();
+	m_assertionList.clear();
+	m_assertionListSizes.clear();
 }
 
 void EncodingContext::resetUniqueId()
@@ -191,24 +193,39 @@ smtutil::Expression EncodingContext::assertions()
 	return m_assertions.back();
 }
 
+std::vector<std::shared_ptr<smtutil::Expression const>> EncodingContext::assertionList() const
+{
+	if (m_accumulateAssertions || m_assertionListSizes.empty())
+		return m_assertionList;
+	return {m_assertionList.begin() + static_cast<std::ptrdiff_t>(m_assertionListSizes.back()), m_assertionList.end()};
+}
+
 void EncodingContext::pushSolver()
 {
 	if (m_accumulateAssertions)
 		m_assertions.push_back(assertions());
 	else
 		m_assertions.emplace_back(true);
+	m_assertionListSizes.push_back(m_assertionList.size());
 }
 
 void EncodingContext::popSolver()
 {
 	solAssert(!m_assertions.empty(), "");
 	m_assertions.pop_back();
+	solAssert(!m_assertionListSizes.empty());
+	m_assertionList.resize(m_assertionListSizes.back());
+	m_assertionListSizes.pop_back();
 }
 
 void EncodingContext::addAssertion(smtutil::Expression const& _expr)
 {
 	if (m_assertions.empty())
+	{
 		m_assertions.push_back(_expr);
+		m_assertionListSizes.push_back(m_assertionList.size());
+	}
 	else
 		m_assertions.back() = _expr && std::move(m_assertions.back());
+	m_assertionList.emplace_back(std::make_shared<smtutil::Expression const>(_expr));
 }
@@ -139,6 +139,10 @@ public:
 	//@{
 	/// @returns conjunction of all added assertions.
 	smtutil::Expression assertions();
+	/// @returns the assertions whose conjunction is assertions(), in the order they were added.
+	/// An assertion is represented by the same pointer as long as it is part of the current solver context,
+	/// which allows engines to tell which assertions different points of the encoding have in common.
+	std::vector<std::shared_ptr<smtutil::Expression const>> assertionList() const;
 	void pushSolver();
 	void popSolver();
 	void addAssertion(smtutil::Expression const& _e);
@@ -176,6 +180,10 @@ private:
 
 	/// Assertion stack.
 	std::vector<smtutil::Expression> m_assertions;
+	/// All assertions added to the contexts of the assertion stack.
+	std::vector<std::shared_ptr<smtutil::Expression const>> m_assertionList;
+	/// Size of m_assertionList when each context of the assertion stack was created.
+	std::vector<size_t> m_assertionListSizes;
 
 	/// Whether to conjoin assertions in the assertion stack.
 	bool m_accumulateAssertions = true;
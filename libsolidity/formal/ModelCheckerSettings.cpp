@@ -138,3 +138,12 @@ std::optional<ModelCheckerExtCalls> ModelCheckerExtCalls::fromString(std::string
 		return ModelCheckerExtCalls{Mode::TRUSTED};
 	return {};
 }
+
+std::optional<ModelCheckerPortfolio> ModelCheckerPortfolio::fromString(std::string const& _mode)
+{
+	if (_mode == "all")
+		return ModelCheckerPortfolio{Mode::ALL};
+	if (_mode == "race")
+		return ModelCheckerPortfolio{Mode::RACE};
+	return {};
+}
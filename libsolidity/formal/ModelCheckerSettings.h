@@ -155,6 +155,24 @@ struct ModelCheckerExtCalls
 	bool isTrusted() const { return mode == Mode::TRUSTED; }
 };
 
+/// How BMC queries are sent to the solvers if more than one is enabled.
+struct ModelCheckerPortfolio
+{
+	enum class Mode
+	{
+		/// Query the solvers one after the other and report conflicting answers.
+		ALL,
+		/// Query the solvers concurrently and use the first answer.
+		RACE
+	};
+
+	Mode mode = Mode::ALL;
+
+	static std::optional<ModelCheckerPortfolio> fromString(std::string const& _mode);
+
+	bool isRace() const { return mode == Mode::RACE; }
+};
+
 struct ModelCheckerSettings
 {
 	std::optional<unsigned> bmcLoopIterations;
@@ -169,6 +187,7 @@ struct ModelCheckerSettings
 	ModelCheckerEngine engine = ModelCheckerEngine::None();
 	ModelCheckerExtCalls externalCalls = {};
 	ModelCheckerInvariants invariants = ModelCheckerInvariants::Default();
+	ModelCheckerPortfolio portfolio = {};
 	bool printQuery = false;
 	bool showProvedSafe = false;
 	bool showUnproved = false;
@@ -176,6 +195,9 @@ struct ModelCheckerSettings
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::Z3();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
 	std::optional<unsigned> timeout; // in milliseconds
+	/// Number of threads solving the CHC queries of the verification targets.
+	/// 0 means one per hardware thread.
+	unsigned workers = 1;
 
 	bool operator!=(ModelCheckerSettings const& _other) const noexcept { return !(*this == _other); }
 	bool operator==(ModelCheckerSettings const& _other) const noexcept
@@ -187,13 +209,15 @@ struct ModelCheckerSettings
 			engine == _other.engine &&
 			externalCalls.mode == _other.externalCalls.mode &&
 			invariants == _other.invariants &&
+			portfolio.mode == _other.portfolio.mode &&
 			printQuery == _other.printQuery &&
 			showProvedSafe == _other.showProvedSafe &&
 			showUnproved == _other.showUnproved &&
 			showUnsupported == _other.showUnsupported &&
 			solvers == _other.solvers &&
 			targets == _other.targets &&
-			timeout == _other.timeout;
+			timeout == _other.timeout &&
+			workers == _other.workers;
 	}
 };
 
@@ -0,0 +1,237 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/StringUtils.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+Json locationToJson(SourceLocation const& _location)
+{
+	solAssert(_location.sourceName);
+	Json location;
+	location["source"] = *_location.sourceName;
+	location["start"] = _location.start;
+	location["end"] = _location.end;
+	return location;
+}
+
+SourceLocation locationFromJson(Json const& _location)
+{
+	return SourceLocation{
+		_location.at("start").get<int>(),
+		_location.at("end").get<int>(),
+		std::make_shared<std::string const>(_location.at("source").get<std::string>())
+	};
+}
+
+template <typename T>
+Json optionalToJson(std::optional<T> const& _value)
+{
+	return _value.has_value() ? Json(*_value) : Json();
+}
+
+template <typename T>
+std::optional<T> optionalFromJson(Json const& _value)
+{
+	if (_value.is_null())
+		return std::nullopt;
+	return _value.get<T>();
+}
+
+}
+
+std::optional<Json> CompilationCache::load(
+	h256 const& _key,
+	std::function<void(Json const&)> const& _validate
+) const
+{
+	fs::path const path = entryPath(_key);
+	boost::system::error_code errorCode;
+	if (!fs::is_regular_file(path, errorCode))
+		return std::nullopt;
+
+	Json entry;
+	try
+	{
+		if (!jsonParseStrict(readFileAsString(path), entry) || !entry.is_object())
+			return std::nullopt;
+	}
+	catch (FileNotFound const&)
+	{
+		return std::nullopt;
+	}
+
+	if (_validate)
+		try
+		{
+			_validate(entry);
+		}
+		catch (InternalCompilerError const&)
+		{
+			throw;
+		}
+		catch (std::exception const&)
+		{
+			// Wrong types, missing keys and malformed values, e.g. hex strings or numbers.
+			return std::nullopt;
+		}
+	return entry;
+}
+
+void CompilationCache::store(h256 const& _key, Json const& _entry) const
+{
+	fs::path const path = entryPath(_key);
+	boost::system::error_code errorCode;
+	fs::create_directories(path.parent_path(), errorCode);
+	if (errorCode)
+		return;
+
+	// Write to a temporary file first and rename it afterwards, so that readers
+	// never see partially written entries.
+	fs::path const temporaryPath = path.parent_path() / fs::unique_path(path.filename().string() + ".%%%%-%%%%.tmp");
+	{
+		std::ofstream file(temporaryPath.string(), std::ios::binary | std::ios::trunc);
+		file << jsonCompactPrint(_entry);
+		if (!file)
+		{
+			fs::remove(temporaryPath, errorCode);
+			return;
+		}
+	}
+	fs::rename(temporaryPath, path, errorCode);
+	if (errorCode)
+		fs::remove(temporaryPath, errorCode);
+}
+
+Json CompilationCache::errorToJson(Error const& _error)
+{
+	Json error;
+	error["type"] = Error::formatErrorType(_error.type());
+	error["errorId"] = _error.errorId().error;
+	error["message"] = _error.comment() ? *_error.comment() : "";
+	if (SourceLocation const* location = _error.sourceLocation())
+		error["location"] = locationToJson(*location);
+	if (SecondarySourceLocation const* secondaryLocation = _error.secondarySourceLocation())
+	{
+		error["secondaryLocations"] = Json::array();
+		for (auto const& [message, location]: secondaryLocation->infos)
+		{
+			Json info = locationToJson(location);
+			info["message"] = message;
+			error["secondaryLocations"].emplace_back(std::move(info));
+		}
+	}
+	return error;
+}
+
+std::shared_ptr<Error const> CompilationCache::errorFromJson(Json const& _error)
+{
+	std::optional<Error::Type> type = Error::parseErrorType(_error.at("type").get<std::string>());
+	if (!type.has_value())
+		BOOST_THROW_EXCEPTION(InvalidCacheEntry());
+
+	SecondarySourceLocation secondaryLocation;
+	if (_error.contains("secondaryLocations"))
+		for (Json const& info: _error["secondaryLocations"])
+			secondaryLocation.append(info.at("message").get<std::string>(), locationFromJson(info));
+
+	return std::make_shared<Error const>(
+		ErrorId{_error.at("errorId").get<unsigned long long>()},
+		*type,
+		_error.at("message").get<std::string>(),
+		_error.contains("location") ? locationFromJson(_error["location"]) : SourceLocation{},
+		secondaryLocation
+	);
+}
+
+Json CompilationCache::objectToJson(evmasm::LinkerObject const& _object)
+{
+	Json object;
+	object["bytecode"] = util::toHex(_object.bytecode);
+
+	object["linkReferences"] = Json::object();
+	for (auto const& [offset, library]: _object.linkReferences)
+		object["linkReferences"][std::to_string(offset)] = library;
+
+	object["immutableReferences"] = Json::array();
+	for (auto const& [hash, reference]: _object.immutableReferences)
+		object["immutableReferences"].emplace_back(Json{hash.str(), reference.first, reference.second});
+
+	object["functionDebugData"] = Json::object();
+	for (auto const& [name, info]: _object.functionDebugData)
+		object["functionDebugData"][name] = {
+			{"bytecodeOffset", optionalToJson(info.bytecodeOffset)},
+			{"instructionIndex", optionalToJson(info.instructionIndex)},
+			{"sourceID", optionalToJson(info.sourceID)},
+			{"params", info.params},
+			{"returns", info.returns},
+		};
+	return object;
+}
+
+evmasm::LinkerObject CompilationCache::objectFromJson(Json const& _object)
+{
+	evmasm::LinkerObject object;
+	object.bytecode = util::fromHex(_object.at("bytecode").get<std::string>());
+
+	for (auto const& [offset, library]: _object.at("linkReferences").items())
+	{
+		if (offset.empty() || !std::all_of(offset.begin(), offset.end(), isDigit))
+			BOOST_THROW_EXCEPTION(InvalidCacheEntry());
+		object.linkReferences[std::stoul(offset)] = library.get<std::string>();
+	}
+
+	for (Json const& reference: _object.at("immutableReferences"))
+		object.immutableReferences[u256(reference.at(0).get<std::string>())] = {
+			reference.at(1).get<std::string>(),
+			reference.at(2).get<std::vector<size_t>>()
+		};
+
+	for (auto const& [name, info]: _object.at("functionDebugData").items())
+		object.functionDebugData[name] = {
+			optionalFromJson<size_t>(info.at("bytecodeOffset")),
+			optionalFromJson<size_t>(info.at("instructionIndex")),
+			optionalFromJson<size_t>(info.at("sourceID")),
+			info.at("params").get<size_t>(),
+			info.at("returns").get<size_t>()
+		};
+	return object;
+}
+
+fs::path CompilationCache::entryPath(h256 const& _key) const
+{
+	std::string const name = _key.hex();
+	return m_directory / name.substr(0, 2) / (name + ".json");
+}
@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent on-disk store for the artifacts of compiled source units.
+ */
+
+#pragma once
+
+#include <liblangutil/Exceptions.h>
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/FixedHash.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace solidity::frontend
+{
+
+/// Thrown when decoding an entry of the compilation cache that does not have the expected shape.
+DEV_SIMPLE_EXCEPTION(InvalidCacheEntry);
+
+/**
+ * Content-addressed store of JSON entries in a directory on disk.
+ *
+ * The keys are computed by the users of the store from everything that influences the entry,
+ * e.g. by CompilerStack from everything that influences the compilation of a source unit
+ * and by SMTSolverCommand from the query and the solver, so an entry never has to be invalidated. Writes are atomic, which makes
+ * it safe to share the directory between concurrently running compiler processes.
+ * Failures to read or write entries are not errors, they only make the cache less effective.
+ */
+class CompilationCache
+{
+public:
+	explicit CompilationCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+	/// @returns the entry stored under @a _key or nullopt if there is no such entry
+	/// or it cannot be read.
+	/// If given, @a _validate is called with the entry and has to throw if the entry does not
+	/// have the shape expected by the caller, e.g. because it was written by a different version.
+	/// Such entries are treated as missing as well.
+	std::optional<Json> load(
+		util::h256 const& _key,
+		std::function<void(Json const&)> const& _validate = {}
+	) const;
+
+	/// Stores @a _entry under @a _key, replacing any existing entry.
+	void store(util::h256 const& _key, Json const& _entry) const;
+
+	/// The decoding functions throw InvalidCacheEntry or the exceptions of the JSON library
+	/// if their input does not have the shape produced by the encoding functions.
+	static Json errorToJson(langutil::Error const& _error);
+	static std::shared_ptr<langutil::Error const> errorFromJson(Json const& _error);
+
+	static Json objectToJson(evmasm::LinkerObject const& _object);
+	static evmasm::LinkerObject objectFromJson(Json const& _object);
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
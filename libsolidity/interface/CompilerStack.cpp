@@ -24,6 +24,7 @@
 
 
 #include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/ImportRemapper.h>
 
 #include <libsolidity/analysis/ControlFlowAnalyzer.h>
@@ -73,6 +74,7 @@
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
 #include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/StackLayoutCache.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
@@ -84,10 +86,14 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Parallel.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
+#include <range/v3/action/remove_if.hpp>
 #include <range/v3/algorithm/all_of.hpp>
+#include <range/v3/algorithm/any_of.hpp>
+#include <range/v3/range/conversion.hpp>
 #include <range/v3/view/concat.hpp>
 #include <range/v3/view/map.hpp>
 
@@ -127,7 +133,7 @@ CompilerStack::~CompilerStack()
 
 void CompilerStack::createAndAssignCallGraphs()
 {
-	for (Source const* source: m_sourceOrder)
+	for (Source const* source: m_sourcesToAnalyze)
 	{
 		if (!source->ast)
 			continue;
@@ -162,7 +168,7 @@ void CompilerStack::findAndReportCyclicContractDependencies()
 	// Cycles we found, used to avoid duplicate reports for the same reference
 	std::set<ASTNode const*, ASTNode::CompareByID> foundCycles;
 
-	for (Source const* source: m_sourceOrder)
+	for (Source const* source: m_sourcesToAnalyze)
 	{
 		if (!source->ast)
 			continue;
@@ -236,6 +242,18 @@ void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 	m_globalContext.reset();
 }
 
+void CompilerStack::setParallelism(size_t _parallelism)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set parallelism before compiling.");
+	m_parallelism = _parallelism;
+}
+
+void CompilerStack::setCompilationCache(std::shared_ptr<CompilationCache> _cache)
+{
+	solAssert(m_stackState < ParsedAndImported, "Must set the compilation cache before parsing.");
+	m_compilationCache = std::move(_cache);
+}
+
 void CompilerStack::setEOFVersion(std::optional<uint8_t> _version)
 {
 	solAssert(m_stackState < CompilationSuccessful, "Must set EOF version before compiling.");
@@ -301,6 +319,7 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, std::string const& _re
 
 void CompilerStack::reset(bool _keepSettings)
 {
+	retainAnalysis();
 	m_stackState = Empty;
 	m_sources.clear();
 	m_maxAstId.reset();
@@ -312,6 +331,8 @@ void CompilerStack::reset(bool _keepSettings)
 		m_libraries.clear();
 		m_viaIR = false;
 		m_evmVersion = langutil::EVMVersion();
+		m_parallelism = 1;
+		m_compilationCache.reset();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_generateIR = false;
 		m_revertStrings = RevertStrings::Default;
@@ -320,15 +341,214 @@ void CompilerStack::reset(bool _keepSettings)
 		m_metadataFormat = defaultMetadataFormat();
 		m_metadataHash = MetadataHash::IPFS;
 		m_stopAfter = State::CompilationSuccessful;
+		m_measureTimings = false;
 	}
+	m_phases.clear();
+	m_stackLayoutCacheStatisticsAtStart = Json();
 	m_experimentalAnalysis.reset();
 	m_globalContext.reset();
 	m_sourceOrder.clear();
+	m_sourcesToAnalyze.clear();
+	m_reusedSources.clear();
 	m_contracts.clear();
+	m_cacheKeys.clear();
+	m_cacheEntries.clear();
+	m_restoredFromCache = false;
 	m_errorReporter.clear();
+	if (m_retainedAnalysis.sources.empty())
+		TypeProvider::reset();
+}
+
+void CompilerStack::enableIncrementalAnalysis(bool _enabled)
+{
+	solAssert(m_stackState < ParsedAndImported, "Must enable incremental analysis before parsing.");
+	m_incrementalAnalysis = _enabled;
+	if (!_enabled && !m_retainedAnalysis.sources.empty())
+		discardRetainedAnalysis();
+}
+
+std::set<std::string> CompilerStack::reusedSources() const
+{
+	return util::keys(m_reusedSources);
+}
+
+void CompilerStack::retainAnalysis()
+{
+	if (!m_incrementalAnalysis)
+	{
+		m_retainedAnalysis = {};
+		return;
+	}
+	// Nothing was parsed since the source units were retained.
+	if (!m_retainedAnalysis.sources.empty())
+		return;
+
+	std::set<std::string> namesToRetain = util::keys(m_reusedSources);
+	if (
+		m_stackState >= AnalysisSuccessful &&
+		m_compilationSourceType == CompilationSourceType::Solidity &&
+		!m_experimentalAnalysis
+	)
+		for (Source const* source: m_sourcesToAnalyze)
+			namesToRetain.insert(*source->ast->annotation().path);
+	// The global context is dropped when the EVM version changes.
+	if (namesToRetain.empty() || !m_globalContext)
+	{
+		m_retainedAnalysis = {};
+		return;
+	}
+
+	for (auto& [name, source]: m_sources)
+		if (namesToRetain.count(name))
+		{
+			if (m_reusedSources.count(name))
+				m_retainedAnalysis.errors[name] = std::move(m_reusedSources[name]);
+			else
+				for (std::shared_ptr<Error const> const& error: m_errorReporter.errors())
+					if (error->sourceLocation() && error->sourceLocation()->sourceName && *error->sourceLocation()->sourceName == name)
+						m_retainedAnalysis.errors[name].push_back(error);
+			m_retainedAnalysis.sources[name] = std::move(source);
+		}
+		else if (source.ast)
+			for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source.ast->nodes()))
+				m_globalContext->forgetContract(*contract);
+
+	m_retainedAnalysis.globalContext = m_globalContext;
+	m_retainedAnalysis.evmVersion = m_evmVersion;
+	m_retainedAnalysis.eofVersion = m_eofVersion;
+	m_retainedAnalysis.runYulOptimiser = m_optimiserSettings.runYulOptimiser;
+	m_retainedAnalysis.remappings = m_importRemapper.remappings();
+	if (m_maxAstId)
+		m_retainedAnalysis.maxAstId = *m_maxAstId;
+	if (m_reusedSources.empty())
+		m_retainedAnalysis.maxTypeCount = 2 * TypeProvider::generalTypeCount();
+}
+
+void CompilerStack::reuseRetainedAnalysis()
+{
+	solAssert(m_reusedSources.empty());
+	if (m_retainedAnalysis.sources.empty())
+		return;
+
+	if (
+		!m_incrementalAnalysis ||
+		m_stopAfter != AnalysisSuccessful ||
+		m_retainedAnalysis.evmVersion != m_evmVersion ||
+		m_retainedAnalysis.eofVersion != m_eofVersion ||
+		m_retainedAnalysis.runYulOptimiser != m_optimiserSettings.runYulOptimiser ||
+		m_retainedAnalysis.remappings != m_importRemapper.remappings() ||
+		TypeProvider::generalTypeCount() > m_retainedAnalysis.maxTypeCount
+	)
+	{
+		discardRetainedAnalysis();
+		return;
+	}
+
+	std::map<std::string, Source>& retainedSources = m_retainedAnalysis.sources;
+	auto importedSourceNames = [](SourceUnit const& _sourceUnit) {
+		std::vector<std::string> names;
+		for (ImportDirective const* import: ASTNode::filteredNodes<ImportDirective>(_sourceUnit.nodes()))
+			names.push_back(*import->annotation().absolutePath);
+		return names;
+	};
+
+	// Load the retained source units that are imported by retained source units but were not supplied
+	// this time, in the same way as parsing would.
+	std::vector<std::string> toVisit;
+	for (auto const& [name, source]: m_sources)
+		toVisit.push_back(name);
+	while (!toVisit.empty())
+	{
+		std::string const name = std::move(toVisit.back());
+		toVisit.pop_back();
+		if (!retainedSources.count(name))
+			continue;
+		for (std::string const& importedName: importedSourceNames(*retainedSources.at(name).ast))
+			if (!m_sources.count(importedName) && retainedSources.count(importedName) && m_readFile)
+			{
+				ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importedName);
+				if (!result.success)
+					continue;
+				m_sources[importedName].charStream = std::make_shared<CharStream>(result.responseOrErrorMessage, importedName);
+				toVisit.push_back(importedName);
+			}
+	}
+
+	std::set<std::string> reusableNames;
+	for (auto const& [name, source]: retainedSources)
+		if (m_sources.count(name) && m_sources.at(name).charStream->source() == source.charStream->source())
+			reusableNames.insert(name);
+	// A source unit can only be reused if all source units it imports are reused as well.
+	for (bool changed = true; changed;)
+	{
+		changed = false;
+		for (auto it = reusableNames.begin(); it != reusableNames.end();)
+			if (ranges::any_of(
+				importedSourceNames(*retainedSources.at(*it).ast),
+				[&](std::string const& _importedName) { return !reusableNames.count(_importedName); }
+			))
+			{
+				it = reusableNames.erase(it);
+				changed = true;
+			}
+			else
+				++it;
+	}
+
+	if (reusableNames.empty())
+	{
+		discardRetainedAnalysis();
+		return;
+	}
+
+	m_globalContext = std::move(m_retainedAnalysis.globalContext);
+	for (auto& [name, source]: retainedSources)
+		if (reusableNames.count(name))
+		{
+			m_sources[name] = std::move(source);
+			m_reusedSources[name] = std::move(m_retainedAnalysis.errors[name]);
+		}
+		else
+			for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source.ast->nodes()))
+				m_globalContext->forgetContract(*contract);
+	retainedSources.clear();
+	m_retainedAnalysis.errors.clear();
+
+	// Cached members of types might refer to the discarded AST nodes.
+	TypeProvider::resetCaches();
+}
+
+void CompilerStack::discardRetainedAnalysis()
+{
+	solAssert(!m_globalContext);
+	m_retainedAnalysis = {};
 	TypeProvider::reset();
 }
 
+void CompilerStack::removeDuplicateErrorsOfReusedSources()
+{
+	if (m_reusedSources.empty())
+		return;
+
+	auto const commentOf = [](Error const& _error) {
+		return _error.comment() ? *_error.comment() : std::string{};
+	};
+	auto const isDuplicateOfReusedError = [&](std::shared_ptr<Error const> const& _error) {
+		SourceLocation const* location = _error->sourceLocation();
+		if (!location || !location->sourceName || !m_reusedSources.count(*location->sourceName))
+			return false;
+		return ranges::any_of(m_reusedSources.at(*location->sourceName), [&](std::shared_ptr<Error const> const& _reusedError) {
+			return
+				_reusedError != _error &&
+				_reusedError->type() == _error->type() &&
+				_reusedError->errorId() == _error->errorId() &&
+				*_reusedError->sourceLocation() == *location &&
+				commentOf(*_reusedError) == commentOf(*_error);
+		});
+	};
+	ranges::actions::remove_if(m_errorList, isDuplicateOfReusedError);
+}
+
 void CompilerStack::setSources(StringMap _sources)
 {
 	solAssert(m_stackState != SourcesSet, "Cannot change sources once set.");
@@ -342,17 +562,22 @@ bool CompilerStack::parse()
 {
 	solAssert(m_stackState == SourcesSet, "Must call parse only after the SourcesSet state.");
 	m_errorReporter.clear();
+	util::ScopedPhaseMeasurement measurement(phases(), "parsing");
 
 	if (SemVerVersion{std::string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
+	reuseRetainedAnalysis();
+
 	try
 	{
-		Parser parser{m_errorReporter, m_evmVersion};
+		// Node IDs have to stay unique across the reused and the newly parsed source units.
+		Parser parser{m_errorReporter, m_evmVersion, m_retainedAnalysis.maxAstId};
 
 		std::vector<std::string> sourcesToParse;
 		for (auto const& s: m_sources)
-			sourcesToParse.push_back(s.first);
+			if (!m_reusedSources.count(s.first))
+				sourcesToParse.push_back(s.first);
 
 		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
@@ -398,6 +623,10 @@ bool CompilerStack::parse()
 			}
 		}
 
+		// The errors reported when the reused source units were analysed.
+		for (auto const& [name, errors]: m_reusedSources)
+			m_errorReporter.append(errors);
+
 		if (Error::containsErrors(m_errorReporter.errors()))
 			return false;
 
@@ -418,6 +647,8 @@ bool CompilerStack::parse()
 void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 {
 	solAssert(m_stackState == Empty, "Must call importASTs only before the SourcesSet state.");
+	if (!m_retainedAnalysis.sources.empty())
+		discardRetainedAnalysis();
 	std::map<std::string, ASTPointer<SourceUnit>> reconstructedSources = ASTJsonImporter(m_evmVersion).jsonToSourceUnit(_sources);
 	for (auto& src: reconstructedSources)
 	{
@@ -442,12 +673,22 @@ bool CompilerStack::analyze()
 {
 	solAssert(m_stackState == ParsedAndImported, "Must call analyze only after parsing was successful.");
 
-	if (!resolveImports())
-		return false;
+	// Reused source units are not analysed again, but some of their errors might be reported again
+	// while analysing the source units that depend on them.
+	ScopeGuard removeDuplicateErrors([&]{ removeDuplicateErrorsOfReusedSources(); });
 
-	for (Source const* source: m_sourceOrder)
-		if (source->ast)
-			Scoper::assignScopes(*source->ast);
+	{
+		util::ScopedPhaseMeasurement measurement(phases(), "importResolution");
+		if (!resolveImports())
+			return false;
+	}
+
+	{
+		util::ScopedPhaseMeasurement measurement(phases(), "scoper");
+		for (Source const* source: m_sourcesToAnalyze)
+			if (source->ast)
+				Scoper::assignScopes(*source->ast);
+	}
 
 	bool noErrors = true;
 
@@ -455,38 +696,52 @@ bool CompilerStack::analyze()
 	{
 		bool experimentalSolidity = isExperimentalSolidity();
 
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		{
+			util::ScopedPhaseMeasurement measurement(phases(), "syntaxChecker");
+			SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
+			for (Source const* source: m_sourcesToAnalyze)
+				if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
+					noErrors = false;
+		}
 
-		m_globalContext = std::make_shared<GlobalContext>(m_evmVersion);
+		// The annotations of reused source units refer to the declarations of the global context.
+		if (m_reusedSources.empty())
+			m_globalContext = std::make_shared<GlobalContext>(m_evmVersion);
+		solAssert(m_globalContext);
 		// We need to keep the same resolver during the whole process.
+		// Reused source units are registered as well, so that the other source units can refer to them.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter, experimentalSolidity);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.registerDeclarations(*source->ast))
-				return false;
+		{
+			util::ScopedPhaseMeasurement measurement(phases(), "declarationRegistration");
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.registerDeclarations(*source->ast))
+					return false;
 
-		std::map<std::string, SourceUnit const*> sourceUnitsByName;
-		for (auto& source: m_sources)
-			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
+			std::map<std::string, SourceUnit const*> sourceUnitsByName;
+			for (auto& source: m_sources)
+				sourceUnitsByName[source.first] = source.second.ast.get();
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
+					return false;
 
-		resolver.warnHomonymDeclarations();
+			resolver.warnHomonymDeclarations();
+		}
 
 		{
+			util::ScopedPhaseMeasurement measurement(phases(), "docStringTagParser");
 			DocStringTagParser docStringTagParser(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: m_sourcesToAnalyze)
 				if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
 					noErrors = false;
 		}
 
-		// Requires DocStringTagParser
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
-				return false;
+		{
+			util::ScopedPhaseMeasurement measurement(phases(), "nameAndTypeResolution");
+			// Requires DocStringTagParser
+			for (Source const* source: m_sourcesToAnalyze)
+				if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
+					return false;
+		}
 
 		if (experimentalSolidity)
 		{
@@ -519,53 +774,67 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 {
 	bool noErrors = _noErrorsSoFar;
 
-	DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !declarationTypeChecker.check(*source->ast))
-			return false;
+	{
+		util::ScopedPhaseMeasurement measurement(phases(), "declarationTypeChecker");
+		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
+		for (Source const* source: m_sourcesToAnalyze)
+			if (source->ast && !declarationTypeChecker.check(*source->ast))
+				return false;
+	}
 
-	// Requires DeclarationTypeChecker to have run
-	DocStringTagParser docStringTagParser(m_errorReporter);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
-			noErrors = false;
+	{
+		util::ScopedPhaseMeasurement measurement(phases(), "docStringTagValidation");
+		// Requires DeclarationTypeChecker to have run
+		DocStringTagParser docStringTagParser(m_errorReporter);
+		for (Source const* source: m_sourcesToAnalyze)
+			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
+				noErrors = false;
+	}
 
-	// Next, we check inheritance, overrides, function collisions and other things at
-	// contract or function level.
-	// This also calculates whether a contract is abstract, which is needed by the
-	// type checker.
-	ContractLevelChecker contractLevelChecker(m_errorReporter);
+	{
+		util::ScopedPhaseMeasurement measurement(phases(), "contractLevelChecker");
+		// Next, we check inheritance, overrides, function collisions and other things at
+		// contract or function level.
+		// This also calculates whether a contract is abstract, which is needed by the
+		// type checker.
+		ContractLevelChecker contractLevelChecker(m_errorReporter);
+
+		for (Source const* source: m_sourcesToAnalyze)
+			if (auto sourceAst = source->ast)
+				noErrors = contractLevelChecker.check(*sourceAst);
+	}
 
-	for (Source const* source: m_sourceOrder)
-		if (auto sourceAst = source->ast)
-			noErrors = contractLevelChecker.check(*sourceAst);
-
-	// Now we run full type checks that go down to the expression level. This
-	// cannot be done earlier, because we need cross-contract types and information
-	// about whether a contract is abstract for the `new` expression.
-	// This populates the `type` annotation for all expressions.
-	//
-	// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
-	// which is only done one step later.
-	TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
-			noErrors = false;
+	{
+		util::ScopedPhaseMeasurement measurement(phases(), "typeChecker");
+		// Now we run full type checks that go down to the expression level. This
+		// cannot be done earlier, because we need cross-contract types and information
+		// about whether a contract is abstract for the `new` expression.
+		// This populates the `type` annotation for all expressions.
+		//
+		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
+		// which is only done one step later.
+		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
+		for (Source const* source: m_sourcesToAnalyze)
+			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
+				noErrors = false;
+	}
 
 	if (noErrors)
 	{
+		util::ScopedPhaseMeasurement measurement(phases(), "docStringAnalyser");
 		// Requires ContractLevelChecker and TypeChecker
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: m_sourcesToAnalyze)
 			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
 				noErrors = false;
 	}
 
 	if (noErrors)
 	{
+		util::ScopedPhaseMeasurement measurement(phases(), "postTypeChecker");
 		// Checks that can only be done when all types of all AST nodes are known.
 		PostTypeChecker postTypeChecker(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: m_sourcesToAnalyze)
 			if (source->ast && !postTypeChecker.check(*source->ast))
 				noErrors = false;
 		if (!postTypeChecker.finalize())
@@ -575,29 +844,38 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	// Create & assign callgraphs and check for contract dependency cycles
 	if (noErrors)
 	{
+		util::ScopedPhaseMeasurement measurement(phases(), "callGraph");
 		createAndAssignCallGraphs();
 		annotateInternalFunctionIDs();
 		findAndReportCyclicContractDependencies();
 	}
 
 	if (noErrors)
-		for (Source const* source: m_sourceOrder)
+	{
+		util::ScopedPhaseMeasurement measurement(phases(), "postTypeContractLevelChecker");
+		for (Source const* source: m_sourcesToAnalyze)
 			if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
 				noErrors = false;
+	}
 
 	// Check that immutable variables are never read in c'tors and assigned
 	// exactly once
 	if (noErrors)
-		for (Source const* source: m_sourceOrder)
+	{
+		util::ScopedPhaseMeasurement measurement(phases(), "immutableValidator");
+		for (Source const* source: m_sourcesToAnalyze)
 			if (source->ast)
 				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 						ImmutableValidator(m_errorReporter, *contract).analyze();
+	}
 
 	if (noErrors)
 	{
+		util::ScopedPhaseMeasurement measurement(phases(), "controlFlowAnalyzer");
 		// Control flow graph generator and analyzer. It can check for issues such as
 		// variable is used before it is assigned to.
+		// The flows of the functions in reused source units are needed to analyse calls to them.
 		CFG cfg(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !cfg.constructFlow(*source->ast))
@@ -616,18 +894,20 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		util::ScopedPhaseMeasurement measurement(phases(), "staticAnalyzer");
 		// Checks for common mistakes. Only generates warnings.
 		StaticAnalyzer staticAnalyzer(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: m_sourcesToAnalyze)
 			if (source->ast && !staticAnalyzer.analyze(*source->ast))
 				noErrors = false;
 	}
 
 	if (noErrors)
 	{
+		util::ScopedPhaseMeasurement measurement(phases(), "viewPureChecker");
 		// Check for state mutability in every function.
 		std::vector<ASTPointer<ASTNode>> ast;
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: m_sourcesToAnalyze)
 			if (source->ast)
 				ast.push_back(source->ast);
 
@@ -637,6 +917,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		util::ScopedPhaseMeasurement measurement(phases(), "modelChecker");
 		// Run SMTChecker
 
 		auto allSources = util::applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
@@ -663,6 +944,7 @@ bool CompilerStack::analyzeExperimental()
 {
 	solAssert(!m_experimentalAnalysis);
 	solAssert(m_maxAstId && *m_maxAstId >= 0);
+	util::ScopedPhaseMeasurement measurement(phases(), "experimentalAnalysis");
 	m_experimentalAnalysis = std::make_unique<experimental::Analysis>(m_errorReporter, static_cast<std::uint64_t>(*m_maxAstId));
 	std::vector<std::shared_ptr<SourceUnit const>> sourceAsts;
 	for (Source const* source: m_sourceOrder)
@@ -692,73 +974,155 @@ bool CompilerStack::isRequestedSource(std::string const& _sourceName) const
 }
 
 bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) const
+{
+	return isRequestedContract(_contract.sourceUnitName(), _contract.name());
+}
+
+bool CompilerStack::isRequestedContract(std::string const& _sourceName, std::string const& _contractName) const
 {
 	/// In case nothing was specified in outputSelection.
 	if (m_requestedContractNames.empty())
 		return true;
 
-	for (auto const& key: std::vector<std::string>{"", _contract.sourceUnitName()})
+	for (auto const& key: std::vector<std::string>{"", _sourceName})
 	{
 		auto const& it = m_requestedContractNames.find(key);
 		if (it != m_requestedContractNames.end())
-			if (it->second.count(_contract.name()) || it->second.count(""))
+			if (it->second.count(_contractName) || it->second.count(""))
 				return true;
 	}
 
 	return false;
 }
 
+namespace
+{
+
+/// @returns the hits and misses of the stack layout caches, which are shared by all compilations in the process.
+Json stackLayoutCacheStatistics()
+{
+	auto cacheToJson = [](yul::StackLayoutCacheStatistics const& _statistics) {
+		Json result;
+		result["hits"] = _statistics.hits;
+		result["misses"] = _statistics.misses;
+		return result;
+	};
+	Json output;
+	output["shuffles"] = cacheToJson(yul::StackLayoutCaches::shuffles().statistics());
+	output["combinations"] = cacheToJson(yul::StackLayoutCaches::combinations().statistics());
+	output["idealLayouts"] = cacheToJson(yul::StackLayoutCaches::idealLayouts().statistics());
+	return output;
+}
+
+}
+
 bool CompilerStack::compile(State _stopAfter)
 {
 	m_stopAfter = _stopAfter;
+	if (m_measureTimings)
+		m_stackLayoutCacheStatisticsAtStart = stackLayoutCacheStatistics();
+	std::optional<size_t> analysisErrorsStart;
 	if (m_stackState < AnalysisSuccessful)
-		if (!parseAndAnalyze(_stopAfter))
+	{
+		if (m_stackState < ParsedAndImported)
+		{
+			if (!parse())
+				return false;
+			if (m_stackState >= m_stopAfter)
+				return true;
+		}
+
+		loadCacheEntries();
+		if (restoreFromCache())
+			return true;
+
+		analysisErrorsStart = m_errorReporter.errors().size();
+		if (!analyze())
 			return false;
+	}
 
 	if (m_stackState >= m_stopAfter)
 		return true;
 
 	// Only compile contracts individually which have been requested.
-	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
-
+	std::vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
+					requestedContracts.push_back(contract);
+
+	size_t const compilationErrorsStart = m_errorReporter.errors().size();
+	if (!m_cacheEntries.empty())
+	{
+		for (auto& [name, contract]: m_contracts)
+			if (m_cacheEntries.count(contract.contract->sourceUnitName()))
+				restoreContractFromCache(contract, contract.contract->sourceUnitName(), false);
+
+		std::set<ContractDefinition const*> restoredContracts = contractsToRestoreFromCache(requestedContracts);
+		for (ContractDefinition const* contract: restoredContracts)
+		{
+			restoreContractFromCache(m_contracts.at(contract->fullyQualifiedName()), contract->sourceUnitName(), true);
+			// Replay the warnings code generation reported for the contract.
+			for (Json const& error: m_cacheEntries.at(contract->sourceUnitName()).at("compilationErrors"))
+			{
+				std::shared_ptr<Error const> restoredError = CompilationCache::errorFromJson(error);
+				if (contract->location().contains(*restoredError->sourceLocation()))
+					m_errorReporter.append({restoredError});
+			}
+		}
+		requestedContracts.erase(
+			std::remove_if(requestedContracts.begin(), requestedContracts.end(), [&](ContractDefinition const* _contract) {
+				return restoredContracts.count(_contract) > 0;
+			}),
+			requestedContracts.end()
+		);
+	}
+
+	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
+	try
+	{
+		if (m_viaIR && util::effectiveConcurrency(m_parallelism) > 1)
+			compileViaIRConcurrently(requestedContracts);
+		else
+			for (ContractDefinition const* contract: requestedContracts)
+			{
+				if ((m_generateEvmBytecode && m_viaIR) || m_generateIR)
+					generateIR(*contract);
+				if (m_generateEvmBytecode)
 				{
-					try
+					if (m_viaIR)
 					{
-						if ((m_generateEvmBytecode && m_viaIR) || m_generateIR)
-							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-							{
-								if (m_experimentalAnalysis)
-									solThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
-								compileContract(*contract, otherCompilers);
-							}
-						}
+						generateEVMFromIR(*contract);
+						checkCodeSizeLimits(*contract);
 					}
-					catch (Error const& _error)
+					else
 					{
-						// Since codegen has no access to the error reporter, the only way for it to
-						// report an error is to throw. In most cases it uses dedicated exceptions,
-						// but CodeGenerationError is one case where someone decided to just throw Error.
-						solAssert(_error.type() == Error::Type::CodeGenerationError);
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _error)
-					{
-						reportUnimplementedFeatureError(_error);
-						return false;
+						if (m_experimentalAnalysis)
+							solThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
+						compileContract(*contract, otherCompilers);
 					}
 				}
+			}
+	}
+	catch (Error const& _error)
+	{
+		// Since codegen has no access to the error reporter, the only way for it to
+		// report an error is to throw. In most cases it uses dedicated exceptions,
+		// but CodeGenerationError is one case where someone decided to just throw Error.
+		solAssert(_error.type() == Error::Type::CodeGenerationError);
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+		return false;
+	}
+	catch (UnimplementedFeatureError const& _error)
+	{
+		reportUnimplementedFeatureError(_error);
+		return false;
+	}
 	m_stackState = CompilationSuccessful;
 	this->link();
+	if (analysisErrorsStart.has_value())
+		storeInCache(*analysisErrorsStart, compilationErrorsStart);
 	return true;
 }
 
@@ -781,6 +1145,15 @@ std::vector<std::string> CompilerStack::contractNames() const
 	return contractNames;
 }
 
+std::vector<std::string> CompilerStack::contractsRestoredFromCache() const
+{
+	std::vector<std::string> contractNames;
+	for (auto const& [name, contract]: m_contracts)
+		if (contract.restoredFromCache)
+			contractNames.push_back(name);
+	return contractNames;
+}
+
 std::string const CompilerStack::lastContractName(std::optional<std::string> const& _sourceName) const
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "Parsing was not successful.");
@@ -911,20 +1284,56 @@ Json const& CompilerStack::yulIRAst(std::string const& _contractName) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
 	solUnimplementedAssert(!isExperimentalSolidity());
-	return contract(_contractName).yulIRAst;
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIRAst.init([&]{
+		if (compiledContract.yulIR.empty())
+			return Json{};
+
+		yul::YulStack stack(
+			m_evmVersion,
+			m_eofVersion,
+			yul::YulStack::Language::StrictAssembly,
+			m_optimiserSettings,
+			m_debugInfoSelection
+		);
+		bool yulAnalysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIR);
+		solAssert(yulAnalysisSuccessful);
+		return stack.astJson();
+	});
 }
 
 std::string const& CompilerStack::yulIROptimized(std::string const& _contractName) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
-	return contract(_contractName).yulIROptimized;
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIROptimized.init([&]{
+		if (!compiledContract.yulIRStack)
+			return std::string{};
+		return compiledContract.yulIRStack->print(this);
+	});
 }
 
 Json const& CompilerStack::yulIROptimizedAst(std::string const& _contractName) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
 	solUnimplementedAssert(!isExperimentalSolidity());
-	return contract(_contractName).yulIROptimizedAst;
+	Contract const& compiledContract = contract(_contractName);
+	solAssert(!compiledContract.restoredFromCache, "The optimized IR AST is not stored in the compilation cache.");
+	return compiledContract.yulIROptimizedAst.init([&]{
+		if (!compiledContract.yulIRStack)
+			return Json{};
+		return compiledContract.yulIRStack->astJson();
+	});
+}
+
+Json CompilerStack::yulOptimizerProfile(std::string const& _contractName) const
+{
+	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
+	Contract const& compiledContract = contract(_contractName);
+	solAssert(!compiledContract.restoredFromCache, "The Yul optimizer profile is not stored in the compilation cache.");
+	if (!compiledContract.yulIRStack)
+		return Json{};
+	return compiledContract.yulIRStack->optimiserProfile();
 }
 
 evmasm::LinkerObject const& CompilerStack::object(std::string const& _contractName) const
@@ -945,23 +1354,25 @@ std::string CompilerStack::assemblyString(std::string const& _contractName, Stri
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
 
 	Contract const& currentContract = contract(_contractName);
+	solAssert(!currentContract.restoredFromCache, "The assembly text is not stored in the compilation cache.");
 	if (currentContract.evmAssembly)
 		return currentContract.evmAssembly->assemblyString(m_debugInfoSelection, _sourceCodes);
 	else
 		return std::string();
 }
 
-/// TODO: cache the JSON
 Json CompilerStack::assemblyJSON(std::string const& _contractName) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
 	solUnimplementedAssert(!isExperimentalSolidity());
 
 	Contract const& currentContract = contract(_contractName);
-	if (currentContract.evmAssembly)
-		return currentContract.evmAssembly->assemblyJSON(sourceIndices());
-	else
-		return Json();
+	return currentContract.assemblyJSON.init([&]{
+		if (currentContract.evmAssembly)
+			return currentContract.evmAssembly->assemblyJSON(sourceIndices());
+		else
+			return Json();
+	});
 }
 
 std::vector<std::string> CompilerStack::sourceNames() const
@@ -1042,6 +1453,11 @@ Json CompilerStack::interfaceSymbols(std::string const& _contractName) const
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solUnimplementedAssert(!isExperimentalSolidity());
 
+	return contract(_contractName).interfaceSymbols.init([&]{ return generateInterfaceSymbols(_contractName); });
+}
+
+Json CompilerStack::generateInterfaceSymbols(std::string const& _contractName) const
+{
 	Json interfaceSymbols;
 	// Always have a methods object
 	interfaceSymbols["methods"] = Json::object();
@@ -1092,6 +1508,7 @@ SourceUnit const& CompilerStack::ast(std::string const& _sourceName) const
 {
 	solAssert(m_stackState >= Parsed, "Parsing not yet performed.");
 	solAssert(source(_sourceName).ast, "Parsing was not successful.");
+	solAssert(!m_restoredFromCache, "The AST was not analyzed since the compilation was restored from the cache.");
 	solUnimplementedAssert(!isExperimentalSolidity());
 	return *source(_sourceName).ast;
 }
@@ -1234,6 +1651,10 @@ bool CompilerStack::resolveImports()
 	}
 
 	swap(m_sourceOrder, sourceOrder);
+	m_sourcesToAnalyze.clear();
+	for (Source const* source: m_sourceOrder)
+		if (!m_reusedSources.count(*source->ast->annotation().path))
+			m_sourcesToAnalyze.push_back(source);
 	return true;
 }
 
@@ -1257,7 +1678,7 @@ void CompilerStack::storeContractDefinitions()
 
 void CompilerStack::annotateInternalFunctionIDs()
 {
-	for (Source const* source: m_sourceOrder)
+	for (Source const* source: m_sourcesToAnalyze)
 	{
 		if (!source->ast)
 			continue;
@@ -1299,19 +1720,21 @@ bool onlySafeExperimentalFeaturesActivated(std::set<ExperimentalFeature> const&
 void CompilerStack::assembleYul(
 	ContractDefinition const& _contract,
 	std::shared_ptr<evmasm::Assembly> _assembly,
-	std::shared_ptr<evmasm::Assembly> _runtimeAssembly
+	std::shared_ptr<evmasm::Assembly> _runtimeAssembly,
+	size_t _concurrency
 )
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
+	util::ScopedPhaseMeasurement measurement(phases(compiledContract), "assembly");
 	compiledContract.evmAssembly = _assembly;
 	solAssert(compiledContract.evmAssembly, "");
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
-		compiledContract.object = compiledContract.evmAssembly->assemble();
+		compiledContract.object = compiledContract.evmAssembly->assemble(_concurrency);
 	}
 	catch (evmasm::AssemblyException const&)
 	{
@@ -1331,6 +1754,12 @@ void CompilerStack::assembleYul(
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
 
+}
+
+void CompilerStack::checkCodeSizeLimits(ContractDefinition const& _contract)
+{
+	Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation returns data with length greater than 0x6000 (2^14 + 2^13) bytes,
 	//   contract creation fails with an out of gas error.
@@ -1394,15 +1823,19 @@ void CompilerStack::compileContract(
 	solAssert(!m_viaIR, "");
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract, /* _forIR */ false);
 
-	// Run optimiser and compile the contract.
-	compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+	{
+		util::ScopedPhaseMeasurement measurement(phases(compiledContract), "legacyCodeGeneration");
+		// Run optimiser and compile the contract.
+		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+	}
 
 	_otherCompilers[compiledContract.contract] = compiler;
 
 	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	checkCodeSizeLimits(_contract);
 }
 
-void CompilerStack::generateIR(ContractDefinition const& _contract)
+void CompilerStack::generateIR(ContractDefinition const& _contract, bool _optimize)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1420,72 +1853,108 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 
 	std::string dependenciesSource;
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
-		generateIR(*dependency);
+		generateIR(*dependency, _optimize);
 
 	if (!_contract.canBeDeployed())
 		return;
 
-	std::map<ContractDefinition const*, std::string_view const> otherYulSources;
-	for (auto const& pair: m_contracts)
-		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
-
-	if (m_experimentalAnalysis)
 	{
-		experimental::IRGenerator generator(
-			m_evmVersion,
-			m_eofVersion,
-			m_revertStrings,
-			sourceIndices(),
-			m_debugInfoSelection,
-			this,
-			*m_experimentalAnalysis
-		);
-		compiledContract.yulIR = generator.run(
-			_contract,
-			{}, // TODO: createCBORMetadata(compiledContract, /* _forIR */ true),
-			otherYulSources
-		);
-	}
-	else
-	{
-		IRGenerator generator(
-			m_evmVersion,
-			m_eofVersion,
-			m_revertStrings,
-			sourceIndices(),
-			m_debugInfoSelection,
-			this,
-			m_optimiserSettings
-		);
-		compiledContract.yulIR = generator.run(
-			_contract,
-			createCBORMetadata(compiledContract, /* _forIR */ true),
-			otherYulSources
-		);
+		util::ScopedPhaseMeasurement measurement(phases(compiledContract), "irGeneration");
+		std::map<ContractDefinition const*, std::string_view const> otherYulSources;
+		for (auto const& pair: m_contracts)
+			otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
+
+		if (m_experimentalAnalysis)
+		{
+			experimental::IRGenerator generator(
+				m_evmVersion,
+				m_eofVersion,
+				m_revertStrings,
+				sourceIndices(),
+				m_debugInfoSelection,
+				this,
+				*m_experimentalAnalysis
+			);
+			compiledContract.yulIR = generator.run(
+				_contract,
+				{}, // TODO: createCBORMetadata(compiledContract, /* _forIR */ true),
+				otherYulSources
+			);
+		}
+		else
+		{
+			IRGenerator generator(
+				m_evmVersion,
+				m_eofVersion,
+				m_revertStrings,
+				sourceIndices(),
+				m_debugInfoSelection,
+				this,
+				m_optimiserSettings
+			);
+			compiledContract.yulIR = generator.run(
+				_contract,
+				createCBORMetadata(compiledContract, /* _forIR */ true),
+				otherYulSources
+			);
+		}
 	}
 
-	yul::YulStack stack(
+	if (_optimize)
+		optimizeIR(_contract);
+}
+
+void CompilerStack::optimizeIR(ContractDefinition const& _contract, size_t _concurrency)
+{
+	solAssert(m_stackState >= AnalysisSuccessful, "");
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	solAssert(!compiledContract.yulIR.empty(), "");
+	if (compiledContract.yulIRStack)
+		return;
+
+	auto stack = std::make_shared<yul::YulStack>(
 		m_evmVersion,
 		m_eofVersion,
 		yul::YulStack::Language::StrictAssembly,
 		m_optimiserSettings,
 		m_debugInfoSelection
 	);
-	bool yulAnalysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIR);
+	bool yulAnalysisSuccessful = false;
+	{
+		util::ScopedPhaseMeasurement measurement(phases(compiledContract), "irParsing");
+		yulAnalysisSuccessful = stack->parseAndAnalyze("", compiledContract.yulIR);
+	}
 	solAssert(
 		yulAnalysisSuccessful,
 		compiledContract.yulIR + "\n\n"
 		"Invalid IR generated:\n" +
-		langutil::SourceReferenceFormatter::formatErrorInformation(stack.errors(), stack) + "\n"
+		langutil::SourceReferenceFormatter::formatErrorInformation(stack->errors(), *stack) + "\n"
 	);
 
-	compiledContract.yulIRAst = stack.astJson();
-	stack.optimize();
-	compiledContract.yulIROptimized = stack.print(this);
-	compiledContract.yulIROptimizedAst = stack.astJson();
+	// The IR of the contracts created by this contract is embedded into its IR. Instead of
+	// optimizing and compiling it again, their optimized objects and assemblies are reused.
+	// Without the optimizer, the code of an object is only optimized if the whole object tree
+	// does not contain msize, so it would not be the same.
+	if (m_viaIR && m_generateEvmBytecode && m_optimiserSettings.runYulOptimiser)
+		for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+		{
+			Contract const& compiledDependency = m_contracts.at(dependency->fullyQualifiedName());
+			if (!compiledDependency.yulIRStack)
+				continue;
+			generateEVMFromIR(*dependency);
+			if (compiledDependency.evmAssembly)
+				stack->reuseCompiledObject(*compiledDependency.yulIRStack, compiledDependency.evmAssembly);
+		}
+
+	{
+		util::ScopedPhaseMeasurement measurement(phases(compiledContract), "yulOptimization");
+		stack->optimize(_concurrency);
+	}
+	compiledContract.yulIRStack = std::move(stack);
 }
 
-void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
+void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract, size_t _concurrency)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1493,27 +1962,377 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
+	solAssert(compiledContract.yulIRStack, "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::YulStack stack(
-		m_evmVersion,
-		m_eofVersion,
-		yul::YulStack::Language::StrictAssembly,
-		m_optimiserSettings,
-		m_debugInfoSelection
-	);
-	bool analysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	solAssert(analysisSuccessful);
-
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
-
+	// The optimized object is analyzed already and is used directly, without printing
+	// and re-parsing it. Only sub-object IDs are assigned to it during code generation.
 	std::string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
-	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) =
+		compiledContract.yulIRStack->assembleEVMWithDeployed(deployedName, _concurrency, phases(compiledContract));
+	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly, _concurrency);
+}
+
+void CompilerStack::compileViaIRConcurrently(std::vector<ContractDefinition const*> const& _contracts)
+{
+	solAssert(m_viaIR, "");
+	if (!m_generateEvmBytecode && !m_generateIR)
+		return;
+
+	// IR generation accesses the type system and the lazily computed AST annotations,
+	// neither of which is thread-safe. Dependencies are embedded as unoptimised IR,
+	// so everything after this point is independent between contracts.
+	for (ContractDefinition const* contract: _contracts)
+		generateIR(*contract, /* _optimize */ false);
+
+	// Contracts reuse the optimized objects and assemblies of the contracts they create
+	// (see optimizeIR), so every contract is processed after all contracts it depends on.
+	// Contracts of the same height in the dependency graph are processed concurrently.
+	std::vector<std::vector<ContractDefinition const*>> contractsByHeight;
+	std::map<ContractDefinition const*, size_t> heights;
+	std::function<size_t(ContractDefinition const&)> height = [&](ContractDefinition const& _contract) -> size_t {
+		if (auto it = heights.find(&_contract); it != heights.end())
+			return it->second;
+		size_t contractHeight = 0;
+		for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+			contractHeight = std::max(contractHeight, height(*dependency) + 1);
+		return heights[&_contract] = contractHeight;
+	};
+	for (auto const& [name, contract]: m_contracts)
+		if (!contract.yulIR.empty() && !contract.yulIRStack && !contract.restoredFromCache)
+		{
+			size_t contractHeight = height(*contract.contract);
+			if (contractsByHeight.size() <= contractHeight)
+				contractsByHeight.resize(contractHeight + 1);
+			contractsByHeight[contractHeight].push_back(contract.contract);
+		}
+
+	for (std::vector<ContractDefinition const*> const& contracts: contractsByHeight)
+	{
+		// Threads not needed for separate contracts are used to optimise functions
+		// and to optimise and assemble sub-assemblies concurrently.
+		size_t const contractConcurrency = std::max<size_t>(
+			1,
+			util::effectiveConcurrency(m_parallelism) / std::max<size_t>(1, contracts.size())
+		);
+		util::parallelFor(m_parallelism, contracts.size(), [&](size_t _index) {
+			optimizeIR(*contracts[_index], contractConcurrency);
+			if (m_generateEvmBytecode)
+				generateEVMFromIR(*contracts[_index], contractConcurrency);
+		});
+	}
+
+	if (!m_generateEvmBytecode)
+		return;
+
+	for (ContractDefinition const* contract: _contracts)
+		checkCodeSizeLimits(*contract);
+}
+
+Json CompilerStack::cacheSettings() const
+{
+	Json settings;
+	settings["evmVersion"] = m_evmVersion.name();
+	if (m_eofVersion.has_value())
+		settings["eofVersion"] = *m_eofVersion;
+	settings["viaIR"] = m_viaIR;
+	settings["optimizer"] = {
+		{"orderLiterals", m_optimiserSettings.runOrderLiterals},
+		{"inliner", m_optimiserSettings.runInliner},
+		{"jumpdestRemover", m_optimiserSettings.runJumpdestRemover},
+		{"peephole", m_optimiserSettings.runPeephole},
+		{"deduplicate", m_optimiserSettings.runDeduplicate},
+		{"cse", m_optimiserSettings.runCSE},
+		{"constantOptimizer", m_optimiserSettings.runConstantOptimiser},
+		{"simpleCounterForLoopUncheckedIncrement", m_optimiserSettings.simpleCounterForLoopUncheckedIncrement},
+		{"stackAllocation", m_optimiserSettings.optimizeStackAllocation},
+		{"yul", m_optimiserSettings.runYulOptimiser},
+		{"optimizerSteps", m_optimiserSettings.yulOptimiserSteps + ":" + m_optimiserSettings.yulOptimiserCleanupSteps},
+		{"runs", m_optimiserSettings.expectedExecutionsPerDeployment},
+	};
+	settings["revertStrings"] = revertStringsToString(m_revertStrings);
+	settings["debugInfo"] = util::toString(m_debugInfoSelection);
+	settings["metadata"] = {
+		{"format", static_cast<int>(m_metadataFormat)},
+		{"hash", static_cast<int>(m_metadataHash)},
+		{"useLiteralContent", m_metadataLiteralSources},
+	};
+	settings["remappings"] = Json::array();
+	for (auto const& remapping: m_importRemapper.remappings())
+		settings["remappings"].emplace_back(remapping.context + ":" + remapping.prefix + "=" + remapping.target);
+	settings["libraries"] = Json::object();
+	for (auto const& [name, address]: m_libraries)
+		settings["libraries"][name] = address.hex();
+	settings["outputs"] = {{"evm", m_generateEvmBytecode}, {"ir", m_generateIR}};
+	return settings;
+}
+
+std::optional<h256> CompilerStack::cacheKey(std::string const& _sourceName, Json const& _settings) const
+{
+	std::map<std::string, unsigned> const indices = sourceIndices();
+
+	Json key;
+	key["compiler"] = VersionString;
+	key["settings"] = _settings;
+	key["sourceUnit"] = _sourceName;
+	// The index of the generated utility sources depends on the number of sources.
+	key["sourceCount"] = m_sources.size();
+	key["sources"] = Json::object();
+
+	// AST IDs and source indices end up in the generated code, so they are part of the key
+	// in addition to the contents of the imported source units.
+	std::vector<std::string> toVisit{_sourceName};
+	while (!toVisit.empty())
+	{
+		std::string const name = std::move(toVisit.back());
+		toVisit.pop_back();
+		if (key["sources"].contains(name))
+			continue;
+
+		auto source = m_sources.find(name);
+		if (source == m_sources.end() || !source->second.ast)
+			return std::nullopt;
+		key["sources"][name] = {
+			{"keccak256", source->second.keccak256().hex()},
+			{"astID", source->second.ast->id()},
+			{"index", indices.at(name)},
+		};
+		for (ImportDirective const* import: ASTNode::filteredNodes<ImportDirective>(source->second.ast->nodes()))
+			toVisit.push_back(*import->annotation().absolutePath);
+	}
+
+	key["requestedContracts"] = Json::array();
+	for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(m_sources.at(_sourceName).ast->nodes()))
+		if (isRequestedContract(_sourceName, contract->name()))
+			key["requestedContracts"].emplace_back(contract->name());
+
+	return util::keccak256(util::jsonCompactPrint(key));
+}
+
+void CompilerStack::loadCacheEntries()
+{
+	solAssert(m_stackState == ParsedAndImported);
+	if (
+		!m_compilationCache ||
+		m_stopAfter != CompilationSuccessful ||
+		m_compilationSourceType != CompilationSourceType::Solidity ||
+		m_modelCheckerSettings.engine.any() ||
+		// The profile of the Yul optimizer is only available if the contracts are optimized again.
+		m_optimiserSettings.profileYulOptimiser
+	)
+		return;
+
+	Json const settings = cacheSettings();
+	std::map<std::string, h256> keys;
+	for (auto const& [name, source]: m_sources)
+		if (std::optional<h256> key = cacheKey(name, settings))
+			keys[name] = *key;
+		else
+			// Unresolved imports are reported during analysis.
+			return;
+
+	m_cacheKeys = std::move(keys);
+	for (auto const& [name, key]: m_cacheKeys)
+		if (std::optional<Json> entry = m_compilationCache->load(key, [&](Json const& _entry) { validateCacheEntry(name, _entry); }))
+			m_cacheEntries[name] = std::move(*entry);
+}
+
+void CompilerStack::validateCacheEntry(std::string const& _sourceName, Json const& _entry) const
+{
+	for (char const* errorKind: {"analysisErrors", "compilationErrors"})
+		for (Json const& error: _entry.at(errorKind))
+			CompilationCache::errorFromJson(error);
+
+	Json const& contracts = _entry.at("contracts");
+	for (ASTPointer<ASTNode> const& node: m_sources.at(_sourceName).ast->nodes())
+	{
+		auto const* contractDefinition = dynamic_cast<ContractDefinition const*>(node.get());
+		if (!contractDefinition)
+			continue;
+
+		Json const& contract = contracts.at(contractDefinition->name());
+		for (char const* field: {"abi", "userdoc", "devdoc", "storageLayout", "interfaceSymbols"})
+			contract.at(field);
+		contract.at("metadata").get<std::string>();
+		if (!isRequestedContract(_sourceName, contractDefinition->name()))
+			continue;
+
+		Json const& code = contract.at("code");
+		if (code.contains("ir"))
+		{
+			code["ir"].get<std::string>();
+			code.at("irOptimized").get<std::string>();
+		}
+		for (char const* object: {"bytecode", "deployedBytecode"})
+			CompilationCache::objectFromJson(code.at(object));
+		for (char const* sourceMap: {"sourceMap", "deployedSourceMap"})
+			if (!code.at(sourceMap).is_null())
+				code[sourceMap].get<std::string>();
+		for (char const* field: {"generatedSources", "deployedGeneratedSources", "assemblyJSON"})
+			code.at(field);
+	}
+}
+
+bool CompilerStack::restoreFromCache()
+{
+	if (m_cacheKeys.empty() || m_cacheEntries.size() != m_cacheKeys.size())
+		return false;
+
+	for (char const* errorKind: {"analysisErrors", "compilationErrors"})
+		for (auto const& [name, entry]: m_cacheEntries)
+			for (Json const& error: entry.at(errorKind))
+				m_errorReporter.append({CompilationCache::errorFromJson(error)});
+
+	// The scopes of the contracts are only set during analysis, so the source units are looked up
+	// by name here.
+	for (auto const& [sourceName, source]: m_sources)
+		for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source.ast->nodes()))
+			restoreContractFromCache(
+				m_contracts.at(sourceName + ":" + contract->name()),
+				sourceName,
+				isRequestedContract(sourceName, contract->name())
+			);
+
+	m_restoredFromCache = true;
+	m_stackState = CompilationSuccessful;
+	this->link();
+	return true;
+}
+
+void CompilerStack::restoreContractFromCache(Contract& _contract, std::string const& _sourceName, bool _withCode)
+{
+	Json const& entry = m_cacheEntries.at(_sourceName).at("contracts").at(_contract.contract->name());
+	_contract.abi.init([&]{ return entry.at("abi"); });
+	_contract.metadata.init([&]{ return entry.at("metadata").get<std::string>(); });
+	_contract.userDocumentation.init([&]{ return entry.at("userdoc"); });
+	_contract.devDocumentation.init([&]{ return entry.at("devdoc"); });
+	_contract.storageLayout.init([&]{ return entry.at("storageLayout"); });
+	_contract.interfaceSymbols.init([&]{ return entry.at("interfaceSymbols"); });
+	if (!_withCode)
+		return;
+
+	Json const& code = entry.at("code");
+	_contract.restoredFromCache = true;
+	if (code.contains("ir"))
+	{
+		_contract.yulIR = code["ir"].get<std::string>();
+		_contract.yulIROptimized.init([&]{ return code.at("irOptimized").get<std::string>(); });
+	}
+	_contract.object = CompilationCache::objectFromJson(code.at("bytecode"));
+	_contract.runtimeObject = CompilationCache::objectFromJson(code.at("deployedBytecode"));
+	if (code.at("sourceMap").is_string())
+		_contract.sourceMapping.emplace(code["sourceMap"].get<std::string>());
+	if (code.at("deployedSourceMap").is_string())
+		_contract.runtimeSourceMapping.emplace(code["deployedSourceMap"].get<std::string>());
+	_contract.generatedSources.init([&]{ return code.at("generatedSources"); });
+	_contract.runtimeGeneratedSources.init([&]{ return code.at("deployedGeneratedSources"); });
+	_contract.assemblyJSON.init([&]{ return code.at("assemblyJSON"); });
+}
+
+std::set<ContractDefinition const*> CompilerStack::contractsToRestoreFromCache(
+	std::vector<ContractDefinition const*> const& _requestedContracts
+) const
+{
+	auto const hasCachedCode = [&](ContractDefinition const* _contract) {
+		auto entry = m_cacheEntries.find(_contract->sourceUnitName());
+		return
+			entry != m_cacheEntries.end() &&
+			entry->second.at("contracts").contains(_contract->name()) &&
+			entry->second["contracts"][_contract->name()].contains("code");
+	};
+
+	std::set<ContractDefinition const*> compiledContracts;
+	std::vector<ContractDefinition const*> toVisit;
+	for (ContractDefinition const* contract: _requestedContracts)
+		if (!hasCachedCode(contract))
+			toVisit.push_back(contract);
+	while (!toVisit.empty())
+	{
+		ContractDefinition const* contract = toVisit.back();
+		toVisit.pop_back();
+		if (compiledContracts.insert(contract).second)
+			for (auto const& [dependency, referencee]: contract->annotation().contractDependencies)
+				toVisit.push_back(dependency);
+	}
+
+	std::set<ContractDefinition const*> restoredContracts;
+	for (ContractDefinition const* contract: _requestedContracts)
+		if (!compiledContracts.count(contract))
+			restoredContracts.insert(contract);
+	return restoredContracts;
+}
+
+void CompilerStack::storeInCache(size_t _analysisErrorsStart, size_t _compilationErrorsStart) const
+{
+	solAssert(m_stackState == CompilationSuccessful);
+	if (
+		m_cacheEntries.size() == m_cacheKeys.size() ||
+		m_experimentalAnalysis ||
+		m_modelCheckerSettings.engine.any() ||
+		!m_unhandledSMTLib2Queries.empty()
+	)
+		return;
+
+	std::map<std::string, Json> entries;
+	for (auto const& [name, key]: m_cacheKeys)
+		if (!m_cacheEntries.count(name))
+			entries[name] = {
+				{"analysisErrors", Json::array()},
+				{"compilationErrors", Json::array()},
+				{"contracts", Json::object()},
+			};
+
+	ErrorList const& errors = m_errorReporter.errors();
+	for (size_t index = _analysisErrorsStart; index < errors.size(); ++index)
+	{
+		SourceLocation const* location = errors[index]->sourceLocation();
+		// Nothing is stored if an error cannot be attributed to a source unit.
+		if (!location || !location->sourceName || !m_cacheKeys.count(*location->sourceName))
+			return;
+		auto entry = entries.find(*location->sourceName);
+		if (entry != entries.end())
+			entry->second[index < _compilationErrorsStart ? "analysisErrors" : "compilationErrors"].emplace_back(
+				CompilationCache::errorToJson(*errors[index])
+			);
+	}
+
+	for (auto const& [name, contract]: m_contracts)
+	{
+		auto entry = entries.find(contract.contract->sourceUnitName());
+		if (entry == entries.end())
+			continue;
+
+		Json& cachedContract = entry->second["contracts"][contract.contract->name()];
+		cachedContract["abi"] = contractABI(contract);
+		cachedContract["metadata"] = metadata(contract);
+		cachedContract["userdoc"] = natspecUser(contract);
+		cachedContract["devdoc"] = natspecDev(contract);
+		cachedContract["storageLayout"] = storageLayout(contract);
+		cachedContract["interfaceSymbols"] = interfaceSymbols(name);
+		if (!isRequestedContract(*contract.contract))
+			continue;
+
+		Json& code = cachedContract["code"];
+		if (m_generateIR)
+		{
+			code["ir"] = contract.yulIR;
+			code["irOptimized"] = yulIROptimized(name);
+		}
+		code["bytecode"] = CompilationCache::objectToJson(contract.object);
+		code["deployedBytecode"] = CompilationCache::objectToJson(contract.runtimeObject);
+		std::string const* sourceMap = sourceMapping(name);
+		code["sourceMap"] = sourceMap ? Json(*sourceMap) : Json();
+		std::string const* deployedSourceMap = runtimeSourceMapping(name);
+		code["deployedSourceMap"] = deployedSourceMap ? Json(*deployedSourceMap) : Json();
+		code["generatedSources"] = generatedSources(name);
+		code["deployedGeneratedSources"] = generatedSources(name, true);
+		code["assemblyJSON"] = assemblyJSON(name);
+	}
+
+	for (auto const& [name, entry]: entries)
+		m_compilationCache->store(m_cacheKeys.at(name), entry);
 }
 
 CompilerStack::Contract const& CompilerStack::contract(std::string const& _contractName) const
@@ -1606,6 +2425,8 @@ std::string CompilerStack::createMetadata(Contract const& _contract, bool _forIR
 	OptimiserSettings settingsWithoutRuns = m_optimiserSettings;
 	// reset to default
 	settingsWithoutRuns.expectedExecutionsPerDeployment = OptimiserSettings::minimal().expectedExecutionsPerDeployment;
+	// Profiling the Yul optimizer does not change the output, so it is not part of the metadata.
+	settingsWithoutRuns.profileYulOptimiser = false;
 	if (settingsWithoutRuns == OptimiserSettings::minimal())
 		meta["settings"]["optimizer"]["enabled"] = false;
 	else if (settingsWithoutRuns == OptimiserSettings::standard())
@@ -1817,6 +2638,7 @@ Json gasToJson(GasEstimator::GasConsumption const& _gas)
 Json CompilerStack::gasEstimates(std::string const& _contractName) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
+	solAssert(!contract(_contractName).restoredFromCache, "Gas estimates are not stored in the compilation cache.");
 	solUnimplementedAssert(!isExperimentalSolidity());
 
 	if (!assemblyItems(_contractName) && !runtimeAssemblyItems(_contractName))
@@ -1891,6 +2713,52 @@ Json CompilerStack::gasEstimates(std::string const& _contractName) const
 	return output;
 }
 
+Json CompilerStack::timings() const
+{
+	auto phasesToJson = [](std::vector<util::PhaseUsage> const& _phases, bool _withAllocatedBytes) {
+		Json result = Json::array();
+		for (util::PhaseUsage const& usage: _phases)
+		{
+			Json phase;
+			phase["phase"] = usage.phase;
+			phase["durationMicroseconds"] = usage.durationInMicroseconds;
+			if (_withAllocatedBytes && usage.allocatedBytes)
+				phase["allocatedBytes"] = *usage.allocatedBytes;
+			result.emplace_back(std::move(phase));
+		}
+		return result;
+	};
+
+	Json output;
+	output["phases"] = phasesToJson(m_phases, true);
+	// The heap is measured for the whole process, so the figures of contracts compiled
+	// concurrently would include the memory taken by the others.
+	bool const contractsCompiledSerially = util::effectiveConcurrency(m_parallelism) == 1;
+	output["contracts"] = Json::object();
+	for (auto const& pair: m_contracts)
+	{
+		Contract const& contract = pair.second;
+		if (!contract.phases.empty())
+			output["contracts"][contract.contract->sourceUnitName()][contract.contract->name()] =
+				phasesToJson(contract.phases, contractsCompiledSerially);
+	}
+	if (std::optional<size_t> peakResidentSetSize = util::peakResidentSetSize())
+		output["peakResidentSetSize"] = *peakResidentSetSize;
+	// The counters of the caches are cumulative, so only the lookups since the start of the compilation are reported.
+	output["stackLayoutCache"] = stackLayoutCacheStatistics();
+	for (auto& [cache, statistics]: output["stackLayoutCache"].items())
+		for (auto& [counter, value]: statistics.items())
+		{
+			size_t const atStart = m_stackLayoutCacheStatisticsAtStart.contains(cache) ?
+				m_stackLayoutCacheStatisticsAtStart[cache][counter].get<size_t>() :
+				0;
+			// Otherwise the caches were cleared during the compilation.
+			if (value.get<size_t>() >= atStart)
+				value = value.get<size_t>() - atStart;
+		}
+	return output;
+}
+
 bool CompilerStack::isExperimentalSolidity() const
 {
 	return
@@ -48,6 +48,7 @@
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/ResourceUsage.h>
 
 #include <functional>
 #include <memory>
@@ -69,11 +70,17 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace solidity::yul
+{
+class YulStack;
+}
+
 namespace solidity::frontend
 {
 
 // forward declarations
 class ASTNode;
+class CompilationCache;
 class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
@@ -139,12 +146,34 @@ public:
 	/// @returns the current state.
 	State state() const { return m_stackState; }
 
+	/// @returns true if analysis was skipped because the artifacts of all source units
+	/// were restored from the compilation cache.
+	bool restoredFromCache() const { return m_restoredFromCache; }
+
+	/// @returns the names of the contracts whose code generation artifacts were restored from
+	/// the compilation cache instead of being generated.
+	std::vector<std::string> contractsRestoredFromCache() const;
+
 	virtual bool compilationSuccessful() const override { return m_stackState >= CompilationSuccessful; }
 
 	/// Resets the compiler to an empty state. Unless @a _keepSettings is set to true,
 	/// all settings are reset as well.
+	/// If incremental analysis is enabled, the analysed source units are kept for reuse.
 	void reset(bool _keepSettings = false);
 
+	/// Enables or disables incremental analysis, which is meant for tools that analyse the same
+	/// sources again after small changes. If enabled, reset() keeps the analysed source units and
+	/// the next parsing step only processes the sources that changed since then, along with all
+	/// source units that import them directly or indirectly. All other source units keep their AST,
+	/// annotations and reported errors and are not analysed again.
+	/// Analysis results are only reused if compilation stops after analysis and the settings
+	/// relevant to analysis did not change. AST IDs may differ from those of a full analysis.
+	/// This setting is not affected by reset().
+	void enableIncrementalAnalysis(bool _enabled = true);
+
+	/// @returns the names of the source units whose analysis results were reused by incremental analysis.
+	std::set<std::string> reusedSources() const;
+
 	/// Sets path remappings.
 	/// Must be set before parsing.
 	void setRemappings(std::vector<ImportRemapper::Remapping> _remappings);
@@ -173,6 +202,20 @@ public:
 	/// Must be set before parsing.
 	void setEVMVersion(langutil::EVMVersion _version = langutil::EVMVersion{});
 
+	/// Sets the maximum number of threads used to optimise and assemble the IR of different
+	/// contracts concurrently. Zero selects the number of hardware threads.
+	/// Only affects the via-IR pipeline; the output does not depend on this setting.
+	void setParallelism(size_t _parallelism);
+
+	/// Sets the cache used to store the artifacts of each source unit after a successful compilation.
+	/// Code generation is skipped for requested contracts whose artifacts are found in the cache and,
+	/// if this is the case for all source units, analysis is skipped as well.
+	/// Only the ABI, metadata, documentation, storage layout, interface symbols, the (optimized) IR,
+	/// the assembly JSON and the bytecode objects with their source mappings are restored from the
+	/// cache, so it must not be set if any other output is requested after compilation.
+	/// Must be set before parsing.
+	void setCompilationCache(std::shared_ptr<CompilationCache> _cache);
+
 	/// Set the EOF version used before running compile.
 	/// If set to std::nullopt (the default), legacy non-EOF bytecode is generated.
 	void setEOFVersion(std::optional<uint8_t> version);
@@ -195,6 +238,10 @@ public:
 	/// Enable generation of Yul IR code.
 	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
 
+	/// Enable measuring the wall time and heap memory taken by the phases of the compilation
+	/// (see timings). Must be set before parsing.
+	void enableTimings(bool _enable = true) { m_measureTimings = _enable; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -275,15 +322,22 @@ public:
 	/// @returns the IR representation of a contract.
 	std::string const& yulIR(std::string const& _contractName) const;
 
-	/// @returns the IR representation of a contract AST in format.
+	/// @returns the IR representation of a contract AST in JSON format.
+	/// The AST is created on first access by parsing the IR again.
 	Json const& yulIRAst(std::string const& _contractName) const;
 
 	/// @returns the optimized IR representation of a contract.
+	/// The IR is printed from the optimized object on first access.
 	std::string const& yulIROptimized(std::string const& _contractName) const;
 
 	/// @returns the optimized IR representation of a contract AST in JSON format.
 	Json const& yulIROptimizedAst(std::string const& _contractName) const;
 
+	/// @returns the work done by the Yul optimizer on the IR of a contract if the optimiser
+	/// settings requested it (see yul::YulStack::optimiserProfile). Does not cover the objects
+	/// of created contracts, which are optimized with those contracts.
+	Json yulOptimizerProfile(std::string const& _contractName) const;
+
 	/// @returns the assembled object for a contract.
 	virtual evmasm::LinkerObject const& object(std::string const& _contractName) const override;
 
@@ -351,6 +405,11 @@ public:
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
 	Json gasEstimates(std::string const& _contractName) const;
 
+	/// @returns the wall time and heap memory taken by the phases of parsing and analysis and by
+	/// the phases of code generation of every contract, in the order they ran, as well as the peak
+	/// resident set size of the process. Only contains phases that ran while timings were enabled.
+	Json timings() const;
+
 	/// Changes the format of the metadata appended at the end of the bytecode.
 	void setMetadataFormat(MetadataFormat _metadataFormat) { m_metadataFormat = _metadataFormat; }
 
@@ -388,20 +447,64 @@ private:
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Yul IR code.
-		std::string yulIROptimized; ///< Optimized Yul IR code.
-		Json yulIRAst; ///< JSON AST of Yul IR code.
-		Json yulIROptimizedAst; ///< JSON AST of optimized Yul IR code.
+		/// Parsed, analyzed and optimized Yul IR code. EVM code is generated directly from
+		/// this object, so the textual representations below are only produced on request.
+		std::shared_ptr<yul::YulStack> yulIRStack;
+		util::LazyInit<std::string const> yulIROptimized; ///< Optimized Yul IR code.
+		util::LazyInit<Json const> yulIRAst; ///< JSON AST of Yul IR code.
+		util::LazyInit<Json const> yulIROptimizedAst; ///< JSON AST of optimized Yul IR code.
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
 		util::LazyInit<Json const> abi;
 		util::LazyInit<Json const> storageLayout;
 		util::LazyInit<Json const> userDocumentation;
 		util::LazyInit<Json const> devDocumentation;
+		util::LazyInit<Json const> interfaceSymbols;
 		util::LazyInit<Json const> generatedSources;
 		util::LazyInit<Json const> runtimeGeneratedSources;
+		util::LazyInit<Json const> assemblyJSON;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		/// True if the code generation artifacts were restored from the compilation cache
+		/// instead of being generated. There is no assembly or Yul object in that case.
+		bool restoredFromCache = false;
+		/// Phases of code generation, if timings are enabled.
+		std::vector<util::PhaseUsage> phases;
 	};
 
+	/// Analysed source units kept by reset() if incremental analysis is enabled.
+	struct RetainedAnalysis
+	{
+		std::map<std::string, Source> sources;
+		/// Errors reported for each retained source unit.
+		std::map<std::string, langutil::ErrorList> errors;
+		/// The global context the annotations of the retained source units refer to.
+		std::shared_ptr<GlobalContext> globalContext;
+		/// Settings that influence analysis, as used for the retained source units.
+		langutil::EVMVersion evmVersion;
+		std::optional<uint8_t> eofVersion;
+		bool runYulOptimiser = false;
+		std::vector<ImportRemapper::Remapping> remappings;
+		/// Maximal AST ID used by the retained source units.
+		int64_t maxAstId = 0;
+		/// The types of replaced source units are only freed when the type provider is reset.
+		/// To bound memory usage, everything is analysed again once there are more types than this.
+		size_t maxTypeCount = 0;
+	};
+
+	/// Moves the source units that were analysed successfully or reused into m_retainedAnalysis.
+	void retainAnalysis();
+
+	/// Moves the retained source units that neither changed nor import a changed source unit
+	/// into m_sources and discards all other retained source units.
+	void reuseRetainedAnalysis();
+
+	/// Discards the retained source units and resets the type provider.
+	void discardRetainedAnalysis();
+
+	/// Removes errors that were reported again for reused source units during analysis
+	/// from the error list.
+	void removeDuplicateErrorsOfReusedSources();
+
 	void createAndAssignCallGraphs();
 	void findAndReportCyclicContractDependencies();
 
@@ -423,6 +526,9 @@ private:
 
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
+	/// @returns true if the contract @a _contractName of the source unit @a _sourceName is requested
+	/// to be compiled. Unlike the overload above, this one can be used before analysis.
+	bool isRequestedContract(std::string const& _sourceName, std::string const& _contractName) const;
 
 	/// Perform the analysis steps of legacy language mode.
 	/// @returns false on error.
@@ -434,12 +540,17 @@ private:
 
 	/// Assembles the contract.
 	/// This function should only be internally called by compileContract and generateEVMFromIR.
+	/// @param _concurrency number of threads used to assemble different sub-assemblies.
 	void assembleYul(
 		ContractDefinition const& _contract,
 		std::shared_ptr<evmasm::Assembly> _assembly,
-		std::shared_ptr<evmasm::Assembly> _runtimeAssembly
+		std::shared_ptr<evmasm::Assembly> _runtimeAssembly,
+		size_t _concurrency = 1
 	);
 
+	/// Warns if the assembled bytecode of the contract exceeds the limits of EIP-170 or EIP-3860.
+	void checkCodeSizeLimits(ContractDefinition const& _contract);
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
@@ -450,11 +561,69 @@ private:
 
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
-	void generateIR(ContractDefinition const& _contract);
+	/// @param _optimize if false, only the unoptimised IR is generated and optimizeIR has to
+	///                  be called separately for the contract and all its dependencies.
+	void generateIR(ContractDefinition const& _contract, bool _optimize = true);
+
+	/// Parses, analyses and optimises the Yul IR of a single contract and stores the result
+	/// for use by generateEVMFromIR. Depends on output generated by generateIR. Only touches the state of the given contract
+	/// and can be run concurrently for different contracts, once generateEVMFromIR was run for
+	/// the contracts it depends on. Otherwise it runs generateEVMFromIR for them itself.
+	/// @param _concurrency number of threads the optimiser may use for different functions
+	///                     of the contract (see yul::YulStack::optimize).
+	void optimizeIR(ContractDefinition const& _contract, size_t _concurrency = 1);
 
 	/// Generate EVM representation for a single contract.
-	/// Depends on output generated by generateIR.
-	void generateEVMFromIR(ContractDefinition const& _contract);
+	/// Depends on output generated by optimizeIR. Only touches the state of the given contract
+	/// and can be run concurrently for different contracts. Does not check the code size limits.
+	/// @param _concurrency number of threads used to optimise and assemble different sub-assemblies
+	///                     of the contract (see yul::YulStack::assembleEVMWithDeployed).
+	void generateEVMFromIR(ContractDefinition const& _contract, size_t _concurrency = 1);
+
+	/// Compiles the given contracts via the IR pipeline, optimising and assembling
+	/// the IR of different contracts concurrently.
+	/// IR generation itself stays serial since it accesses the shared type system.
+	void compileViaIRConcurrently(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// @returns everything apart from the sources that influences the artifacts stored in the
+	/// compilation cache.
+	Json cacheSettings() const;
+
+	/// @returns the key of the compilation cache entry of the source unit @a _sourceName. The key covers
+	/// the contents of all source units it imports (directly or indirectly), their AST IDs and
+	/// source indices, the compiler version, @a _settings and the requested contracts of the source unit.
+	/// @returns nullopt if an import of the source unit could not be resolved.
+	std::optional<util::h256> cacheKey(std::string const& _sourceName, Json const& _settings) const;
+
+	/// Computes the cache keys of all source units and loads the available entries.
+	/// Does nothing unless a compilation cache is set and the compilation can be cached.
+	void loadCacheEntries();
+
+	/// Decodes everything restoreFromCache and restoreContractFromCache read from the cache entry
+	/// of the source unit @a _sourceName without modifying the state.
+	/// Throws if the entry does not have the shape written by storeInCache.
+	void validateCacheEntry(std::string const& _sourceName, Json const& _entry) const;
+
+	/// Restores all contracts and the errors reported during analysis and compilation from
+	/// the compilation cache and skips analysis and code generation.
+	/// @returns false, without modifying the state, if an entry is missing for any source unit.
+	bool restoreFromCache();
+
+	/// Restores the artifacts of @a _contract from the cache entry of its source unit @a _sourceName.
+	/// Code generation artifacts are only restored if @a _withCode is true.
+	void restoreContractFromCache(Contract& _contract, std::string const& _sourceName, bool _withCode);
+
+	/// @returns the requested contracts whose code generation artifacts can be restored from
+	/// the compilation cache. This excludes dependencies of contracts that have to be compiled,
+	/// since their code generation needs the dependencies' intermediate results.
+	std::set<ContractDefinition const*> contractsToRestoreFromCache(
+		std::vector<ContractDefinition const*> const& _requestedContracts
+	) const;
+
+	/// Stores the artifacts of all source units that were not found in the compilation cache.
+	/// @param _analysisErrorsStart number of errors reported before analysis.
+	/// @param _compilationErrorsStart number of errors reported before code generation.
+	void storeInCache(size_t _analysisErrorsStart, size_t _compilationErrorsStart) const;
 
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
@@ -496,6 +665,9 @@ private:
 	/// This will generate the metadata and store it in the Contract object if it is not present yet.
 	std::string const& metadata(Contract const& _contract) const;
 
+	/// @returns the interface symbols of the contract as described in interfaceSymbols().
+	Json generateInterfaceSymbols(std::string const& _contractName) const;
+
 	/// @returns the offset of the entry point of the given function into the list of assembly items
 	/// or zero if it is not found or does not exist.
 	size_t functionEntryPoint(
@@ -505,6 +677,12 @@ private:
 
 	void reportUnimplementedFeatureError(langutil::UnimplementedFeatureError const& _error);
 
+	/// @returns the list to record the phases of parsing and analysis in or null if timings are disabled.
+	std::vector<util::PhaseUsage>* phases() { return m_measureTimings ? &m_phases : nullptr; }
+	/// @returns the list to record the phases of code generation of @a _contract in or null
+	/// if timings are disabled.
+	std::vector<util::PhaseUsage>* phases(Contract& _contract) { return m_measureTimings ? &_contract.phases : nullptr; }
+
 	ReadCallback::Callback m_readFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
@@ -512,10 +690,23 @@ private:
 	bool m_viaIR = false;
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
+	size_t m_parallelism = 1;
+	std::shared_ptr<CompilationCache> m_compilationCache;
+	/// Compilation cache keys of all source units, if the compilation can be cached.
+	std::map<std::string, util::h256> m_cacheKeys;
+	/// Compilation cache entries found for source units.
+	std::map<std::string, Json> m_cacheEntries;
+	bool m_restoredFromCache = false;
 	ModelCheckerSettings m_modelCheckerSettings;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
+	bool m_measureTimings = false;
+	/// Phases of parsing and analysis, if timings are enabled.
+	std::vector<util::PhaseUsage> m_phases;
+	/// Statistics of the process-wide stack layout caches at the start of the last compilation,
+	/// if timings are enabled.
+	Json m_stackLayoutCacheStatisticsAtStart;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
@@ -524,6 +715,12 @@ private:
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
+	/// Source units in m_sourceOrder that are analysed, i.e. all that are not reused.
+	std::vector<Source const*> m_sourcesToAnalyze;
+	bool m_incrementalAnalysis = false;
+	RetainedAnalysis m_retainedAnalysis;
+	/// Source units whose analysis results were reused, with the errors reported for them.
+	std::map<std::string, langutil::ErrorList> m_reusedSources;
 	std::map<std::string const, Contract> m_contracts;
 
 	langutil::ErrorList m_errorList;
@@ -125,7 +125,8 @@ struct OptimiserSettings
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			profileYulOptimiser == _other.profileYulOptimiser;
 	}
 
 	bool operator!=(OptimiserSettings const& _other) const
@@ -167,6 +168,9 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Record the steps run by the Yul optimiser together with their duration and effect on the code.
+	/// Does not influence the generated code.
+	bool profileYulOptimiser = false;
 };
 
 }
@@ -19,8 +19,10 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Common.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/TemporaryDirectory.h>
 
@@ -30,12 +32,18 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/process.hpp>
 
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
 namespace solidity::frontend
 {
 
 void SMTSolverCommand::setEldarica(std::optional<unsigned int> timeoutInMilliseconds, bool computeInvariants)
 {
 	m_arguments.clear();
+	m_sessionArguments.clear();
+	m_timeout = timeoutInMilliseconds;
 	m_solverCmd = "eld";
 	if (timeoutInMilliseconds)
 	{
@@ -50,6 +58,7 @@ void SMTSolverCommand::setEldarica(std::optional<unsigned int> timeoutInMillisec
 void SMTSolverCommand::setCvc5(std::optional<unsigned int> timeoutInMilliseconds)
 {
 	m_arguments.clear();
+	m_timeout = timeoutInMilliseconds;
 	m_solverCmd = "cvc5";
 	if (timeoutInMilliseconds)
 	{
@@ -61,6 +70,74 @@ void SMTSolverCommand::setCvc5(std::optional<unsigned int> timeoutInMilliseconds
 		m_arguments.push_back("--rlimit");
 		m_arguments.push_back(std::to_string(12000));
 	}
+
+	// The resource limit of a session has to apply to each query instead of the whole process.
+	m_sessionArguments = {"--lang=smt2", "--incremental"};
+	m_sessionArguments.push_back(timeoutInMilliseconds ? "--tlimit-per" : "--rlimit-per");
+	m_sessionArguments.push_back(m_arguments.back());
+}
+
+void SMTSolverCommand::interrupt()
+{
+	std::lock_guard lock(m_processMutex);
+	m_interruptRequested = true;
+	for (boost::process::child* process: m_runningProcesses)
+	{
+		// The process may have been terminated already.
+		std::error_code error;
+		process->terminate(error);
+	}
+}
+
+void SMTSolverCommand::clearInterrupt()
+{
+	std::lock_guard lock(m_processMutex);
+	m_interruptRequested = false;
+}
+
+util::h256 SMTSolverCommand::cacheKey(
+	boost::filesystem::path const& _solverBin,
+	std::vector<std::string> const& _arguments,
+	std::string const& _query
+) const
+{
+	Json key;
+	key["solver"] = m_solverCmd;
+	key["version"] = solverVersion(_solverBin);
+	key["arguments"] = _arguments;
+	key["query"] = util::keccak256(_query).hex();
+	return util::keccak256(util::jsonCompactPrint(key));
+}
+
+std::string SMTSolverCommand::solverVersion(boost::filesystem::path const& _solverBin) const
+{
+	{
+		std::lock_guard lock(m_processMutex);
+		if (auto it = m_solverVersions.find(_solverBin); it != m_solverVersions.end())
+			return it->second;
+	}
+
+	std::string version;
+	try
+	{
+		boost::process::ipstream pipe;
+		boost::process::child versionProcess(
+			_solverBin,
+			"--version",
+			boost::process::std_out > pipe,
+			boost::process::std_err > boost::process::null
+		);
+		std::string line;
+		while (std::getline(pipe, line))
+			version += line + "\n";
+		versionProcess.wait();
+	}
+	catch (boost::process::process_error const&)
+	{
+	}
+
+	std::lock_guard lock(m_processMutex);
+	return m_solverVersions.emplace(_solverBin, std::move(version)).first->second;
 }
 
 ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::string const& _query) const
@@ -73,43 +150,188 @@ ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::stri
 		if (m_solverCmd.empty())
 			return ReadCallback::Result{false, "No solver set."};
 
-		auto tempDir = solidity::util::TemporaryDirectory("smt");
-		util::h256 queryHash = util::keccak256(_query);
-		auto queryFileName = tempDir.path() / ("query_" + queryHash.hex() + ".smt2");
-
-		auto queryFile = boost::filesystem::ofstream(queryFileName);
-		queryFile << _query << std::flush;
-
 		auto solverBin = boost::process::search_path(m_solverCmd);
 
 		if (solverBin.empty())
 			return ReadCallback::Result{false, m_solverCmd + " binary not found."};
 
-		auto args = m_arguments;
-		args.push_back(queryFileName.string());
+		bool const useSessions = m_sessions && !m_sessionArguments.empty();
+		if (m_cache)
+		{
+			std::optional<Json> entry = m_cache->load(cacheKey(solverBin, useSessions ? m_sessionArguments : m_arguments, _query));
+			if (entry && entry->contains("response") && (*entry)["response"].is_string())
+				return ReadCallback::Result{true, (*entry)["response"].get<std::string>()};
+		}
 
-		boost::process::ipstream pipe;
-		boost::process::child solverProcess(
-			solverBin,
-			args,
-			boost::process::std_out > pipe,
-			boost::process::std_err > boost::process::null
-		);
+		{
+			std::lock_guard lock(m_processMutex);
+			if (m_interruptRequested)
+				return ReadCallback::Result{true, "unknown"};
+		}
+
+		std::optional<Response> response;
+		if (useSessions)
+			response = solveInSession(solverBin, _query);
+		// The response is stored under the arguments of the solver that gave it, which are the ones
+		// of a single process if the session failed.
+		bool const solvedInSession = response.has_value();
+		if (!response)
+			response = solveInProcess(solverBin, _query);
+
+		if (m_cache && response->complete && !(m_timeout && boost::starts_with(response->output, "unknown")))
+			m_cache->store(
+				cacheKey(solverBin, solvedInSession ? m_sessionArguments : m_arguments, _query),
+				Json{{"response", response->output}}
+			);
+
+		return ReadCallback::Result{true, std::move(response->output)};
+	}
+	catch (...)
+	{
+		return ReadCallback::Result{false, "Exception in SMTQuery callback: " + boost::current_exception_diagnostic_information()};
+	}
+}
+
+SMTSolverCommand::Response SMTSolverCommand::solveInProcess(boost::filesystem::path const& _solverBin, std::string const& _query) const
+{
+	auto tempDir = solidity::util::TemporaryDirectory("smt");
+	util::h256 queryHash = util::keccak256(_query);
+	auto queryFileName = tempDir.path() / ("query_" + queryHash.hex() + ".smt2");
+
+	auto queryFile = boost::filesystem::ofstream(queryFileName);
+	queryFile << _query << std::flush;
+
+	auto args = m_arguments;
+	args.push_back(queryFileName.string());
+
+	boost::process::ipstream pipe;
+	boost::process::child solverProcess(
+		_solverBin,
+		args,
+		boost::process::std_out > pipe,
+		boost::process::std_err > boost::process::null
+	);
+
+	std::vector<std::string> data;
+	bool interrupted = whileRegistered(solverProcess, [&]() {
+		auto isRunning = [&]() {
+			std::lock_guard lock(m_processMutex);
+			return solverProcess.running();
+		};
 
-		std::vector<std::string> data;
 		std::string line;
-		while (solverProcess.running() && std::getline(pipe, line))
+		while (isRunning() && std::getline(pipe, line))
 			if (!line.empty())
 				data.push_back(line);
+	});
+
+	solverProcess.wait();
+
+	return {boost::join(data, "\n"), !interrupted && solverProcess.exit_code() == 0};
+}
 
-		solverProcess.wait();
+std::optional<SMTSolverCommand::Response> SMTSolverCommand::solveInSession(boost::filesystem::path const& _solverBin, std::string const& _query) const
+{
+	std::vector<std::string> key = m_sessionArguments;
+	key.insert(key.begin(), _solverBin.string());
 
-		return ReadCallback::Result{true, boost::join(data, "\n")};
+	std::unique_ptr<SMTSolverSession> session;
+	{
+		std::lock_guard lock(m_processMutex);
+		auto& idleSessions = m_idleSessions[key];
+		if (!idleSessions.empty())
+		{
+			session = std::move(idleSessions.back());
+			idleSessions.pop_back();
+		}
 	}
-	catch (...)
+
+	std::optional<std::string> output;
+	bool timedOut = false;
+	bool interrupted = false;
+	auto solveInCurrentSession = [&]() {
+		interrupted = whileRegistered(session->process(), [&]() {
+			// Terminates the solver if it does not answer within the timeout, which it normally enforces itself.
+			std::mutex mutex;
+			std::condition_variable answeredCondition;
+			bool answered = false;
+			std::thread watchdog;
+			if (m_timeout && *m_timeout > 0)
+				watchdog = std::thread([&]() {
+					std::unique_lock lock(mutex);
+					if (!answeredCondition.wait_for(lock, std::chrono::milliseconds(*m_timeout + 1000), [&] { return answered; }))
+					{
+						timedOut = true;
+						std::lock_guard processLock(m_processMutex);
+						std::error_code error;
+						session->process().terminate(error);
+					}
+				});
+			ScopeGuard stopWatchdog([&]() {
+				{
+					std::lock_guard lock(mutex);
+					answered = true;
+				}
+				answeredCondition.notify_all();
+				if (watchdog.joinable())
+					watchdog.join();
+			});
+
+			output = session->solve(_query);
+		});
+	};
+
+	if (session)
+		solveInCurrentSession();
+	// A new session is started if there is no idle one or the query does not fit it.
+	if (!output && !interrupted)
 	{
-		return ReadCallback::Result{false, "Exception in SMTQuery callback: " + boost::current_exception_diagnostic_information()};
+		session = std::make_unique<SMTSolverSession>(_solverBin, m_sessionArguments);
+		solveInCurrentSession();
+	}
+	if (!output && interrupted)
+		return Response{"unknown", false};
+	else if (!output)
+		return std::nullopt;
+
+	if (session->usable())
+	{
+		std::lock_guard lock(m_processMutex);
+		m_idleSessions[key].emplace_back(std::move(session));
+		return Response{std::move(*output), !interrupted};
+	}
+	else if (timedOut && !interrupted)
+		return Response{"unknown", false};
+	else if (interrupted)
+		return Response{std::move(*output), false};
+	else
+		// The solver crashed or reported an error. The query is solved again by a new process,
+		// whose response does not depend on the earlier queries.
+		return std::nullopt;
+}
+
+bool SMTSolverCommand::whileRegistered(boost::process::child& _process, std::function<void()> const& _task) const
+{
+	{
+		std::lock_guard lock(m_processMutex);
+		m_runningProcesses.insert(&_process);
+		// The interrupt arrived before the process was started.
+		if (m_interruptRequested)
+		{
+			std::error_code error;
+			_process.terminate(error);
+		}
+	}
+	bool interrupted = false;
+	{
+		ScopeGuard unregisterProcess([&]() {
+			std::lock_guard lock(m_processMutex);
+			m_runningProcesses.erase(&_process);
+			interrupted = m_interruptRequested;
+		});
+		_task();
 	}
+	return interrupted;
 }
 
 }
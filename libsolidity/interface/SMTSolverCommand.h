@@ -17,9 +17,18 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/ReadFile.h>
+#include <libsolidity/interface/SMTSolverSession.h>
 
 #include <boost/filesystem.hpp>
+#include <boost/process/child.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 
 namespace solidity::frontend
 {
@@ -39,10 +48,75 @@ public:
 	void setEldarica(std::optional<unsigned int> timeoutInMilliseconds, bool computeInvariants);
 	void setCvc5(std::optional<unsigned int> timeoutInMilliseconds);
 
+	/// Terminates the solver processes of the queries currently being solved on other threads.
+	/// The interrupted queries are answered with the (incomplete) output of the solver.
+	/// Queries started before clearInterrupt() is called are answered with "unknown" right away
+	/// or, if their solver process already started, are interrupted as well.
+	void interrupt();
+	/// Withdraws the requests of interrupt(). Must not be called while a query is being solved.
+	void clearInterrupt();
+
+	/// Sets the store in which the responses of the solver are recorded, so that repeated queries
+	/// are answered without calling the solver, also across compiler runs.
+	/// The responses are keyed by the query, the solver, its version and the arguments it was started with,
+	/// which differ between sessions and processes solving a single query.
+	/// Responses "unknown" are not recorded if there is a timeout, since the solver may answer
+	/// the query when it runs on a less busy machine.
+	void setCache(std::shared_ptr<CompilationCache const> _cache) { m_cache = std::move(_cache); }
+
+	/// Enables keeping the solver processes running between queries and streaming the queries to them,
+	/// which saves starting a process for every query. Only used for solvers supporting incremental solving.
+	/// A solver process that crashes or exceeds the timeout is replaced by a new one.
+	void setSessions(bool _enabled) { m_sessions = _enabled; }
+
 private:
+	struct Response
+	{
+		std::string output;
+		/// False if the solver was interrupted or exceeded the timeout.
+		bool complete = false;
+	};
+
+	/// Solves @a _query by a new solver process reading it from a file.
+	Response solveInProcess(boost::filesystem::path const& _solverBin, std::string const& _query) const;
+	/// Solves @a _query by an idle session of the solver or a new one.
+	/// @returns nullopt if the session crashed or could not take the query.
+	std::optional<Response> solveInSession(boost::filesystem::path const& _solverBin, std::string const& _query) const;
+	/// Runs @a _task while @a _process is registered as running, so that interrupt() can terminate it.
+	/// @returns true if an interrupt was requested before or while @a _task ran.
+	bool whileRegistered(boost::process::child& _process, std::function<void()> const& _task) const;
+
+	/// @returns the key of the response to @a _query, solved by a solver started with @a _arguments, in the cache.
+	util::h256 cacheKey(
+		boost::filesystem::path const& _solverBin,
+		std::vector<std::string> const& _arguments,
+		std::string const& _query
+	) const;
+	/// @returns the output of the solver binary when asked for its version.
+	std::string solverVersion(boost::filesystem::path const& _solverBin) const;
+
 	/// The name of the solver's binary.
 	std::string m_solverCmd;
 	std::vector<std::string> m_arguments;
+	/// The arguments making the solver read queries from the standard input in a session.
+	/// Empty if the solver does not support sessions.
+	std::vector<std::string> m_sessionArguments;
+	std::optional<unsigned> m_timeout;
+	bool m_sessions = false;
+
+	/// Protects m_runningProcesses, which contains the solver processes of the queries being solved,
+	/// m_interruptRequested and the idle sessions. Queries can be solved concurrently, as long as the solver is not changed meanwhile.
+	mutable std::mutex m_processMutex;
+	mutable std::set<boost::process::child*> m_runningProcesses;
+	/// True if interrupt() was called since the last clearInterrupt().
+	/// Interrupted responses are not stored in the cache.
+	bool m_interruptRequested = false;
+	/// Version of each solver binary that has been queried so far.
+	mutable std::map<boost::filesystem::path, std::string> m_solverVersions;
+	/// Sessions not solving a query, by the solver binary followed by the session arguments.
+	mutable std::map<std::vector<std::string>, std::vector<std::unique_ptr<SMTSolverSession>>> m_idleSessions;
+
+	std::shared_ptr<CompilationCache const> m_cache;
 };
 
 }
@@ -0,0 +1,198 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/SMTSolverSession.h>
+
+#include <boost/algorithm/string/join.hpp>
+#include <boost/process.hpp>
+
+#include <cctype>
+#include <set>
+
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+/// @returns the token starting at @a _position, skipping whitespace before it.
+std::string token(std::string const& _command, size_t& _position)
+{
+	while (_position < _command.size() && std::isspace(static_cast<unsigned char>(_command[_position])))
+		++_position;
+	size_t start = _position;
+	if (_position < _command.size() && _command[_position] == '|')
+		_position = std::min(_command.find('|', _position + 1), _command.size() - 1) + 1;
+	else
+		while (
+			_position < _command.size() &&
+			!std::isspace(static_cast<unsigned char>(_command[_position])) &&
+			_command[_position] != '(' &&
+			_command[_position] != ')'
+		)
+			++_position;
+	return _command.substr(start, _position - start);
+}
+
+}
+
+SMTSolverSession::SMTSolverSession(boost::filesystem::path const& _solverBin, std::vector<std::string> const& _arguments):
+	m_process(
+		_solverBin,
+		_arguments,
+		boost::process::std_in < m_input,
+		boost::process::std_out > m_output,
+		boost::process::std_err > boost::process::null
+	)
+{
+}
+
+SMTSolverSession::~SMTSolverSession()
+{
+	std::error_code error;
+	if (m_process.running(error))
+		m_process.terminate(error);
+}
+
+std::optional<std::string> SMTSolverSession::solve(std::string const& _query)
+{
+	Script script = parse(_query);
+	if (m_options && *m_options != script.options)
+		return std::nullopt;
+	for (auto const& [name, declaration]: script.declarations)
+		if (auto it = m_declarations.find(name); it != m_declarations.end() && it->second != declaration)
+			return std::nullopt;
+
+	std::string input;
+	if (!m_options)
+	{
+		for (std::string const& option: script.options)
+			input += option + "\n";
+		m_options = std::move(script.options);
+	}
+	for (auto& [name, declaration]: script.declarations)
+		if (m_declarations.emplace(name, declaration).second)
+			input += declaration + "\n";
+	input += "(push 1)\n";
+	for (std::string const& command: script.commands)
+		input += command + "\n";
+	input += "(pop 1)\n";
+	std::string const marker = "solc-query-" + std::to_string(++m_queries);
+	input += "(echo \"" + marker + "\")\n";
+
+	std::vector<std::string> response;
+	bool answered = false;
+	if (m_process.running())
+	{
+		m_input << input << std::flush;
+		std::string line;
+		while (std::getline(m_output, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			if (line == marker || line == "\"" + marker + "\"")
+			{
+				answered = true;
+				break;
+			}
+			if (line.rfind("(error", 0) == 0)
+				m_failed = true;
+			if (!line.empty())
+				response.emplace_back(std::move(line));
+		}
+	}
+	if (!answered || m_declarations.size() >= maxDeclarations)
+		m_failed = true;
+	return boost::join(response, "\n");
+}
+
+bool SMTSolverSession::usable()
+{
+	std::error_code error;
+	return !m_failed && m_process.running(error);
+}
+
+std::vector<std::string> SMTSolverSession::splitCommands(std::string const& _script)
+{
+	std::vector<std::string> commands;
+	std::string command;
+	size_t depth = 0;
+	for (size_t i = 0; i < _script.size(); ++i)
+	{
+		char c = _script[i];
+		if (c == ';')
+		{
+			while (i + 1 < _script.size() && _script[i + 1] != '\n')
+				++i;
+			continue;
+		}
+		if (depth == 0 && c != '(')
+			continue;
+
+		if (c == '|' || c == '"')
+		{
+			// Quoted symbols and string literals can contain parentheses and semicolons.
+			// A doubled quote inside a string literal is an escaped quote, which the loop
+			// reads as the end of one literal and the start of another.
+			size_t end = _script.find(c, i + 1);
+			if (end == std::string::npos)
+				end = _script.size() - 1;
+			command += _script.substr(i, end - i + 1);
+			i = end;
+			continue;
+		}
+
+		command += c;
+		if (c == '(')
+			++depth;
+		else if (c == ')' && --depth == 0)
+		{
+			commands.emplace_back(std::move(command));
+			command.clear();
+		}
+	}
+	return commands;
+}
+
+SMTSolverSession::Script SMTSolverSession::parse(std::string const& _query)
+{
+	static std::set<std::string> const optionCommands{"set-option", "set-logic", "set-info"};
+	static std::set<std::string> const namedDeclarations{"declare-fun", "declare-sort", "define-sort", "declare-datatype"};
+
+	Script script;
+	for (std::string& command: splitCommands(_query))
+	{
+		size_t position = 1;
+		std::string head = token(command, position);
+		if (optionCommands.count(head))
+			script.options.emplace_back(std::move(command));
+		else if (namedDeclarations.count(head))
+		{
+			std::string name = token(command, position);
+			script.declarations.emplace_back(std::move(name), std::move(command));
+		}
+		else if (head == "declare-datatypes")
+			// Declares several sorts and their constructors, so the whole command is used as the name.
+			script.declarations.emplace_back(command, command);
+		else
+			// Constants declared with `declare-const` remain local to the query,
+			// since they are used to query the values of expressions in the model.
+			script.commands.emplace_back(std::move(command));
+	}
+	return script;
+}
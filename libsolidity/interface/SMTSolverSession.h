@@ -0,0 +1,102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Long-lived SMT solver process that answers a sequence of queries.
+ */
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <boost/process/child.hpp>
+#include <boost/process/pipe.hpp>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Incremental SMT solver process to which queries are streamed over pipes.
+ *
+ * Each query is a complete SMT-LIB2 script, as it would be passed to a solver in a file.
+ * The options and declarations of the queries are kept by the solver, so that a query only
+ * sends the declarations not sent by earlier queries. All other commands are sent between
+ * `(push 1)` and `(pop 1)`, followed by an `echo` command marking the end of the response.
+ *
+ * A session is used by one thread at a time. It cannot be used anymore once its process terminated.
+ */
+class SMTSolverSession
+{
+public:
+	/// Commands of a query, separated into the parts sent to the solver at different times.
+	struct Script
+	{
+		/// `set-option`, `set-logic` and `set-info` commands, which have to be equal for all queries.
+		std::vector<std::string> options;
+		/// Declarations of functions, sorts and datatypes together with the names they declare,
+		/// which are kept for later queries.
+		std::vector<std::pair<std::string, std::string>> declarations;
+		/// All other commands in their original order.
+		std::vector<std::string> commands;
+	};
+
+	/// Starts the solver @a _solverBin with @a _arguments, which have to make it read
+	/// incremental SMT-LIB2 from the standard input.
+	SMTSolverSession(boost::filesystem::path const& _solverBin, std::vector<std::string> const& _arguments);
+	~SMTSolverSession();
+
+	SMTSolverSession(SMTSolverSession const&) = delete;
+	SMTSolverSession& operator=(SMTSolverSession const&) = delete;
+
+	/// Sends @a _query to the solver and @returns the non-empty lines of its response.
+	/// @returns nullopt without sending anything if the options of the query differ from the ones of
+	/// the session or it declares a name declared differently before, in which case it has to be sent
+	/// to another session.
+	/// The response is incomplete if the process terminated before answering, see usable().
+	std::optional<std::string> solve(std::string const& _query);
+
+	/// @returns false if the solver process terminated or reported an error, in which case
+	/// the session should be discarded.
+	bool usable();
+
+	boost::process::child& process() { return m_process; }
+
+	/// @returns the top-level commands of @a _script in their order, without comments.
+	static std::vector<std::string> splitCommands(std::string const& _script);
+	static Script parse(std::string const& _query);
+
+private:
+	/// Sessions that have accumulated this many declarations are not used for further queries,
+	/// so that the memory of the solver does not grow without bounds.
+	static constexpr size_t maxDeclarations = 1 << 16;
+
+	boost::process::opstream m_input;
+	boost::process::ipstream m_output;
+	boost::process::child m_process;
+
+	std::optional<std::vector<std::string>> m_options;
+	/// Declarations sent to the solver, by the name they declare.
+	std::map<std::string, std::string> m_declarations;
+	size_t m_queries = 0;
+	bool m_failed = false;
+};
+
+}
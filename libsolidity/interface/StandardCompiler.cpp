@@ -23,6 +23,7 @@
 
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/ImportRemapper.h>
+#include <libsolidity/interface/CompilationCache.h>
 
 #include <libsolidity/ast/ASTJsonExporter.h>
 #include <libyul/YulStack.h>
@@ -85,6 +86,36 @@ Json formatFatalError(Error::Type _type, std::string const& _message)
 	return output;
 }
 
+/// @returns the output reporting the exception that is currently being handled while compiling.
+Json formatCompilationException()
+{
+	try
+	{
+		throw;
+	}
+	catch (UnimplementedFeatureError const& _exception)
+	{
+		solAssert(_exception.comment(), "Unimplemented feature errors must include a message for the user");
+		return formatFatalError(Error::Type::UnimplementedFeatureError, stringOrDefault(_exception.comment()));
+	}
+	catch (...)
+	{
+		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+	}
+}
+
+std::string printOutput(Json const& _output, JsonFormat const& _format)
+{
+	try
+	{
+		return util::jsonPrint(_output, _format);
+	}
+	catch (...)
+	{
+		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+	}
+}
+
 Json formatSourceLocation(SourceLocation const* location)
 {
 	if (!location || !location->sourceName)
@@ -295,6 +326,22 @@ bool isEvmBytecodeRequested(Json const& _outputSelection)
 	return false;
 }
 
+/// @returns true if an output was requested that is not stored in the compilation cache.
+bool isOutputNotCacheableRequested(Json const& _outputSelection)
+{
+	if (!_outputSelection.is_object())
+		return false;
+
+	static std::vector<std::string> const outputsNotCacheable{"ast", "irOptimizedAst", "evm.assembly", "evm.gasEstimates"};
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& output: outputsNotCacheable)
+				if (isArtifactRequested(requests, output, true))
+					return true;
+	return false;
+}
+
 /// @returns true if any Yul IR was requested. Note that as an exception, '*' does not
 /// yet match "ir", "irAst", "irOptimized" or "irOptimizedAst"
 bool isIRRequested(Json const& _outputSelection)
@@ -316,6 +363,22 @@ bool isIRRequested(Json const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the timings of the compilation were requested. They are not deterministic,
+/// so they are only matched by an explicit "timings" in the source-level selection, never by "*".
+bool isTimingsRequested(Json const& _outputSelection)
+{
+	if (!_outputSelection.is_object())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		if (fileRequests.is_object() && fileRequests.contains("") && fileRequests[""].is_array())
+			for (auto const& request: fileRequests[""])
+				if (request == "timings")
+					return true;
+
+	return false;
+}
+
 Json formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json ret = Json::object();
@@ -425,13 +488,13 @@ std::optional<Json> checkAuxiliaryInputKeys(Json const& _input)
 
 std::optional<Json> checkSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static std::set<std::string> keys{"cache", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json> checkModelCheckerSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "timeout"};
+	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "portfolio", "printQuery", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "timeout", "workers"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -619,12 +682,14 @@ std::variant<OptimiserSettings, Json> parseOptimizerSettings(Json const& _jsonIn
 				return {std::move(settings)};
 			}
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "profile"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps, settings.yulOptimiserCleanupSteps, settings.runYulOptimiser))
 				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "profile", settings.profileYulOptimiser))
+				return *error;
 		}
 	}
 	return {std::move(settings)};
@@ -816,6 +881,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.viaIR = settings["viaIR"].get<bool>();
 	}
 
+	if (settings.contains("parallelism"))
+	{
+		if (!settings["parallelism"].is_number_unsigned())
+			return formatFatalError(Error::Type::JSONError, "\"settings.parallelism\" must be an unsigned integer.");
+		ret.parallelism = settings["parallelism"].get<size_t>();
+	}
+
+	if (settings.contains("cache"))
+	{
+		if (!settings["cache"].is_string() || settings["cache"].get<std::string>().empty())
+			return formatFatalError(Error::Type::JSONError, "\"settings.cache\" must be a non-empty string.");
+		ret.cacheDirectory = settings["cache"].get<std::string>();
+	}
+
 	if (settings.contains("evmVersion"))
 	{
 		if (!settings["evmVersion"].is_string())
@@ -1089,6 +1168,16 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.modelCheckerSettings.invariants = invariants;
 	}
 
+	if (modelCheckerSettings.contains("portfolio"))
+	{
+		if (!modelCheckerSettings["portfolio"].is_string())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.portfolio must be a string.");
+		std::optional<ModelCheckerPortfolio> portfolio = ModelCheckerPortfolio::fromString(modelCheckerSettings["portfolio"].get<std::string>());
+		if (!portfolio)
+			return formatFatalError(Error::Type::JSONError, "Invalid model checker portfolio requested.");
+		ret.modelCheckerSettings.portfolio = *portfolio;
+	}
+
 	if (modelCheckerSettings.contains("showProvedSafe"))
 	{
 		auto const& showProvedSafe = modelCheckerSettings["showProvedSafe"];
@@ -1171,6 +1260,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].get<Json::number_unsigned_t>();
 	}
 
+	if (modelCheckerSettings.contains("workers"))
+	{
+		if (!modelCheckerSettings["workers"].is_number_unsigned())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.workers must be an unsigned integer.");
+		ret.modelCheckerSettings.workers = modelCheckerSettings["workers"].get<unsigned>();
+	}
+
 	return {std::move(ret)};
 }
 
@@ -1295,6 +1391,18 @@ Json StandardCompiler::importEVMAssembly(StandardCompiler::InputsAndSettings _in
 }
 
 Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+{
+	Json output;
+	compileSolidity(std::move(_inputsAndSettings), [&](std::vector<std::string> const& _path, Json _value) {
+		Json* member = &output;
+		for (std::string const& key: _path)
+			member = &(*member)[key];
+		*member = std::move(_value);
+	});
+	return output;
+}
+
+void StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, OutputCallback const& _addOutput)
 {
 	solAssert(_inputsAndSettings.jsonSources.empty());
 
@@ -1306,6 +1414,15 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	bool const profileYulOptimiser = _inputsAndSettings.optimiserSettings.profileYulOptimiser;
+	if (
+		!_inputsAndSettings.cacheDirectory.empty() &&
+		_inputsAndSettings.language == "Solidity" &&
+		!isOutputNotCacheableRequested(_inputsAndSettings.outputSelection) &&
+		!profileYulOptimiser
+	)
+		compilerStack.setCompilationCache(std::make_shared<CompilationCache>(_inputsAndSettings.cacheDirectory));
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
@@ -1320,7 +1437,8 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
 
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
-	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection) || profileYulOptimiser);
+	compilerStack.enableTimings(isTimingsRequested(_inputsAndSettings.outputSelection));
 
 	Json errors = std::move(_inputsAndSettings.errors);
 
@@ -1426,38 +1544,30 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	if (compilationFailed || analysisFailed || !parsingSuccess)
 		solAssert(!errors.empty(), "No error reported, but compilation failed.");
 
-	Json output;
-
-	if (errors.size() > 0)
-	output["errors"] = std::move(errors);
-
 	if (!compilerStack.unhandledSMTLib2Queries().empty())
+	{
+		Json auxiliaryInputRequested;
 		for (std::string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+			auxiliaryInputRequested["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+		_addOutput({"auxiliaryInputRequested"}, std::move(auxiliaryInputRequested));
+	}
 
 	bool const wildcardMatchesExperimental = false;
 
-	output["sources"] = Json::object();
-	unsigned sourceIndex = 0;
-	// NOTE: A case that will pass `parsingSuccess && !analysisFailed` but not `analysisSuccess` is
-	// stopAfter: parsing with no parsing errors.
-	if (parsingSuccess && !analysisFailed)
-		for (std::string const& sourceName: compilerStack.sourceNames())
-		{
-			Json sourceResult;
-			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
-		}
-
-	Json contractsOutput;
+	// The members have to be added in the order of their keys. Note that the order of the fully
+	// qualified names is different if the name of a source unit is a prefix of another one.
+	std::vector<std::pair<std::string, std::string>> contracts;
 	for (std::string const& contractName: analysisSuccess ? compilerStack.contractNames() : std::vector<std::string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != std::string::npos, "");
-		std::string file = contractName.substr(0, colon);
-		std::string name = contractName.substr(colon + 1);
+		contracts.emplace_back(contractName.substr(0, colon), contractName.substr(colon + 1));
+	}
+	std::sort(contracts.begin(), contracts.end());
+
+	for (auto const& [file, name]: contracts)
+	{
+		std::string const contractName = file + ":" + name;
 
 		// ABI, storage layout, documentation and metadata
 		Json contractData;
@@ -1481,6 +1591,9 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimizedAst", wildcardMatchesExperimental))
 			contractData["irOptimizedAst"] = compilerStack.yulIROptimizedAst(contractName);
+		if (compilationSuccess && profileYulOptimiser)
+			if (Json profile = compilerStack.yulOptimizerProfile(contractName); !profile.is_null())
+				contractData["yulOptimizerProfile"] = std::move(profile);
 
 		// EVM
 		Json evmData;
@@ -1541,16 +1654,31 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 			contractData["evm"] = evmData;
 
 		if (!contractData.empty())
-		{
-			if (!contractsOutput.contains(file))
-				contractsOutput[file] = Json::object();
-			contractsOutput[file][name] = contractData;
-		}
+			_addOutput({"contracts", file, name}, std::move(contractData));
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
 
-	return output;
+	if (!errors.empty())
+		_addOutput({"errors"}, std::move(errors));
+
+	std::vector<std::string> sourceNames;
+	// NOTE: A case that will pass `parsingSuccess && !analysisFailed` but not `analysisSuccess` is
+	// stopAfter: parsing with no parsing errors.
+	if (parsingSuccess && !analysisFailed)
+		sourceNames = compilerStack.sourceNames();
+	if (sourceNames.empty())
+		_addOutput({"sources"}, Json::object());
+	unsigned sourceIndex = 0;
+	for (std::string const& sourceName: sourceNames)
+	{
+		Json sourceResult;
+		sourceResult["id"] = sourceIndex++;
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+			sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+		_addOutput({"sources", sourceName}, std::move(sourceResult));
+	}
+
+	if (isTimingsRequested(_inputsAndSettings.outputSelection))
+		_addOutput({"timings"}, compilerStack.timings());
 }
 
 
@@ -1692,6 +1820,8 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "irOptimized", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["irOptimized"] = stack.print();
+	if (_inputsAndSettings.optimiserSettings.profileYulOptimiser && !stack.optimiserProfile().is_null())
+		output["contracts"][sourceName][contractName]["yulOptimizerProfile"] = stack.optimiserProfile();
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "evm.assembly", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["evm"]["assembly"] = object.assembly;
 
@@ -1707,26 +1837,11 @@ Json StandardCompiler::compile(Json const& _input) noexcept
 		auto parsed = parseInput(_input);
 		if (std::holds_alternative<Json>(parsed))
 			return std::get<Json>(std::move(parsed));
-		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
-		else if (settings.language == "SolidityAST")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "EVMAssembly")
-			return importEVMAssembly(std::move(settings));
-		else
-			return formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\", \"SolidityAST\" or \"EVMAssembly\" is supported as a language.");
-	}
-	catch (UnimplementedFeatureError const& _exception)
-	{
-		solAssert(_exception.comment(), "Unimplemented feature errors must include a message for the user");
-		return formatFatalError(Error::Type::UnimplementedFeatureError, stringOrDefault(_exception.comment()));
+		return compileInput(std::get<InputsAndSettings>(std::move(parsed)));
 	}
 	catch (...)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+		return formatCompilationException();
 	}
 }
 
@@ -1751,14 +1866,76 @@ std::string StandardCompiler::compile(std::string const& _input) noexcept
 	Json output = compile(input);
 //	std::cout << "Output: " << solidity::util::jsonPrettyPrint(output) << std::endl;
 
+	return printOutput(output, m_jsonPrintingFormat);
+}
+
+bool StandardCompiler::compile(std::string const& _input, std::ostream& _output) noexcept
+{
+	Json input;
 	try
 	{
-		return util::jsonPrint(output, m_jsonPrintingFormat);
+		if (!util::jsonParseStrict(_input, input))
+			input = nullptr;
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		input = nullptr;
+	}
+	if (input.is_null())
+	{
+		// Let the other overload report the error.
+		_output << compile(_input);
+		return true;
+	}
+
+	YulStringRepository::reset();
+
+	std::optional<util::JsonStreamWriter> writer;
+	Json output;
+	try
+	{
+		auto parsed = parseInput(input);
+		if (std::holds_alternative<Json>(parsed))
+			output = std::get<Json>(std::move(parsed));
+		else
+		{
+			InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
+			if (settings.language != "Solidity" && settings.language != "SolidityAST")
+				output = compileInput(std::move(settings));
+			else
+			{
+				writer.emplace(_output, m_jsonPrintingFormat);
+				compileSolidity(std::move(settings), [&](std::vector<std::string> const& _path, Json _value) {
+					writer->addMember(_path, _value);
+				});
+				writer->finish();
+				return true;
+			}
+		}
+	}
+	catch (...)
+	{
+		if (writer && writer->started())
+			return false;
+		output = formatCompilationException();
 	}
+
+	_output << printOutput(output, m_jsonPrintingFormat);
+	return true;
+}
+
+Json StandardCompiler::compileInput(InputsAndSettings _inputsAndSettings)
+{
+	if (_inputsAndSettings.language == "Solidity")
+		return compileSolidity(std::move(_inputsAndSettings));
+	else if (_inputsAndSettings.language == "Yul")
+		return compileYul(std::move(_inputsAndSettings));
+	else if (_inputsAndSettings.language == "SolidityAST")
+		return compileSolidity(std::move(_inputsAndSettings));
+	else if (_inputsAndSettings.language == "EVMAssembly")
+		return importEVMAssembly(std::move(_inputsAndSettings));
+	else
+		return formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\", \"SolidityAST\" or \"EVMAssembly\" is supported as a language.");
 }
 
 Json StandardCompiler::formatFunctionDebugData(
@@ -28,7 +28,9 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <functional>
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
@@ -62,6 +64,12 @@ public:
 	/// Parses input as JSON and performs the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Like the above, but writes the serialized output to @a _output. The output of a Solidity
+	/// compilation is serialized one source unit and one contract at a time and written right away
+	/// instead of building the JSON representation of all artifacts in memory first.
+	/// The output is the same, unless an exception occurs after writing started.
+	/// @returns false in that case, which leaves the output incomplete.
+	bool compile(std::string const& _input, std::ostream& _output) noexcept;
 
 	static Json formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
@@ -89,15 +97,22 @@ private:
 		Json outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelism = 1;
+		std::string cacheDirectory;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json> parseInput(Json const& _input);
 
+	/// Receives the members of the output given by their path, in the order of their keys.
+	using OutputCallback = std::function<void(std::vector<std::string> const& _path, Json _value)>;
+
 	std::map<std::string, Json> parseAstFromInput(StringMap const& _sources);
+	Json compileInput(InputsAndSettings _inputsAndSettings);
 	Json importEVMAssembly(InputsAndSettings _inputsAndSettings);
 	Json compileSolidity(InputsAndSettings _inputsAndSettings);
+	void compileSolidity(InputsAndSettings _inputsAndSettings, OutputCallback const& _addOutput);
 	Json compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
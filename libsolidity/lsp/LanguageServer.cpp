@@ -154,6 +154,8 @@ LanguageServer::LanguageServer(Transport& _transport):
 	m_fileRepository("/" /* basePath */, {} /* no search paths */),
 	m_compilerStack{m_fileRepository.reader()}
 {
+	// Every change of a document triggers a compilation, most of which only affect few source units.
+	m_compilerStack.enableIncrementalAnalysis();
 }
 
 Json LanguageServer::toRange(SourceLocation const& _location)
@@ -38,12 +38,15 @@ namespace solidity::frontend
 class Parser: public langutil::ParserBase
 {
 public:
+	/// @param _maxID the maximal AST node ID already in use. IDs of the created nodes are larger.
 	explicit Parser(
 		langutil::ErrorReporter& _errorReporter,
-		langutil::EVMVersion _evmVersion
+		langutil::EVMVersion _evmVersion,
+		int64_t _maxID = 0
 	):
 		ParserBase(_errorReporter),
-		m_evmVersion(_evmVersion)
+		m_evmVersion(_evmVersion),
+		m_currentNodeID(_maxID)
 	{}
 
 	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
@@ -23,6 +23,7 @@
 #include <libsolutil/JSON.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Exceptions.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -144,6 +145,78 @@ std::string jsonPrint(Json const& _input, JsonFormat const& _format)
 	return dumped;
 }
 
+void JsonStreamWriter::addMember(std::vector<std::string> const& _path, Json const& _value)
+{
+	assertThrow(!_path.empty(), Exception, "");
+	// Serialize the value first, so that failing to do so does not leave an incomplete member.
+	std::string value = jsonPrint(_value, m_format);
+
+	if (m_lastKeys.empty())
+	{
+		m_stream << "{";
+		m_lastKeys.emplace_back();
+	}
+	size_t commonLevels = 0;
+	while (
+		commonLevels < m_path.size() &&
+		commonLevels + 1 < _path.size() &&
+		m_path[commonLevels] == _path[commonLevels]
+	)
+		++commonLevels;
+	while (m_path.size() > commonLevels)
+		closeObject();
+	while (m_path.size() + 1 < _path.size())
+	{
+		writeKey(_path[m_path.size()]);
+		m_stream << "{";
+		m_path.emplace_back(_path[m_path.size()]);
+		m_lastKeys.emplace_back();
+	}
+
+	writeKey(_path.back());
+	if (m_format.format == JsonFormat::Pretty)
+		boost::replace_all(value, "\n", "\n" + indentation(m_path.size() + 1));
+	m_stream << value;
+}
+
+void JsonStreamWriter::finish()
+{
+	if (m_lastKeys.empty())
+	{
+		m_stream << "{}";
+		return;
+	}
+	while (!m_lastKeys.empty())
+		closeObject();
+}
+
+void JsonStreamWriter::writeKey(std::string const& _key)
+{
+	std::optional<std::string>& lastKey = m_lastKeys.back();
+	assertThrow(!lastKey || *lastKey < _key, Exception, "Members have to be added in the order of their keys.");
+	if (lastKey)
+		m_stream << ",";
+	if (m_format.format == JsonFormat::Pretty)
+		m_stream << "\n" << indentation(m_path.size() + 1);
+	m_stream << Json(_key).dump(-1, ' ', true) << (m_format.format == JsonFormat::Pretty ? ": " : ":");
+	lastKey = _key;
+}
+
+void JsonStreamWriter::closeObject()
+{
+	if (m_lastKeys.back() && m_format.format == JsonFormat::Pretty)
+		m_stream << "\n" << indentation(m_path.size());
+	m_stream << "}";
+	m_lastKeys.pop_back();
+	if (!m_path.empty())
+		m_path.pop_back();
+}
+
+std::string JsonStreamWriter::indentation(size_t _level) const
+{
+	return std::string(_level * m_format.indent, ' ');
+}
+
 bool jsonParseStrict(std::string const& _input, Json& _json, std::string* _errs /* = nullptr */)
 {
 	try
@@ -26,10 +26,12 @@
 #include <libsolutil/Assertions.h>
 #include <nlohmann/json.hpp>
 
+#include <ostream>
 #include <string>
 #include <string_view>
 #include <optional>
 #include <limits>
+#include <vector>
 
 namespace solidity
 {
@@ -71,6 +73,37 @@ std::string jsonCompactPrint(Json const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json const& _input, JsonFormat const& _format);
 
+/**
+ * Writes a JSON object to a stream member by member, in the same format in which jsonPrint
+ * prints the whole object. Members of nested objects are given by their path. The enclosing
+ * objects are opened and closed as needed, so all members have to be added in the order of
+ * their keys. This way only a single member has to be kept in memory at a time.
+ */
+class JsonStreamWriter
+{
+public:
+	JsonStreamWriter(std::ostream& _stream, JsonFormat const& _format): m_stream(_stream), m_format(_format) {}
+
+	/// Writes @a _value as the member at @a _path.
+	void addMember(std::vector<std::string> const& _path, Json const& _value);
+	/// Closes all open objects. Has to be called once after the last member has been added.
+	void finish();
+	/// @returns true if anything has been written to the stream.
+	bool started() const { return !m_lastKeys.empty(); }
+
+private:
+	void writeKey(std::string const& _key);
+	void closeObject();
+	std::string indentation(size_t _level) const;
+
+	std::ostream& m_stream;
+	JsonFormat m_format;
+	/// Keys of the open nested objects.
+	std::vector<std::string> m_path;
+	/// The last key written to each open object, including the root object.
+	std::vector<std::optional<std::string>> m_lastKeys;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
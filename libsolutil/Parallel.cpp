@@ -0,0 +1,172 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+/// Threads running the tasks of parallelFor for all callers. Threads are only started when more
+/// of them are requested than ever before, so that frequent short calls, e.g. one per step of the
+/// Yul optimiser, do not pay for starting threads.
+class WorkerPool
+{
+public:
+	static WorkerPool& instance()
+	{
+		static WorkerPool pool;
+		return pool;
+	}
+
+	~WorkerPool()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			m_stopping = true;
+		}
+		m_jobAvailable.notify_all();
+		for (std::thread& thread: m_threads)
+			thread.join();
+	}
+
+	/// Runs @a _job on @a _count threads of the pool. Jobs wait until a thread is available.
+	void submit(size_t _count, std::function<void()> const& _job)
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			while (m_threads.size() < _count)
+				m_threads.emplace_back([this]() { work(); });
+			m_jobs.insert(m_jobs.end(), _count, _job);
+		}
+		m_jobAvailable.notify_all();
+	}
+
+private:
+	WorkerPool() = default;
+
+	void work()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock lock(m_mutex);
+				m_jobAvailable.wait(lock, [&]() { return m_stopping || !m_jobs.empty(); });
+				if (m_jobs.empty())
+					return;
+				job = std::move(m_jobs.front());
+				m_jobs.pop_front();
+			}
+			job();
+		}
+	}
+
+	std::mutex m_mutex;
+	std::condition_variable m_jobAvailable;
+	std::deque<std::function<void()>> m_jobs;
+	std::vector<std::thread> m_threads;
+	bool m_stopping = false;
+};
+
+/// State of one call of parallelFor, shared with the jobs it submitted to the pool,
+/// which may only start after the call returned.
+struct ParallelForState
+{
+	std::mutex mutex;
+	std::condition_variable idle;
+	size_t nextIndex = 0;
+	/// Number of tasks that were handed out and did not finish yet.
+	size_t running = 0;
+	bool failed = false;
+	std::vector<std::exception_ptr> exceptions;
+};
+
+}
+
+size_t solidity::util::effectiveConcurrency(size_t _requested)
+{
+	if (_requested != 0)
+		return _requested;
+	return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+void solidity::util::parallelFor(size_t _concurrency, size_t _count, std::function<void(size_t)> const& _task)
+{
+	size_t const threadCount = std::min(effectiveConcurrency(_concurrency), _count);
+	if (threadCount <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	auto state = std::make_shared<ParallelForState>();
+	state->exceptions.resize(_count);
+
+	// Tasks are only handed out while this call is still running, so jobs starting later
+	// neither access @a _task nor the indices.
+	auto worker = [state, _count, task = &_task]() {
+		std::unique_lock lock(state->mutex);
+		while (!state->failed && state->nextIndex < _count)
+		{
+			size_t index = state->nextIndex++;
+			++state->running;
+			lock.unlock();
+			std::exception_ptr exception;
+			try
+			{
+				(*task)(index);
+			}
+			catch (...)
+			{
+				exception = std::current_exception();
+			}
+			lock.lock();
+			if (exception)
+			{
+				state->exceptions[index] = exception;
+				state->failed = true;
+			}
+			if (--state->running == 0)
+				state->idle.notify_all();
+		}
+	};
+
+	WorkerPool::instance().submit(threadCount - 1, worker);
+	worker();
+	{
+		std::unique_lock lock(state->mutex);
+		state->idle.wait(lock, [&]() { return state->running == 0; });
+	}
+
+	for (std::exception_ptr const& exception: state->exceptions)
+		if (exception)
+			std::rethrow_exception(exception);
+}
@@ -0,0 +1,47 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helpers for running independent pieces of work concurrently.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace solidity::util
+{
+
+/// @returns the number of threads to use for a requested concurrency of @a _requested,
+/// where zero means "one thread per hardware thread".
+size_t effectiveConcurrency(size_t _requested);
+
+/// Invokes @a _task once for every index in the range [0, @a _count), using at most
+/// @a _concurrency threads (the calling thread included). Indices are handed out in increasing
+/// order. With a concurrency of one (or a single task) everything runs on the calling thread.
+///
+/// The other threads are taken from a pool of threads that are kept for the rest of the process.
+/// The pool grows to the highest concurrency requested so far. The calling thread works on the
+/// tasks as well and does not wait for busy pool threads to become available, so calls can be nested.
+///
+/// If tasks throw, no further indices are handed out and, after all running tasks have finished,
+/// the exception thrown by the task with the smallest index is rethrown. Since all smaller indices
+/// were already started at that point, this is the same exception a serial loop would report.
+void parallelFor(size_t _concurrency, size_t _count, std::function<void(size_t)> const& _task);
+
+}
@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ResourceUsage.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#include <sys/resource.h>
+#endif
+
+using namespace solidity;
+using namespace solidity::util;
+
+std::optional<size_t> solidity::util::heapBytesInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	return mallinfo2().uordblks;
+#elif defined(__GLIBC__)
+	// The fields of mallinfo are only ints, so large heaps are not reported correctly.
+	return static_cast<size_t>(static_cast<unsigned>(mallinfo().uordblks));
+#elif defined(__APPLE__)
+	malloc_statistics_t statistics;
+	malloc_zone_statistics(nullptr, &statistics);
+	return statistics.size_in_use;
+#else
+	return std::nullopt;
+#endif
+}
+
+std::optional<size_t> solidity::util::peakResidentSetSize()
+{
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return std::nullopt;
+#if defined(__APPLE__)
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	// Linux and the BSDs report kilobytes.
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return std::nullopt;
+#endif
+}
+
+ScopedPhaseMeasurement::ScopedPhaseMeasurement(std::vector<PhaseUsage>* _phases, std::string _phase):
+	m_phases(_phases)
+{
+	if (!m_phases)
+		return;
+	m_phase = std::move(_phase);
+	m_heapBytesAtStart = heapBytesInUse();
+	m_start = std::chrono::steady_clock::now();
+}
+
+ScopedPhaseMeasurement::~ScopedPhaseMeasurement()
+{
+	if (!m_phases)
+		return;
+	auto const end = std::chrono::steady_clock::now();
+	PhaseUsage usage{
+		std::move(m_phase),
+		std::chrono::duration_cast<std::chrono::microseconds>(end - m_start).count(),
+		std::nullopt
+	};
+	if (std::optional<size_t> heapBytes = heapBytesInUse(); heapBytes && m_heapBytesAtStart)
+		usage.allocatedBytes = static_cast<std::int64_t>(*heapBytes) - static_cast<std::int64_t>(*m_heapBytesAtStart);
+	m_phases->emplace_back(std::move(usage));
+}
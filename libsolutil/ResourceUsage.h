@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helpers for measuring the time and memory taken by phases of the compilation.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// @returns the number of bytes currently allocated on the heap by the whole process
+/// or nullopt if the allocator does not provide it.
+std::optional<size_t> heapBytesInUse();
+
+/// @returns the largest resident set size the process had so far in bytes
+/// or nullopt if the operating system does not provide it.
+std::optional<size_t> peakResidentSetSize();
+
+/// Time and memory taken by a phase.
+struct PhaseUsage
+{
+	std::string phase;
+	std::int64_t durationInMicroseconds = 0;
+	/// Change of heapBytesInUse() during the phase, if available. Includes the memory
+	/// allocated and freed by other threads at the same time.
+	std::optional<std::int64_t> allocatedBytes;
+};
+
+/**
+ * Measures the phase from its construction to its destruction and appends the result
+ * to a list of phases. Does nothing if the list is null.
+ */
+class ScopedPhaseMeasurement
+{
+public:
+	ScopedPhaseMeasurement(std::vector<PhaseUsage>* _phases, std::string _phase);
+	~ScopedPhaseMeasurement();
+
+	ScopedPhaseMeasurement(ScopedPhaseMeasurement const&) = delete;
+	ScopedPhaseMeasurement& operator=(ScopedPhaseMeasurement const&) = delete;
+
+private:
+	std::vector<PhaseUsage>* m_phases = nullptr;
+	std::string m_phase;
+	std::chrono::steady_clock::time_point m_start;
+	std::optional<size_t> m_heapBytesAtStart;
+};
+
+}
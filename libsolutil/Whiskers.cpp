@@ -26,14 +26,62 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <mutex>
+#include <unordered_map>
 
 using namespace solidity::util;
 
+struct Whiskers::Template
+{
+	struct Part
+	{
+		enum class Kind { Text, Value, List, Condition };
+
+		Kind kind = Kind::Text;
+		/// The literal text or the name of the parameter, which starts with "+" for conditional values.
+		std::string text;
+		/// Body of a list or the parts used if a condition is true.
+		std::unique_ptr<Template const> body;
+		/// The parts used if a condition is false.
+		std::unique_ptr<Template const> elseBody;
+	};
+
+	std::string source;
+	std::vector<Part> parts;
+	/// Tags used to check the parameters, only computed for complete templates.
+	std::set<std::string> tags;
+};
+
+namespace
+{
+
+/// Maximal number of templates in the cache. Most templates are string literals, but some are
+/// assembled at runtime, so the cache is cleared if it gets larger than that.
+size_t constexpr maxCachedTemplates = 4096;
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the end of the parameter name starting at @a _start.
+size_t parameterEnd(std::string const& _text, size_t _start)
+{
+	size_t end = _start;
+	while (end < _text.size() && isParameterCharacter(_text[end]))
+		++end;
+	return end;
+}
+
+}
+
 Whiskers::Whiskers(std::string _template):
-	m_template(std::move(_template))
+	m_template(compile(std::move(_template)))
 {
-	checkTemplateValid();
 }
 
 Whiskers& Whiskers::operator()(std::string _parameter, std::string _value)
@@ -71,25 +119,16 @@ Whiskers& Whiskers::operator()(
 
 std::string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
-}
-
-void Whiskers::checkTemplateValid() const
-{
-	std::regex validTemplate("<[#?!\\/]\\+{0,1}[a-zA-Z0-9_$-]+(?:[^a-zA-Z0-9_$>-]|$)");
-	std::smatch match;
-	assertThrow(
-		!regex_search(m_template, match, validTemplate),
-		WhiskersError,
-		"Template contains an invalid/unclosed tag " + match.str()
-	);
+	std::string result;
+	result.reserve(m_template->source.size());
+	renderTo(result, *m_template, m_parameters, nullptr, m_conditions, &m_listParameters);
+	return result;
 }
 
 void Whiskers::checkParameterValid(std::string const& _parameter) const
 {
-	static std::regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && parameterEnd(_parameter, 0) == _parameter.size(),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -120,124 +159,241 @@ void Whiskers::checkTemplateContainsTags(std::string const& _parameter, std::vec
 	{
 		std::string tag{"<" + prefix + _parameter + ">"};
 		assertThrow(
-			m_template.find(tag) != std::string::npos,
+			m_template->tags.count(tag),
 			WhiskersError,
-			"Tag '" + tag + "' not found in template:\n" + m_template
+			"Tag '" + tag + "' not found in template:\n" + m_template->source
 		);
 	}
 }
 
-namespace
+std::shared_ptr<Whiskers::Template const> Whiskers::compile(std::string _template)
 {
-template<class ReplaceCallback>
-std::string regex_replace(
-	std::string const& _source,
-	std::regex const& _pattern,
-	ReplaceCallback _replace,
-	std::regex_constants::match_flag_type _flags = std::regex_constants::match_default
-)
+	static std::mutex mutex;
+	static std::unordered_map<std::string, std::shared_ptr<Template const>> cache;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (auto it = cache.find(_template); it != cache.end())
+			return it->second;
+	}
+
+	checkTemplateValid(_template);
+	std::unique_ptr<Template> parsed = parse(_template);
+	parsed->tags = collectTags(_template);
+	std::shared_ptr<Template const> compiled = std::move(parsed);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (cache.size() >= maxCachedTemplates)
+		cache.clear();
+	cache.emplace(std::move(_template), compiled);
+	return compiled;
+}
+
+void Whiskers::checkTemplateValid(std::string const& _template)
 {
-	std::sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	std::sregex_iterator matchEnd;
-	std::string::const_iterator lastMatchedPos(_source.cbegin());
-	std::string result;
-	while (curMatch != matchEnd)
+	// Every tag starting with one of "#?!/" has to be closed by ">" directly after the name.
+	for (size_t start = _template.find('<'); start != std::string::npos; start = _template.find('<', start + 1))
+	{
+		size_t nameStart = start + 1;
+		if (nameStart >= _template.size() || std::string("#?!/").find(_template[nameStart]) == std::string::npos)
+			continue;
+		++nameStart;
+		if (nameStart < _template.size() && _template[nameStart] == '+')
+			++nameStart;
+		size_t const nameEnd = parameterEnd(_template, nameStart);
+		if (nameEnd == nameStart)
+			continue;
+		assertThrow(
+			nameEnd < _template.size() && _template[nameEnd] == '>',
+			WhiskersError,
+			"Template contains an invalid/unclosed tag " + _template.substr(start, nameEnd + 1 - start)
+		);
+	}
+}
+
+std::unique_ptr<Whiskers::Template> Whiskers::parse(std::string _source)
+{
+	auto result = std::make_unique<Template>();
+	result->source = std::move(_source);
+	std::string const& source = result->source;
+
+	std::string text;
+	auto addPart = [&](Template::Part _part) {
+		if (!text.empty())
+			result->parts.push_back({Template::Part::Kind::Text, std::move(text), nullptr, nullptr});
+		text.clear();
+		result->parts.push_back(std::move(_part));
+	};
+
+	// The first tag found from left to right is replaced. The body of a list or condition extends
+	// to the first matching closing tag, tags with the same name cannot be nested.
+	// Anything that does not form a complete tag is kept as it is.
+	size_t position = 0;
+	while (position < source.size())
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		size_t const start = source.find('<', position);
+		if (start == std::string::npos)
+			break;
+		text.append(source, position, start + 1 - position);
+		position = start + 1;
+
+		char const kind = start + 1 < source.size() ? source[start + 1] : '\0';
+		size_t nameStart = start + 1;
+		if (kind == '#' || kind == '?')
+			++nameStart;
+		if (kind == '?' && nameStart < source.size() && source[nameStart] == '+')
+			++nameStart;
+		size_t const nameEnd = parameterEnd(source, nameStart);
+		if (nameEnd == nameStart || nameEnd >= source.size() || source[nameEnd] != '>')
+			continue;
+		size_t const bodyStart = nameEnd + 1;
+
+		if (kind == '#' || kind == '?')
+		{
+			std::string const name = source.substr(start + 2, nameEnd - start - 2);
+			std::string const closingTag = "</" + name + ">";
+			size_t const end = source.find(closingTag, bodyStart);
+			if (end == std::string::npos)
+				continue;
+			text.pop_back();
+
+			Template::Part part{
+				kind == '#' ? Template::Part::Kind::List : Template::Part::Kind::Condition,
+				name,
+				nullptr,
+				nullptr
+			};
+			size_t const elseStart = kind == '?' ? source.find("<!" + name + ">", bodyStart) : std::string::npos;
+			if (elseStart < end)
+			{
+				size_t const elseBodyStart = elseStart + name.size() + 3;
+				part.body = parse(source.substr(bodyStart, elseStart - bodyStart));
+				part.elseBody = parse(source.substr(elseBodyStart, end - elseBodyStart));
+			}
+			else
+			{
+				part.body = parse(source.substr(bodyStart, end - bodyStart));
+				if (kind == '?')
+					part.elseBody = std::make_unique<Template>();
+			}
+			addPart(std::move(part));
+			position = end + closingTag.size();
+		}
+		else
+		{
+			text.pop_back();
+			addPart({Template::Part::Kind::Value, source.substr(nameStart, nameEnd - nameStart), nullptr, nullptr});
+			position = bodyStart;
+		}
 	}
-	result.append(lastMatchedPos, _source.cend());
+	if (position < source.size())
+		text.append(source, position, std::string::npos);
+	if (!text.empty())
+		result->parts.push_back({Template::Part::Kind::Text, std::move(text), nullptr, nullptr});
 	return result;
 }
+
+std::set<std::string> Whiskers::collectTags(std::string const& _template)
+{
+	std::set<std::string> tags;
+	for (size_t start = _template.find('<'); start != std::string::npos; start = _template.find('<', start + 1))
+	{
+		size_t nameStart = start + 1;
+		if (nameStart < _template.size() && std::string("#?/").find(_template[nameStart]) != std::string::npos)
+			++nameStart;
+		size_t const nameEnd = parameterEnd(_template, nameStart);
+		if (nameEnd > nameStart && nameEnd < _template.size() && _template[nameEnd] == '>')
+			tags.insert(_template.substr(start, nameEnd + 1 - start));
+	}
+	return tags;
 }
 
-std::string Whiskers::replace(
-	std::string const& _template,
+void Whiskers::renderTo(
+	std::string& _output,
+	Template const& _template,
 	StringMap const& _parameters,
+	StringMap const* _listElement,
 	std::map<std::string, bool> const& _conditions,
-	std::map<std::string, std::vector<StringMap>> const& _listParameters
+	StringListMap const* _listParameters
 )
 {
-	static std::regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](std::match_results<std::string::const_iterator> _match) -> std::string
-	{
-		std::string tagName(_match[1]);
-		std::string listName(_match[2]);
-		std::string conditionName(_match[4]);
-		if (!tagName.empty())
+	auto findParameter = [&](std::string const& _name) -> std::string const* {
+		if (_listElement)
+			if (auto it = _listElement->find(_name); it != _listElement->end())
+				return &it->second;
+		if (auto it = _parameters.find(_name); it != _parameters.end())
+			return &it->second;
+		return nullptr;
+	};
+
+	for (Template::Part const& part: _template.parts)
+		switch (part.kind)
+		{
+		case Template::Part::Kind::Text:
+			_output += part.text;
+			break;
+		case Template::Part::Kind::Value:
 		{
+			std::string const* value = findParameter(part.text);
 			assertThrow(
-				_parameters.count(tagName),
+				value,
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + part.text + " not provided.\n" +
 				"Template:\n" +
-				_template
+				_template.source
 			);
-			return _parameters.at(tagName);
+			_output += *value;
+			break;
 		}
-		else if (!listName.empty())
+		case Template::Part::Kind::List:
 		{
-			std::string templ(_match[3]);
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				_listParameters && _listParameters->count(part.text),
+				WhiskersError, "List parameter " + part.text + " not set."
 			);
-			std::string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			for (StringMap const& element: _listParameters->at(part.text))
+			{
+				for (auto const& parameter: element)
+					assertThrow(
+						!_parameters.count(parameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				renderTo(_output, *part.body, _parameters, &element, _conditions, nullptr);
+			}
+			break;
 		}
-		else
+		case Template::Part::Kind::Condition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
+			if (part.text[0] == '+')
 			{
-				std::string tag = conditionName.substr(1);
+				std::string tag = part.text.substr(1);
 
-				if (_parameters.count(tag))
-					conditionValue = !_parameters.at(tag).empty();
-				else if (_listParameters.count(tag))
-					conditionValue = !_listParameters.at(tag).empty();
+				if (std::string const* value = findParameter(tag))
+					conditionValue = !value->empty();
+				else if (_listParameters && _listParameters->count(tag))
+					conditionValue = !_listParameters->at(tag).empty();
 				else
 					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
 			}
 			else
 			{
 				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
+					_conditions.count(part.text),
+					WhiskersError, "Condition parameter " + part.text + " not set."
 				);
-				conditionValue = _conditions.at(conditionName);
+				conditionValue = _conditions.at(part.text);
 			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
+			renderTo(
+				_output,
+				conditionValue ? *part.body : *part.elseBody,
 				_parameters,
+				_listElement,
 				_conditions,
 				_listParameters
 			);
+			break;
+		}
 		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
 }
-
@@ -26,8 +26,10 @@
 
 #include <libsolutil/Exceptions.h>
 
-#include <string>
 #include <map>
+#include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 namespace solidity::util
@@ -67,6 +69,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *    Works similar to a conditional parameter where the checked condition is
  *    that the string or list parameter called "name" is non-empty or contains
  *    no elements respectively.
+ *
+ * Templates are parsed only once and kept in a process-wide cache, so constructing
+ * many Whiskers objects from the same template string is cheap.
  */
 class Whiskers
 {
@@ -90,31 +95,39 @@ public:
 	std::string render() const;
 
 private:
+	/// Parsed form of a template or of the body of a list or condition inside a template.
+	struct Template;
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
-	void checkTemplateValid() const;
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
-	/// Checks whether the string stored in `m_template` contains all the tags specified.
+	/// Checks whether the template contains all the tags specified.
 	/// @param _parameter name of the parameter. This name is used to construct the tag(s).
 	/// @param _prefixes a vector of strings, where each element is used to compose the tag
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
+	/// @returns the parsed form of @a _template, taken from the template cache if possible.
+	static std::shared_ptr<Template const> compile(std::string _template);
+	static void checkTemplateValid(std::string const& _template);
+	static std::unique_ptr<Template> parse(std::string _source);
+	/// @returns all tags of the form <name>, <?name>, <#name> and </name> that occur in @a _template.
+	static std::set<std::string> collectTags(std::string const& _template);
+
+	/// Appends the rendered @a _template to @a _output. Inside the body of a list,
+	/// @a _listElement contains the parameters of the current element and there are no list parameters.
+	static void renderTo(
+		std::string& _output,
+		Template const& _template,
 		StringMap const& _parameters,
+		StringMap const* _listElement,
 		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
+		StringListMap const* _listParameters
 	);
 
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
-
-	std::string m_template;
+	std::shared_ptr<Template const> m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
@@ -20,6 +20,7 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/ControlFlowSideEffects.h>
+#include <libyul/YulStringMap.h>
 
 #include <set>
 #include <stack>
@@ -101,7 +102,7 @@ public:
 		return m_functionSideEffects;
 	}
 	/// Returns the side effects by function name, requires unique function names.
-	std::map<YulString, ControlFlowSideEffects> functionSideEffectsNamed() const;
+	YulStringMap<ControlFlowSideEffects> functionSideEffectsNamed() const;
 private:
 
 	/// @returns false if nothing could be processed.
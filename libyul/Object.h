@@ -34,6 +34,11 @@
 #include <set>
 #include <limits>
 
+namespace solidity::evmasm
+{
+class Assembly;
+}
+
 namespace solidity::yul
 {
 struct Dialect;
@@ -126,6 +131,11 @@ public:
 
 	std::shared_ptr<ObjectDebugData const> debugData;
 
+	/// Optimized EVM assembly of this object if it was compiled before as the top-level object
+	/// of another stack. The code and sub-objects of such an object are shared with that stack
+	/// and are neither analyzed, optimized nor compiled again.
+	std::shared_ptr<evmasm::Assembly> compiledAssembly;
+
 	/// @returns the name of the special metadata data object.
 	static std::string metadataName() { return ".metadata"; }
 };
@@ -35,9 +35,13 @@
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
 #include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
 
 #include <boost/algorithm/string.hpp>
 
+#include <functional>
+#include <map>
 #include <optional>
 
 using namespace solidity;
@@ -61,6 +65,30 @@ Dialect const& languageToDialect(YulStack::Language _language, EVMVersion _versi
 	return Dialect::yulDeprecated();
 }
 
+Json profileToJson(std::string const& _objectName, OptimiserProfile const& _profile)
+{
+	Json steps = Json::array();
+	for (OptimiserProfile::StepRun const& stepRun: _profile.stepRuns)
+		steps.emplace_back(Json{
+			{"step", stepRun.step},
+			{"durationMicroseconds", stepRun.durationInMicroseconds},
+			{"nodesBefore", stepRun.nodesBefore},
+			{"nodesAfter", stepRun.nodesAfter},
+			{"codeSizeChange", static_cast<int64_t>(stepRun.codeSizeAfter) - static_cast<int64_t>(stepRun.codeSizeBefore)}
+		});
+	Json repetitions = Json::array();
+	for (OptimiserProfile::Repetition const& repetition: _profile.repetitions)
+		repetitions.emplace_back(Json{
+			{"sequence", repetition.sequence},
+			{"rounds", repetition.rounds}
+		});
+	return Json{
+		{"object", _objectName},
+		{"steps", std::move(steps)},
+		{"repetitions", std::move(repetitions)}
+	};
+}
+
 }
 
 
@@ -106,7 +134,7 @@ bool YulStack::parseAndAnalyze(std::string const& _sourceName, std::string const
 	return analyzeParsed();
 }
 
-void YulStack::optimize()
+void YulStack::optimize(size_t _concurrency)
 {
 	yulAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	yulAssert(m_parserResult);
@@ -120,7 +148,51 @@ void YulStack::optimize()
 			return;
 
 		m_stackState = Parsed;
-		optimize(*m_parserResult, true);
+
+		// An object only has to be optimized after its sub-objects, so all objects of the same
+		// height in the object tree are optimized concurrently, starting with the leaves.
+		std::vector<std::vector<std::pair<Object*, bool>>> objectsByHeight;
+		std::function<size_t(Object&, bool)> collectObjects = [&](Object& _object, bool _isCreation) -> size_t {
+			size_t height = 0;
+			for (auto& subNode: _object.subObjects)
+				if (auto subObject = dynamic_cast<Object*>(subNode.get()); subObject && !subObject->compiledAssembly)
+				{
+					bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
+					height = std::max(height, collectObjects(*subObject, isCreation) + 1);
+				}
+			if (objectsByHeight.size() <= height)
+				objectsByHeight.resize(height + 1);
+			objectsByHeight[height].emplace_back(&_object, _isCreation);
+			return height;
+		};
+		collectObjects(*m_parserResult, true);
+
+		// Every object gets its own profile, so that concurrent optimizations do not share one.
+		std::map<Object const*, OptimiserProfile> profiles;
+		if (m_optimiserSettings.profileYulOptimiser)
+			for (auto const& objects: objectsByHeight)
+				for (auto const& object: objects)
+					profiles[object.first];
+
+		for (auto const& objects: objectsByHeight)
+		{
+			// Threads not needed for separate objects are used to optimize functions concurrently.
+			size_t const functionConcurrency = std::max<size_t>(
+				1,
+				util::effectiveConcurrency(_concurrency) / objects.size()
+			);
+			util::parallelFor(_concurrency, objects.size(), [&](size_t _index) {
+				Object* object = objects[_index].first;
+				optimize(*object, objects[_index].second, functionConcurrency, util::valueOrNullptr(profiles, object));
+			});
+		}
+		if (m_optimiserSettings.profileYulOptimiser)
+		{
+			m_optimiserProfile = Json::array();
+			for (auto const& objects: objectsByHeight)
+				for (auto const& object: objects)
+					m_optimiserProfile.emplace_back(profileToJson(object.first->name.str(), profiles.at(object.first)));
+		}
 		yulAssert(analyzeParsed(), "Invalid source code after optimization.");
 	}
 	catch (UnimplementedFeatureError const& _error)
@@ -129,6 +201,30 @@ void YulStack::optimize()
 	}
 }
 
+void YulStack::reuseCompiledObject(YulStack const& _stack, std::shared_ptr<evmasm::Assembly> _assembly)
+{
+	yulAssert(m_stackState >= AnalysisSuccessful);
+	yulAssert(_stack.m_stackState >= AnalysisSuccessful);
+	yulAssert(_stack.m_parserResult && _assembly);
+
+	// The copy only shares the code and sub-objects, so that the sub ID assigned during
+	// compilation is not shared.
+	auto compiledObject = std::make_shared<Object>(*_stack.m_parserResult);
+	compiledObject->compiledAssembly = std::move(_assembly);
+
+	std::function<void(Object&)> replaceSubObjects = [&](Object& _object) {
+		for (auto& subNode: _object.subObjects)
+			if (auto subObject = dynamic_cast<Object*>(subNode.get()); subObject && !subObject->compiledAssembly)
+			{
+				if (subObject->name == compiledObject->name)
+					subNode = compiledObject;
+				else
+					replaceSubObjects(*subObject);
+			}
+	};
+	replaceSubObjects(*m_parserResult);
+}
+
 bool YulStack::analyzeParsed()
 {
 	yulAssert(m_stackState >= Parsed);
@@ -155,7 +251,7 @@ bool YulStack::analyzeParsed(Object& _object)
 	{
 		success = analyzer.analyze(*_object.code);
 		for (auto& subNode: _object.subObjects)
-			if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+			if (auto subObject = dynamic_cast<Object*>(subNode.get()); subObject && !subObject->compiledAssembly)
 				if (!analyzeParsed(*subObject))
 					success = false;
 	}
@@ -191,16 +287,10 @@ void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_eofVersion);
 }
 
-void YulStack::optimize(Object& _object, bool _isCreation)
+void YulStack::optimize(Object& _object, bool _isCreation, size_t _concurrency, OptimiserProfile* _profile)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
-	for (auto& subNode: _object.subObjects)
-		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-		{
-			bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
-			optimize(*subObject, isCreation);
-		}
 
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
 	std::unique_ptr<GasMeter> meter;
@@ -241,7 +331,9 @@ void YulStack::optimize(Object& _object, bool _isCreation)
 		yulOptimiserSteps,
 		yulOptimiserCleanupSteps,
 		_isCreation ? std::nullopt : std::make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
+		{},
+		_concurrency,
+		_profile
 	);
 }
 
@@ -262,9 +354,9 @@ MachineAssemblyObject YulStack::assemble(Machine _machine)
 }
 
 std::pair<MachineAssemblyObject, MachineAssemblyObject>
-YulStack::assembleWithDeployed(std::optional<std::string_view> _deployName)
+YulStack::assembleWithDeployed(std::optional<std::string_view> _deployName, size_t _concurrency)
 {
-	auto [creationAssembly, deployedAssembly] = assembleEVMWithDeployed(_deployName);
+	auto [creationAssembly, deployedAssembly] = assembleEVMWithDeployed(_deployName, _concurrency);
 	yulAssert(creationAssembly, "");
 	yulAssert(m_charStream, "");
 
@@ -272,7 +364,7 @@ YulStack::assembleWithDeployed(std::optional<std::string_view> _deployName)
 	MachineAssemblyObject deployedObject;
 	try
 	{
-		creationObject.bytecode = std::make_shared<evmasm::LinkerObject>(creationAssembly->assemble());
+		creationObject.bytecode = std::make_shared<evmasm::LinkerObject>(creationAssembly->assemble(_concurrency));
 		yulAssert(creationObject.bytecode->immutableReferences.empty(), "Leftover immutables.");
 		creationObject.assembly = creationAssembly->assemblyString(m_debugInfoSelection);
 		creationObject.sourceMappings = std::make_unique<std::string>(
@@ -303,7 +395,11 @@ YulStack::assembleWithDeployed(std::optional<std::string_view> _deployName)
 }
 
 std::pair<std::shared_ptr<evmasm::Assembly>, std::shared_ptr<evmasm::Assembly>>
-YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName)
+YulStack::assembleEVMWithDeployed(
+	std::optional<std::string_view> _deployName,
+	size_t _concurrency,
+	std::vector<util::PhaseUsage>* _phases
+)
 {
 	yulAssert(m_stackState >= AnalysisSuccessful);
 	yulAssert(m_parserResult, "");
@@ -322,9 +418,18 @@ YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName)
 	);
 	try
 	{
-		compileEVM(adapter, optimize);
+		{
+			util::ScopedPhaseMeasurement measurement(_phases, "evmCodeTransform");
+			compileEVM(adapter, optimize);
+		}
 
-		assembly.optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion));
+		{
+			util::ScopedPhaseMeasurement measurement(_phases, "evmasmOptimization");
+			assembly.optimise(
+				evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion),
+				_concurrency
+			);
+		}
 
 		std::optional<size_t> subIndex;
 
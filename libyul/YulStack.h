@@ -26,6 +26,7 @@
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/EVMVersion.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/ResourceUsage.h>
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
@@ -36,6 +37,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace solidity::evmasm
 {
@@ -50,6 +52,7 @@ class Scanner;
 namespace solidity::yul
 {
 class AbstractAssembly;
+struct OptimiserProfile;
 
 
 struct MachineAssemblyObject
@@ -107,7 +110,17 @@ public:
 
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
-	void optimize();
+	/// @param _concurrency maximum number of threads used to optimize different objects and
+	///                     functions concurrently. Zero selects the number of hardware threads.
+	/// If the settings request it, the work done by the optimizer is recorded (see optimiserProfile).
+	void optimize(size_t _concurrency = 1);
+
+	/// Replaces the sub-objects of the parsed object, at any depth, that have the name of the
+	/// top-level object of @a _stack by that object, whose optimized assembly is @a _assembly.
+	/// The replaced sub-objects have to be parsed from the same source as the object of @a _stack
+	/// and that stack has to use the same settings. The replacing object is neither optimized
+	/// nor compiled again.
+	void reuseCompiledObject(YulStack const& _stack, std::shared_ptr<evmasm::Assembly> _assembly);
 
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	MachineAssemblyObject assemble(Machine _machine);
@@ -116,17 +129,24 @@ public:
 	/// In addition to the value returned by @a assemble, returns
 	/// a second object that is the runtime code.
 	/// Only available for EVM.
+	/// @param _concurrency maximum number of threads used to optimize and assemble different
+	///                     sub-assemblies concurrently (see evmasm::Assembly::optimise).
 	std::pair<MachineAssemblyObject, MachineAssemblyObject>
 	assembleWithDeployed(
-		std::optional<std::string_view> _deployName = {}
+		std::optional<std::string_view> _deployName = {},
+		size_t _concurrency = 1
 	);
 
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	/// Similar to @a assemblyWithDeployed, but returns EVM assembly objects.
 	/// Only available for EVM.
+	/// @param _phases if not null, the time and memory taken by code transform and
+	///                evmasm optimisation are appended to it.
 	std::pair<std::shared_ptr<evmasm::Assembly>, std::shared_ptr<evmasm::Assembly>>
 	assembleEVMWithDeployed(
-		std::optional<std::string_view> _deployName = {}
+		std::optional<std::string_view> _deployName = {},
+		size_t _concurrency = 1,
+		std::vector<util::PhaseUsage>* _phases = nullptr
 	);
 
 	/// @returns the errors generated during parsing, analysis (and potentially assembly).
@@ -137,6 +157,10 @@ public:
 		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr
 	) const;
 	Json astJson() const;
+	/// @returns the work done by the optimizer suite on each object, in the order of optimization,
+	/// if the settings requested it. Objects reused from other stacks are not included.
+	/// Null if the optimizer did not run.
+	Json const& optimiserProfile() const { return m_optimiserProfile; }
 	/// Return the parsed and analyzed object.
 	std::shared_ptr<Object> parserResult() const;
 
@@ -147,7 +171,9 @@ private:
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	/// Optimizes the code of @a _object, but not the code of its sub-objects.
+	/// Records the work done by the optimizer suite in @a _profile if it is not null.
+	void optimize(yul::Object& _object, bool _isCreation, size_t _concurrency, OptimiserProfile* _profile);
 
 	void reportUnimplementedFeatureError(langutil::UnimplementedFeatureError const& _error);
 
@@ -165,6 +191,8 @@ private:
 	langutil::ErrorReporter m_errorReporter;
 
 	std::unique_ptr<std::string> m_sourceMappings;
+
+	Json m_optimiserProfile;
 };
 
 }
@@ -21,10 +21,18 @@
 
 #pragma once
 
+#include <libsolutil/Assertions.h>
+#include <libsolutil/Exceptions.h>
+
 #include <fmt/format.h>
 
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -36,6 +44,11 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+/// The repository is shared by all threads. To keep contention low, it is split into shards
+/// selected by the string hash, each of which is guarded by its own reader-writer lock.
+/// The lower bits of an ID denote the shard, the upper bits the index inside the shard.
+/// The locks are only needed to look up and add strings. Resolving an ID does not lock, since the
+/// strings of a shard are stored in chunks that are never moved or modified once published.
 class YulStringRepository
 {
 public:
@@ -56,17 +69,27 @@ public:
 		if (_string.empty())
 			return { 0, emptyHash() };
 		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
+		size_t shardIndex = static_cast<size_t>(h % shardCount);
+		Shard& shard = m_shards[shardIndex];
+		{
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+			if (auto id = shard.find(_string, h))
+				return Handle{*id, h};
+		}
+		std::unique_lock<std::shared_mutex> lock(shard.mutex);
+		// Another thread might have added the string in the meantime.
+		if (auto id = shard.find(_string, h))
+			return Handle{*id, h};
+		size_t id = (shard.add(_string) << shardBits) | shardIndex;
+		shard.hashToID.emplace(h, id);
 
 		return Handle{id, h};
 	}
-	std::string const& idToString(size_t _id) const { return *m_strings.at(_id); }
+	/// Lock-free, since an ID can only be known after its string was published.
+	std::string const& idToString(size_t _id) const
+	{
+		return m_shards[_id & (shardCount - 1)].at(_id >> shardBits);
+	}
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -82,14 +105,24 @@ public:
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
 	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Use with care - there cannot be any dangling YulString references and no other
+	/// thread may use the repository concurrently.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
 	static void reset()
 	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
+		{
+			std::lock_guard<std::mutex> lock(resetCallbacksMutex());
+			for (auto const& cb: resetCallbacks())
+				cb();
+		}
+		YulStringRepository& repository = instance();
+		for (Shard& shard: repository.m_shards)
+		{
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+			shard.clear();
+		}
+		repository.addEmptyString();
 	}
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
@@ -97,25 +130,93 @@ public:
 	{
 		ResetCallback(std::function<void()> _fun)
 		{
+			std::lock_guard<std::mutex> lock(YulStringRepository::resetCallbacksMutex());
 			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
 		}
 	};
 
 private:
-	YulStringRepository() = default;
+	static constexpr size_t shardBits = 4;
+	static constexpr size_t shardCount = size_t(1) << shardBits;
+
+	struct Shard
+	{
+		static constexpr size_t chunkBits = 10;
+		static constexpr size_t chunkSize = size_t(1) << chunkBits;
+		static constexpr size_t maxChunks = size_t(1) << 14;
+
+		std::optional<size_t> find(std::string const& _string, std::uint64_t _hash) const
+		{
+			auto range = hashToID.equal_range(_hash);
+			for (auto it = range.first; it != range.second; ++it)
+				if (at(it->second >> shardBits) == _string)
+					return it->second;
+			return std::nullopt;
+		}
+
+		std::string const& at(size_t _index) const
+		{
+			return chunks[_index >> chunkBits].load(std::memory_order_acquire)[_index & (chunkSize - 1)];
+		}
+
+		/// Appends @a _string and @returns its index. Requires the exclusive lock.
+		size_t add(std::string const& _string)
+		{
+			size_t index = size++;
+			size_t chunk = index >> chunkBits;
+			assertThrow(chunk < maxChunks, util::Exception, "Too many distinct Yul strings.");
+			bool const newChunk = chunk == ownedChunks.size();
+			if (newChunk)
+				ownedChunks.emplace_back(std::make_unique<std::string[]>(chunkSize));
+			ownedChunks[chunk][index & (chunkSize - 1)] = _string;
+			// Readers only resolve the index after obtaining the ID, i.e. under the shard mutex or through
+			// whatever hands the ID to their thread, which orders this write before their read.
+			// The release store only publishes the chunk pointer, and only after the string is in place.
+			if (newChunk)
+				chunks[chunk].store(ownedChunks.back().get(), std::memory_order_release);
+			return index;
+		}
+
+		/// Removes all strings. Requires that no other thread uses the shard.
+		void clear()
+		{
+			for (size_t chunk = 0; chunk < ownedChunks.size(); ++chunk)
+				chunks[chunk].store(nullptr, std::memory_order_relaxed);
+			ownedChunks.clear();
+			size = 0;
+			hashToID.clear();
+		}
+
+		std::array<std::atomic<std::string const*>, maxChunks> chunks{};
+		std::vector<std::unique_ptr<std::string[]>> ownedChunks;
+		size_t size = 0;
+		std::unordered_multimap<std::uint64_t, size_t> hashToID;
+		mutable std::shared_mutex mutex;
+	};
+
+	YulStringRepository() { addEmptyString(); }
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+
+	/// Registers the empty string with ID zero, i.e. at index zero of shard zero.
+	void addEmptyString()
+	{
+		std::unique_lock<std::shared_mutex> lock(m_shards[0].mutex);
+		m_shards[0].add({});
+	}
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
 		static std::vector<std::function<void()>> callbacks;
 		return callbacks;
 	}
+	static std::mutex& resetCallbacksMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<Shard, shardCount> m_shards;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -150,6 +251,9 @@ public:
 	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
 
 	bool empty() const { return m_handle.id == 0; }
+	/// @returns the ID of the string in the repository. It depends on the order in which
+	/// strings were created and must not influence the output of the compiler.
+	size_t id() const { return m_handle.id; }
 	std::string const& str() const
 	{
 		return YulStringRepository::instance().idToString(m_handle.id);
@@ -0,0 +1,299 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Flat hash maps and sets keyed by YulStrings.
+ */
+
+#pragma once
+
+#include <libyul/Exceptions.h>
+#include <libyul/YulString.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul
+{
+
+namespace detail
+{
+
+inline YulString const& keyOf(YulString const& _entry) { return _entry; }
+template <typename Value>
+YulString const& keyOf(std::pair<YulString const, Value> const& _entry) { return _entry.first; }
+
+/// Hash table with open addressing and linear probing, which locates entries by the
+/// repository ID of their YulString key. In contrast to std::map and std::unordered_map,
+/// lookups neither compare string hashes along a tree nor follow pointers to nodes.
+///
+/// The IDs are shared by all code compiled in a process, so they are not dense enough
+/// to be used as indices of a table local to a single optimiser step.
+///
+/// The iteration order depends on the IDs, which depend on the order in which the strings
+/// were created. It must not influence the output of the compiler.
+/// Inserting or erasing entries invalidates all iterators.
+template <typename Entry>
+class YulStringTable
+{
+	using Slots = std::vector<std::optional<Entry>>;
+
+public:
+	template <bool Const>
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Entry;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, Entry const*, Entry*>;
+		using reference = std::conditional_t<Const, Entry const&, Entry&>;
+
+		Iterator() = default;
+		Iterator(std::conditional_t<Const, Slots const*, Slots*> _slots, size_t _index):
+			m_slots(_slots), m_index(_index)
+		{
+			skipEmptySlots();
+		}
+
+		reference operator*() const { return *(*m_slots)[m_index]; }
+		pointer operator->() const { return &*(*m_slots)[m_index]; }
+		Iterator& operator++()
+		{
+			++m_index;
+			skipEmptySlots();
+			return *this;
+		}
+		Iterator operator++(int)
+		{
+			Iterator previous = *this;
+			++*this;
+			return previous;
+		}
+		bool operator==(Iterator const& _other) const { return m_index == _other.m_index; }
+		bool operator!=(Iterator const& _other) const { return m_index != _other.m_index; }
+
+	private:
+		void skipEmptySlots()
+		{
+			while (m_index < m_slots->size() && !(*m_slots)[m_index])
+				++m_index;
+		}
+
+		std::conditional_t<Const, Slots const*, Slots*> m_slots = nullptr;
+		size_t m_index = 0;
+	};
+
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
+	bool empty() const { return m_size == 0; }
+	size_t size() const { return m_size; }
+
+	iterator begin() { return {&m_slots, 0}; }
+	iterator end() { return {&m_slots, m_slots.size()}; }
+	const_iterator begin() const { return {&m_slots, 0}; }
+	const_iterator end() const { return {&m_slots, m_slots.size()}; }
+
+	iterator find(YulString _key) { return {&m_slots, findSlot(_key)}; }
+	const_iterator find(YulString _key) const { return {&m_slots, findSlot(_key)}; }
+	size_t count(YulString _key) const { return findSlot(_key) == m_slots.size() ? 0 : 1; }
+
+	/// Constructs an entry from @a _args unless there is an entry for @a _key already.
+	/// @returns the entry for @a _key and whether it was inserted.
+	template <typename... Args>
+	std::pair<iterator, bool> emplaceEntry(YulString _key, Args&&... _args)
+	{
+		if (size_t slot = findSlot(_key); slot != m_slots.size())
+			return {iterator{&m_slots, slot}, false};
+		if ((m_size + 1) * 4 > m_slots.size() * 3)
+			grow();
+		size_t slot = homeSlot(_key);
+		while (m_slots[slot])
+			slot = (slot + 1) & (m_slots.size() - 1);
+		m_slots[slot].emplace(std::forward<Args>(_args)...);
+		++m_size;
+		return {iterator{&m_slots, slot}, true};
+	}
+
+	size_t erase(YulString _key)
+	{
+		size_t slot = findSlot(_key);
+		if (slot == m_slots.size())
+			return 0;
+		eraseSlot(slot);
+		return 1;
+	}
+	/// Erases all entries for which @a _predicate is true.
+	template <typename Predicate>
+	void eraseIf(Predicate const& _predicate)
+	{
+		// Erasing moves entries backwards, possibly across the end of the table,
+		// so the entries to be erased are collected first.
+		std::vector<YulString> keys;
+		for (Entry const& entry: *this)
+			if (_predicate(entry))
+				keys.emplace_back(keyOf(entry));
+		for (YulString key: keys)
+			erase(key);
+	}
+	void clear()
+	{
+		m_slots.clear();
+		m_size = 0;
+	}
+
+private:
+	size_t homeSlot(YulString _key) const
+	{
+		// Fibonacci hashing spreads consecutive IDs over the whole table.
+		return static_cast<size_t>((static_cast<std::uint64_t>(_key.id()) * 0x9E3779B97F4A7C15u) >> m_shift);
+	}
+
+	/// @returns the slot of the entry for @a _key or the number of slots if there is none.
+	size_t findSlot(YulString _key) const
+	{
+		if (m_slots.empty())
+			return 0;
+		for (size_t slot = homeSlot(_key); m_slots[slot]; slot = (slot + 1) & (m_slots.size() - 1))
+			if (keyOf(*m_slots[slot]) == _key)
+				return slot;
+		return m_slots.size();
+	}
+
+	/// Empties @a _slot and moves entries after it backwards, so that no entry is
+	/// separated from its home slot by an empty slot.
+	void eraseSlot(size_t _slot)
+	{
+		size_t const mask = m_slots.size() - 1;
+		m_slots[_slot].reset();
+		--m_size;
+		for (size_t next = (_slot + 1) & mask; m_slots[next]; next = (next + 1) & mask)
+		{
+			size_t home = homeSlot(keyOf(*m_slots[next]));
+			// The entry stays if its home slot is cyclically in (_slot, next].
+			bool stays = _slot <= next ? (_slot < home && home <= next) : (_slot < home || home <= next);
+			if (stays)
+				continue;
+			m_slots[_slot].emplace(std::move(*m_slots[next]));
+			m_slots[next].reset();
+			_slot = next;
+		}
+	}
+
+	void grow()
+	{
+		Slots oldSlots = std::move(m_slots);
+		size_t const capacity = oldSlots.empty() ? 16 : oldSlots.size() * 2;
+		m_slots = Slots(capacity);
+		m_shift = 64;
+		for (size_t i = capacity; i > 1; i >>= 1)
+			--m_shift;
+		for (std::optional<Entry>& entry: oldSlots)
+			if (entry)
+			{
+				size_t slot = homeSlot(keyOf(*entry));
+				while (m_slots[slot])
+					slot = (slot + 1) & (capacity - 1);
+				m_slots[slot].emplace(std::move(*entry));
+			}
+	}
+
+	/// Number of slots is zero or a power of two.
+	Slots m_slots;
+	size_t m_size = 0;
+	/// 64 minus the binary logarithm of the number of slots.
+	unsigned m_shift = 64;
+};
+
+}
+
+/// Map from YulStrings to values with the interface of std::map, but without order.
+/// at() asserts that the key is present instead of throwing std::out_of_range.
+/// See detail::YulStringTable for the restrictions.
+template <typename Value>
+class YulStringMap: public detail::YulStringTable<std::pair<YulString const, Value>>
+{
+	using Table = detail::YulStringTable<std::pair<YulString const, Value>>;
+
+public:
+	using key_type = YulString;
+	using mapped_type = Value;
+	using value_type = std::pair<YulString const, Value>;
+	using typename Table::iterator;
+
+	template <typename... Args>
+	std::pair<iterator, bool> try_emplace(YulString _key, Args&&... _args)
+	{
+		return this->emplaceEntry(
+			_key,
+			std::piecewise_construct,
+			std::forward_as_tuple(_key),
+			std::forward_as_tuple(std::forward<Args>(_args)...)
+		);
+	}
+	std::pair<iterator, bool> insert(value_type _entry)
+	{
+		return this->emplaceEntry(_entry.first, std::move(_entry));
+	}
+	Value& operator[](YulString _key) { return try_emplace(_key).first->second; }
+	Value& at(YulString _key)
+	{
+		auto it = this->find(_key);
+		yulAssert(it != this->end(), "No entry for " + _key.str() + ".");
+		return it->second;
+	}
+	Value const& at(YulString _key) const
+	{
+		auto it = this->find(_key);
+		yulAssert(it != this->end(), "No entry for " + _key.str() + ".");
+		return it->second;
+	}
+};
+
+/// Set of YulStrings with the interface of std::set, but without order.
+/// See detail::YulStringTable for the restrictions.
+class YulStringSet: public detail::YulStringTable<YulString>
+{
+public:
+	using key_type = YulString;
+	using value_type = YulString;
+
+	YulStringSet() = default;
+	template <typename Range>
+	explicit YulStringSet(Range const& _range)
+	{
+		for (YulString element: _range)
+			insert(element);
+	}
+
+	std::pair<iterator, bool> insert(YulString _element) { return emplaceEntry(_element, _element); }
+	std::pair<iterator, bool> emplace(YulString _element) { return insert(_element); }
+	YulStringSet& operator+=(YulStringSet const& _other)
+	{
+		for (YulString element: _other)
+			insert(element);
+		return *this;
+	}
+};
+
+}
@@ -42,6 +42,7 @@ struct SourceLocation;
 namespace solidity::evmasm
 {
 enum class Instruction: uint8_t;
+class Assembly;
 }
 
 namespace solidity::yul
@@ -100,6 +101,9 @@ public:
 	virtual void appendAssemblySize() = 0;
 	/// Creates a new sub-assembly, which can be referenced using dataSize and dataOffset.
 	virtual std::pair<std::shared_ptr<AbstractAssembly>, SubID> createSubAssembly(bool _creation, std::string _name = "") = 0;
+	/// Adds an EVM assembly that was compiled before as a sub-assembly, which can be referenced
+	/// using dataSize and dataOffset.
+	virtual SubID appendSubAssembly(std::shared_ptr<evmasm::Assembly> _assembly) = 0;
 	/// Appends the offset of the given sub-assembly or data.
 	virtual void appendDataOffset(std::vector<SubID> const& _subPath) = 0;
 	/// Appends the size of the given sub-assembly or data.
@@ -53,7 +53,12 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 
 
 	for (auto const& subNode: _object.subObjects)
-		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
+		if (auto* subObject = dynamic_cast<Object*>(subNode.get()); subObject && subObject->compiledAssembly)
+		{
+			context.subIDs[subObject->name] = m_assembly.appendSubAssembly(subObject->compiledAssembly);
+			subObject->subId = context.subIDs[subObject->name];
+		}
+		else if (subObject)
 		{
 			bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
 			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name.str());
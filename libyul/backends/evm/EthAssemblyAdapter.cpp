@@ -128,6 +128,11 @@ std::pair<std::shared_ptr<AbstractAssembly>, AbstractAssembly::SubID> EthAssembl
 	return {std::make_shared<EthAssemblyAdapter>(*assembly), static_cast<size_t>(sub.data())};
 }
 
+AbstractAssembly::SubID EthAssemblyAdapter::appendSubAssembly(std::shared_ptr<evmasm::Assembly> _assembly)
+{
+	return static_cast<size_t>(m_assembly.newSub(std::move(_assembly)).data());
+}
+
 void EthAssemblyAdapter::appendDataOffset(std::vector<AbstractAssembly::SubID> const& _subPath)
 {
 	if (auto it = m_dataHashBySubId.find(_subPath[0]); it != m_dataHashBySubId.end())
@@ -103,6 +103,12 @@ std::pair<std::shared_ptr<AbstractAssembly>, AbstractAssembly::SubID> NoOutputAs
 	return {};
 }
 
+AbstractAssembly::SubID NoOutputAssembly::appendSubAssembly(std::shared_ptr<evmasm::Assembly>)
+{
+	yulAssert(false, "Sub assemblies not implemented.");
+	return {};
+}
+
 void NoOutputAssembly::appendDataOffset(std::vector<AbstractAssembly::SubID> const&)
 {
 	appendInstruction(evmasm::Instruction::PUSH1);
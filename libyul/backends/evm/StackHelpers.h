@@ -19,6 +19,7 @@
 #pragma once
 
 #include <libyul/backends/evm/ControlFlowGraph.h>
+#include <libyul/backends/evm/StackLayoutCache.h>
 #include <libyul/Exceptions.h>
 
 #include <libsolutil/Visitor.h>
@@ -429,6 +430,8 @@ private:
 /// @a _pushOrDup is a function with signature void(StackSlot const&) that is called to push or dup the slot given as
 /// its argument to the stack top.
 /// @a _pop is a function with signature void() that is called when the top most slot is popped.
+/// The operations only depend on the pattern of the two stacks, so they are recorded and replayed
+/// for all stacks with the same pattern.
 template<typename Swap, typename PushOrDup, typename Pop>
 void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _swap, PushOrDup _pushOrDup, Pop _pop)
 {
@@ -439,19 +442,22 @@ void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _sw
 		Swap swapCallback;
 		PushOrDup pushOrDupCallback;
 		Pop popCallback;
+		std::vector<StackShuffleOperation>* operations;
 		Multiplicity multiplicity;
 		ShuffleOperations(
 			Stack& _currentStack,
 			Stack const& _targetStack,
 			Swap _swap,
 			PushOrDup _pushOrDup,
-			Pop _pop
+			Pop _pop,
+			std::vector<StackShuffleOperation>* _operations
 		):
 			currentStack(_currentStack),
 			targetStack(_targetStack),
 			swapCallback(_swap),
 			pushOrDupCallback(_pushOrDup),
-			popCallback(_pop)
+			popCallback(_pop),
+			operations(_operations)
 		{
 			for (auto const& slot: currentStack)
 				--multiplicity[slot];
@@ -480,6 +486,8 @@ void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _sw
 		}
 		void swap(size_t _i)
 		{
+			if (operations)
+				operations->push_back({StackShuffleOperation::Kind::Swap, static_cast<uint32_t>(_i)});
 			swapCallback(static_cast<unsigned>(_i));
 			std::swap(currentStack.at(currentStack.size() - _i - 1), currentStack.back());
 		}
@@ -487,18 +495,65 @@ void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _sw
 		size_t targetSize() { return targetStack.size(); }
 		void pop()
 		{
+			if (operations)
+				operations->push_back({StackShuffleOperation::Kind::Pop, 0});
 			popCallback();
 			currentStack.pop_back();
 		}
 		void pushOrDupTarget(size_t _offset)
 		{
+			if (operations)
+				operations->push_back({StackShuffleOperation::Kind::PushOrDup, static_cast<uint32_t>(_offset)});
 			auto const& targetSlot = targetStack.at(_offset);
 			pushOrDupCallback(targetSlot);
 			currentStack.push_back(targetSlot);
 		}
 	};
 
-	Shuffler<ShuffleOperations>::shuffle(_currentStack, _targetStack, _swap, _pushOrDup, _pop);
+	std::optional<StackPattern> pattern;
+	if (StackLayoutCaches::enabled())
+		pattern = StackPattern::create({&_currentStack, &_targetStack});
+	std::optional<std::vector<StackShuffleOperation>> cachedOperations;
+	if (pattern)
+		cachedOperations = StackLayoutCaches::shuffles().find(pattern->key());
+
+	if (cachedOperations)
+	{
+		// Replay the operations exactly like the shuffler performed them.
+		for (StackShuffleOperation const& operation: *cachedOperations)
+			switch (operation.kind)
+			{
+			case StackShuffleOperation::Kind::Swap:
+				_swap(static_cast<unsigned>(operation.argument));
+				std::swap(_currentStack.at(_currentStack.size() - operation.argument - 1), _currentStack.back());
+				break;
+			case StackShuffleOperation::Kind::PushOrDup:
+			{
+				auto const& targetSlot = _targetStack.at(operation.argument);
+				_pushOrDup(targetSlot);
+				_currentStack.push_back(targetSlot);
+				break;
+			}
+			case StackShuffleOperation::Kind::Pop:
+				_pop();
+				_currentStack.pop_back();
+				break;
+			}
+	}
+	else
+	{
+		std::vector<StackShuffleOperation> operations;
+		Shuffler<ShuffleOperations>::shuffle(
+			_currentStack,
+			_targetStack,
+			_swap,
+			_pushOrDup,
+			_pop,
+			pattern ? &operations : nullptr
+		);
+		if (pattern)
+			StackLayoutCaches::shuffles().insert(pattern->key(), std::move(operations));
+	}
 
 	yulAssert(_currentStack.size() == _targetStack.size(), "");
 	for (auto&& [current, target]: ranges::zip_view(_currentStack, _targetStack))
@@ -0,0 +1,126 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/backends/evm/StackLayoutCache.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+std::optional<uint32_t> findSlot(std::vector<StackSlot const*> const& _slots, StackSlot const& _slot)
+{
+	for (size_t number = 0; number < _slots.size(); ++number)
+		if (*_slots[number] == _slot)
+			return static_cast<uint32_t>(number);
+	return std::nullopt;
+}
+
+std::atomic<bool> cachesEnabled = true;
+
+}
+
+std::optional<StackPattern> StackPattern::create(std::initializer_list<Stack const*> _stacks, uint32_t _flags)
+{
+	size_t totalSize = 0;
+	for (Stack const* stack: _stacks)
+		totalSize += stack->size();
+	if (totalSize > maxSlots)
+		return std::nullopt;
+
+	StackPattern pattern;
+	pattern.m_key.reserve(1 + _stacks.size() + totalSize);
+	pattern.m_key.emplace_back(_flags);
+	for (Stack const* stack: _stacks)
+	{
+		pattern.m_key.emplace_back(static_cast<uint32_t>(stack->size()));
+		for (StackSlot const& slot: *stack)
+		{
+			std::optional<uint32_t> number = findSlot(pattern.m_slots, slot);
+			if (!number)
+			{
+				number = static_cast<uint32_t>(pattern.m_slots.size());
+				pattern.m_slots.emplace_back(&slot);
+			}
+			// Slots of different kinds are never equal, but the shuffler treats all function return
+			// label slots alike, so the kind is part of the pattern.
+			pattern.m_key.emplace_back((*number << 3) | static_cast<uint32_t>(slot.index()));
+		}
+	}
+	return pattern;
+}
+
+std::vector<uint32_t> StackPattern::encode(Stack const& _stack) const
+{
+	std::vector<uint32_t> result;
+	result.reserve(_stack.size());
+	for (StackSlot const& slot: _stack)
+	{
+		std::optional<uint32_t> number = findSlot(m_slots, slot);
+		yulAssert(number, "Slot does not occur in the stack pattern.");
+		result.emplace_back(*number);
+	}
+	return result;
+}
+
+Stack StackPattern::decode(std::vector<uint32_t> const& _slots) const
+{
+	Stack result;
+	result.reserve(_slots.size());
+	for (uint32_t number: _slots)
+		result.emplace_back(*m_slots.at(number));
+	return result;
+}
+
+StackLayoutCache<std::vector<StackShuffleOperation>>& StackLayoutCaches::shuffles()
+{
+	static StackLayoutCache<std::vector<StackShuffleOperation>> cache;
+	return cache;
+}
+
+StackLayoutCache<std::vector<uint32_t>>& StackLayoutCaches::combinations()
+{
+	static StackLayoutCache<std::vector<uint32_t>> cache;
+	return cache;
+}
+
+StackLayoutCache<std::vector<uint32_t>>& StackLayoutCaches::idealLayouts()
+{
+	static StackLayoutCache<std::vector<uint32_t>> cache;
+	return cache;
+}
+
+void StackLayoutCaches::setEnabled(bool _enabled)
+{
+	cachesEnabled = _enabled;
+}
+
+bool StackLayoutCaches::enabled()
+{
+	return cachesEnabled;
+}
+
+void StackLayoutCaches::clear()
+{
+	shuffles().clear();
+	combinations().clear();
+	idealLayouts().clear();
+}
@@ -0,0 +1,169 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Caches for the solutions of the stack layout problems solved by the stack layout generator
+ * and the optimized EVM code transform.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Abstract form of a tuple of stacks that only retains what the stack layout algorithms depend on:
+ * the sizes of the stacks, the kind of each slot and which of the slots are equal.
+ * Distinct slots are numbered in the order of their first occurrence, so that e.g. the stacks
+ * `[a b a]` and `[x y x]` of variable slots have the same pattern.
+ *
+ * Stacks consisting of slots of the original stacks can be encoded as a sequence of these numbers
+ * and decoded again for any other tuple of stacks with the same pattern.
+ * The pattern refers to the slots of the original stacks, so it must not outlive them.
+ */
+class StackPattern
+{
+public:
+	/// Problems on larger stacks are rare and not worth caching.
+	static constexpr size_t maxSlots = 64;
+
+	/// @returns the pattern of @a _stacks or nullopt if they contain more than maxSlots slots in total.
+	/// @a _flags is made part of the key and distinguishes problems that depend on more than the stacks.
+	static std::optional<StackPattern> create(std::initializer_list<Stack const*> _stacks, uint32_t _flags = 0);
+
+	std::vector<uint32_t> const& key() const { return m_key; }
+	/// @returns the numbers of the slots of @a _stack, all of which have to occur in the pattern.
+	std::vector<uint32_t> encode(Stack const& _stack) const;
+	/// @returns the stack consisting of the slots with the numbers @a _slots.
+	Stack decode(std::vector<uint32_t> const& _slots) const;
+
+private:
+	StackPattern() = default;
+
+	std::vector<uint32_t> m_key;
+	/// The first occurrence of each distinct slot, indexed by its number.
+	std::vector<StackSlot const*> m_slots;
+};
+
+/// Operation performed by createStackLayout.
+struct StackShuffleOperation
+{
+	enum class Kind: uint8_t { Swap, PushOrDup, Pop };
+	Kind kind;
+	/// Depth of the swap or offset of the pushed or dupped slot in the target stack.
+	uint32_t argument = 0;
+};
+
+struct StackLayoutCacheStatistics
+{
+	size_t hits = 0;
+	size_t misses = 0;
+};
+
+/**
+ * Thread-safe map from the keys of stack patterns to the solutions of a stack layout problem.
+ * Stops growing after a fixed number of entries.
+ */
+template<typename Solution>
+class StackLayoutCache
+{
+public:
+	std::optional<Solution> find(std::vector<uint32_t> const& _key)
+	{
+		{
+			std::shared_lock lock(m_mutex);
+			if (auto it = m_entries.find(_key); it != m_entries.end())
+			{
+				++m_hits;
+				return it->second;
+			}
+		}
+		++m_misses;
+		return std::nullopt;
+	}
+
+	void insert(std::vector<uint32_t> _key, Solution _solution)
+	{
+		std::unique_lock lock(m_mutex);
+		if (m_entries.size() < maxEntries)
+			m_entries.emplace(std::move(_key), std::move(_solution));
+	}
+
+	StackLayoutCacheStatistics statistics() const { return {m_hits.load(), m_misses.load()}; }
+
+	void clear()
+	{
+		std::unique_lock lock(m_mutex);
+		m_entries.clear();
+		m_hits = 0;
+		m_misses = 0;
+	}
+
+private:
+	static constexpr size_t maxEntries = 1 << 16;
+
+	struct KeyHash
+	{
+		size_t operator()(std::vector<uint32_t> const& _key) const
+		{
+			uint64_t hash = 0xcbf29ce484222325;
+			for (uint32_t value: _key)
+				hash = (hash ^ value) * 0x100000001b3;
+			return static_cast<size_t>(hash);
+		}
+	};
+
+	mutable std::shared_mutex m_mutex;
+	std::unordered_map<std::vector<uint32_t>, Solution, KeyHash> m_entries;
+	std::atomic<size_t> m_hits = 0;
+	std::atomic<size_t> m_misses = 0;
+};
+
+/**
+ * The caches shared by all code generated in the process. They only depend on the patterns of
+ * the stacks, so the solutions are reused across functions, contracts and compiler runs and
+ * replaying them results in exactly the same code as solving the problems again.
+ */
+struct StackLayoutCaches
+{
+	/// Sequences of operations performed by createStackLayout.
+	static StackLayoutCache<std::vector<StackShuffleOperation>>& shuffles();
+	/// Results of StackLayoutGenerator::combineStack.
+	static StackLayoutCache<std::vector<uint32_t>>& combinations();
+	/// Ideal entry layouts of operations calculated by the stack layout generator.
+	static StackLayoutCache<std::vector<uint32_t>>& idealLayouts();
+
+	/// Enables or disables the use of all caches. They are enabled by default.
+	static void setEnabled(bool _enabled);
+	static bool enabled();
+	/// Removes all entries and resets the statistics.
+	static void clear();
+};
+
+}
@@ -22,6 +22,7 @@
 #include <libyul/backends/evm/StackLayoutGenerator.h>
 
 #include <libyul/backends/evm/StackHelpers.h>
+#include <libyul/backends/evm/StackLayoutCache.h>
 
 #include <libevmasm/GasMeter.h>
 
@@ -281,7 +282,20 @@ Stack StackLayoutGenerator::propagateStackThroughOperation(Stack _exitStack, CFG
 
 	// Determine the ideal permutation of the slots in _exitLayout that are not operation outputs (and not to be
 	// generated on the fly), s.t. shuffling the `stack + _operation.output` to _exitLayout is cheap.
-	Stack stack = createIdealLayout(_operation.output, _exitStack, generateSlotOnTheFly);
+	// The result only depends on the pattern of the stacks, so it is cached.
+	Stack stack;
+	std::optional<StackPattern> pattern;
+	if (StackLayoutCaches::enabled())
+		pattern = StackPattern::create({&_operation.output, &_exitStack}, _aggressiveStackCompression ? 1 : 0);
+	if (!pattern)
+		stack = createIdealLayout(_operation.output, _exitStack, generateSlotOnTheFly);
+	else if (auto cachedStack = StackLayoutCaches::idealLayouts().find(pattern->key()))
+		stack = pattern->decode(*cachedStack);
+	else
+	{
+		stack = createIdealLayout(_operation.output, _exitStack, generateSlotOnTheFly);
+		StackLayoutCaches::idealLayouts().insert(pattern->key(), pattern->encode(stack));
+	}
 
 	// Make sure the resulting previous slots do not overlap with any assignmed variables.
 	if (auto const* assignment = std::get_if<CFG::Assignment>(&_operation.operation))
@@ -546,6 +560,20 @@ void StackLayoutGenerator::stitchConditionalJumps(CFG::BasicBlock const& _block)
 }
 
 Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2)
+{
+	std::optional<StackPattern> pattern;
+	if (StackLayoutCaches::enabled())
+		pattern = StackPattern::create({&_stack1, &_stack2});
+	if (!pattern)
+		return calculateCombinedStack(_stack1, _stack2);
+	if (auto cachedStack = StackLayoutCaches::combinations().find(pattern->key()))
+		return pattern->decode(*cachedStack);
+	Stack stack = calculateCombinedStack(_stack1, _stack2);
+	StackLayoutCaches::combinations().insert(pattern->key(), pattern->encode(stack));
+	return stack;
+}
+
+Stack StackLayoutGenerator::calculateCombinedStack(Stack const& _stack1, Stack const& _stack2)
 {
 	// TODO: it would be nicer to replace this by a constructive algorithm.
 	// Currently it uses a reduced version of the Heap Algorithm to partly brute-force, which seems
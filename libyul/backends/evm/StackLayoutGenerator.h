@@ -100,7 +100,10 @@ private:
 
 	/// Calculates the ideal stack layout, s.t. both @a _stack1 and @a _stack2 can be achieved with minimal
 	/// stack shuffling when starting from the returned layout.
+	/// Reuses the result for stacks of the same pattern.
 	static Stack combineStack(Stack const& _stack1, Stack const& _stack2);
+	/// Performs the actual calculation for combineStack.
+	static Stack calculateCombinedStack(Stack const& _stack1, Stack const& _stack2);
 
 	/// Walks through the CFG and reports any stack too deep errors that would occur when generating code for it
 	/// without countermeasures.
@@ -0,0 +1,418 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Component that keeps track of the changes optimiser steps make to the main block
+ * and the function definitions.
+ */
+
+#include <libyul/optimiser/ChangeTracker.h>
+
+#include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/Parallel.h>
+
+#include <range/v3/view/map.hpp>
+
+#include <functional>
+
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// @returns the name of the function defined by @a _statement or the empty name for the main block.
+YulString nameOf(Statement const& _statement)
+{
+	if (FunctionDefinition const* function = std::get_if<FunctionDefinition>(&_statement))
+		return function->name;
+	return {};
+}
+
+/**
+ * Calculates a hash of a statement that, in contrast to BlockHasher, takes all names,
+ * literals and debug data into account. Also collects the called functions.
+ *
+ * The statement is serialized without loss and the serialization is hashed with Keccak-256,
+ * so that a change of a statement goes unnoticed only if the hashes collide.
+ */
+class StatementHasher: public ASTWalker
+{
+public:
+	explicit StatementHasher(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	using ASTWalker::operator();
+
+	void operator()(Literal const& _literal) override
+	{
+		appendNode(NodeKind::Literal, _literal.debugData);
+		append(static_cast<uint64_t>(_literal.kind));
+		append(_literal.type);
+		append(_literal.value.unlimited());
+		if (_literal.value.unlimited())
+			append(_literal.value.builtinStringLiteralValue());
+		else
+		{
+			util::h256 const value(_literal.value.value());
+			m_data.append(reinterpret_cast<char const*>(value.data()), util::h256::size);
+		}
+		append(_literal.value.hint() != nullptr);
+		if (auto const& hint = _literal.value.hint())
+			append(*hint);
+	}
+	void operator()(Identifier const& _identifier) override
+	{
+		appendNode(NodeKind::Identifier, _identifier.debugData);
+		append(_identifier.name);
+	}
+	void operator()(FunctionCall const& _funCall) override
+	{
+		appendNode(NodeKind::FunctionCall, _funCall.debugData);
+		(*this)(_funCall.functionName);
+		append(_funCall.arguments.size());
+		m_callees.insert(_funCall.functionName.name);
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name))
+			if (builtin->isMSize)
+				m_containsMSize = true;
+		ASTWalker::operator()(_funCall);
+	}
+	void operator()(ExpressionStatement const& _statement) override
+	{
+		appendNode(NodeKind::ExpressionStatement, _statement.debugData);
+		ASTWalker::operator()(_statement);
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		appendNode(NodeKind::Assignment, _assignment.debugData);
+		append(_assignment.variableNames.size());
+		ASTWalker::operator()(_assignment);
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		appendNode(NodeKind::VariableDeclaration, _varDecl.debugData);
+		appendTypedNames(_varDecl.variables);
+		append(_varDecl.value != nullptr);
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(If const& _if) override
+	{
+		appendNode(NodeKind::If, _if.debugData);
+		ASTWalker::operator()(_if);
+	}
+	void operator()(Switch const& _switch) override
+	{
+		appendNode(NodeKind::Switch, _switch.debugData);
+		visit(*_switch.expression);
+		append(_switch.cases.size());
+		for (Case const& _case: _switch.cases)
+		{
+			appendNode(NodeKind::Case, _case.debugData);
+			append(_case.value != nullptr);
+			if (_case.value)
+				(*this)(*_case.value);
+			(*this)(_case.body);
+		}
+	}
+	void operator()(FunctionDefinition const& _function) override
+	{
+		appendNode(NodeKind::FunctionDefinition, _function.debugData);
+		append(_function.name);
+		appendTypedNames(_function.parameters);
+		appendTypedNames(_function.returnVariables);
+		ASTWalker::operator()(_function);
+	}
+	void operator()(ForLoop const& _for) override
+	{
+		appendNode(NodeKind::ForLoop, _for.debugData);
+		ASTWalker::operator()(_for);
+	}
+	void operator()(Break const& _break) override
+	{
+		appendNode(NodeKind::Break, _break.debugData);
+	}
+	void operator()(Continue const& _continue) override
+	{
+		appendNode(NodeKind::Continue, _continue.debugData);
+	}
+	void operator()(Leave const& _leave) override
+	{
+		appendNode(NodeKind::Leave, _leave.debugData);
+	}
+	void operator()(Block const& _block) override
+	{
+		appendNode(NodeKind::Block, _block.debugData);
+		append(_block.statements.size());
+		ASTWalker::operator()(_block);
+	}
+
+	util::h256 hash() const { return util::keccak256(m_data); }
+	std::set<YulString>& callees() { return m_callees; }
+	bool containsMSize() const { return m_containsMSize; }
+
+private:
+	enum class NodeKind: uint8_t
+	{
+		Literal,
+		Identifier,
+		FunctionCall,
+		ExpressionStatement,
+		Assignment,
+		VariableDeclaration,
+		If,
+		Switch,
+		Case,
+		FunctionDefinition,
+		ForLoop,
+		Break,
+		Continue,
+		Leave,
+		Block
+	};
+
+	void append(uint64_t _value)
+	{
+		for (size_t i = 0; i < 8; ++i)
+			m_data.push_back(static_cast<char>(_value >> (8 * i)));
+	}
+	void append(bool _value) { m_data.push_back(_value ? 1 : 0); }
+	/// Strings are prefixed by their length, so that no serialization is a prefix of another one.
+	void append(std::string const& _value)
+	{
+		append(static_cast<uint64_t>(_value.size()));
+		m_data += _value;
+	}
+	void append(YulString _value) { append(_value.str()); }
+
+	void appendNode(NodeKind _kind, DebugData::ConstPtr const& _debugData)
+	{
+		m_data.push_back(static_cast<char>(_kind));
+		append(_debugData != nullptr);
+		if (!_debugData)
+			return;
+		appendLocation(_debugData->nativeLocation);
+		appendLocation(_debugData->originLocation);
+		append(_debugData->astID.has_value());
+		if (_debugData->astID)
+			append(static_cast<uint64_t>(*_debugData->astID));
+	}
+	void appendLocation(SourceLocation const& _location)
+	{
+		append(static_cast<uint64_t>(_location.start));
+		append(static_cast<uint64_t>(_location.end));
+		append(_location.sourceName != nullptr);
+		if (_location.sourceName)
+			append(*_location.sourceName);
+	}
+	void appendTypedNames(TypedNameList const& _names)
+	{
+		append(_names.size());
+		for (TypedName const& name: _names)
+		{
+			appendNode(NodeKind::Identifier, name.debugData);
+			append(name.name);
+			append(name.type);
+		}
+	}
+
+	Dialect const& m_dialect;
+	/// Serialization of the statement visited so far.
+	std::string m_data;
+	std::set<YulString> m_callees;
+	bool m_containsMSize = false;
+};
+
+}
+
+void ChangeTracker::update(Block const& _ast)
+{
+	updateSelected(_ast, nullptr);
+}
+
+void ChangeTracker::update(Block const& _ast, std::set<YulString> const& _modified)
+{
+	if (!m_tracking)
+	{
+		updateSelected(_ast, nullptr);
+		return;
+	}
+
+	std::vector<bool> selection(_ast.statements.size());
+	for (size_t i = 0; i < _ast.statements.size(); ++i)
+	{
+		YulString name = nameOf(_ast.statements[i]);
+		selection[i] = _modified.count(name) || !m_entries.count(name);
+	}
+	updateSelected(_ast, &selection);
+}
+
+void ChangeTracker::updateSelected(Block const& _ast, std::vector<bool> const* _selection)
+{
+	if (!FunctionGrouper::isGrouped(_ast))
+	{
+		m_tracking = false;
+		m_entries.clear();
+		return;
+	}
+
+	std::vector<std::optional<Fingerprint>> newFingerprints = fingerprints(_ast, _selection);
+	std::map<YulString, Entry> entries;
+	std::set<YulString> changed;
+	for (size_t i = 0; i < _ast.statements.size(); ++i)
+	{
+		YulString name = nameOf(_ast.statements[i]);
+		Entry* previous = m_tracking ? util::valueOrNullptr(m_entries, name) : nullptr;
+		bool const unchanged = _selection && !(*_selection)[i];
+		yulAssert(!unchanged || previous);
+		auto [it, inserted] = entries.try_emplace(
+			name,
+			unchanged ? std::move(*previous) : Entry{std::move(*newFingerprints[i]), {}}
+		);
+		if (!inserted)
+		{
+			// Function names are unique in all code the optimiser suite works on, so this
+			// should not happen, but it is not worth an assertion.
+			m_tracking = false;
+			m_entries.clear();
+			return;
+		}
+		if (unchanged)
+			continue;
+		if (previous && previous->fingerprint.hash == it->second.fingerprint.hash)
+			it->second.stableUnder = previous->stableUnder;
+		else
+			changed.insert(name);
+	}
+	for (auto const& [name, entry]: m_entries)
+		if (!entries.count(name))
+			changed.insert(name);
+
+	m_tracking = true;
+	m_entries = std::move(entries);
+	invalidate(changed);
+	updateMSize();
+}
+
+void ChangeTracker::update(std::string const& _step, Block const& _ast, std::vector<bool> const& _processed)
+{
+	yulAssert(m_tracking && _processed.size() == _ast.statements.size());
+
+	std::vector<std::optional<Fingerprint>> newFingerprints = fingerprints(_ast, &_processed);
+	std::set<YulString> changed;
+	for (size_t i = 0; i < _ast.statements.size(); ++i)
+	{
+		if (!_processed[i])
+		{
+			++m_skippedStatements;
+			continue;
+		}
+		YulString name = nameOf(_ast.statements[i]);
+		Entry& entry = m_entries.at(name);
+		if (entry.fingerprint.hash == newFingerprints[i]->hash)
+			entry.stableUnder.insert(_step);
+		else
+		{
+			entry.fingerprint = std::move(*newFingerprints[i]);
+			changed.insert(name);
+		}
+	}
+	invalidate(changed);
+	updateMSize();
+}
+
+std::vector<bool> ChangeTracker::statementsToProcess(std::string const& _step, Block const& _ast) const
+{
+	yulAssert(m_tracking && _ast.statements.size() == m_entries.size());
+	std::vector<bool> selection(_ast.statements.size());
+	for (size_t i = 0; i < _ast.statements.size(); ++i)
+		selection[i] = !m_entries.at(nameOf(_ast.statements[i])).stableUnder.count(_step);
+	return selection;
+}
+
+size_t ChangeTracker::codeSize() const
+{
+	yulAssert(m_tracking);
+	size_t size = 0;
+	for (auto const& entry: m_entries | ranges::views::values)
+		size += entry.fingerprint.codeSize;
+	return size;
+}
+
+std::vector<std::optional<ChangeTracker::Fingerprint>> ChangeTracker::fingerprints(
+	Block const& _ast,
+	std::vector<bool> const* _selection
+) const
+{
+	std::vector<std::optional<Fingerprint>> result(_ast.statements.size());
+	util::parallelFor(m_concurrency, _ast.statements.size(), [&](size_t _index) {
+		if (_selection && !(*_selection)[_index])
+			return;
+		Statement const& statement = _ast.statements[_index];
+		StatementHasher hasher{m_dialect};
+		hasher.visit(statement);
+		result[_index] = Fingerprint{
+			hasher.hash(),
+			CodeSize::codeSizeIncludingFunctions(statement),
+			std::move(hasher.callees()),
+			hasher.containsMSize()
+		};
+	});
+	return result;
+}
+
+void ChangeTracker::invalidate(std::set<YulString> const& _changed)
+{
+	if (_changed.empty())
+		return;
+
+	std::map<YulString, std::set<YulString>> callers;
+	for (auto const& [name, entry]: m_entries)
+		for (YulString callee: entry.fingerprint.callees)
+			callers[callee].insert(name);
+
+	std::set<YulString> invalidated;
+	std::vector<YulString> toVisit(_changed.begin(), _changed.end());
+	while (!toVisit.empty())
+	{
+		YulString name = toVisit.back();
+		toVisit.pop_back();
+		if (!invalidated.insert(name).second)
+			continue;
+		if (Entry* entry = util::valueOrNullptr(m_entries, name))
+			entry->stableUnder.clear();
+		if (std::set<YulString> const* nameCallers = util::valueOrNullptr(callers, name))
+			toVisit.insert(toVisit.end(), nameCallers->begin(), nameCallers->end());
+	}
+}
+
+void ChangeTracker::updateMSize()
+{
+	bool containsMSize = false;
+	for (auto const& entry: m_entries | ranges::views::values)
+		containsMSize = containsMSize || entry.fingerprint.containsMSize;
+	if (containsMSize != m_containsMSize)
+		for (auto& entry: m_entries | ranges::views::values)
+			entry.stableUnder.clear();
+	m_containsMSize = containsMSize;
+}
@@ -0,0 +1,128 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Component that keeps track of the changes optimiser steps make to the main block
+ * and the function definitions.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/YulString.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Keeps track of the changes made to the top-level statements of code in the form established
+ * by FunctionGrouper, i.e. to the main block and the function definitions, in order to avoid
+ * running function-local optimiser steps (see OptimiserStep::isFunctionLocal) on statements
+ * they would not change.
+ *
+ * The result of a function-local step on a top-level statement only depends on the statement
+ * itself, on the side effects of the functions it calls directly or indirectly and on whether
+ * the code contains msize. If a step did not change a statement, running it again on the
+ * statement does not change it either as long as none of these changed in the meantime.
+ *
+ * Changes are detected by comparing Keccak-256 hashes of the statements that take all names,
+ * literals and debug data into account, so that the probability of missing a change is
+ * negligible. Statements are identified by the names of the functions, the main block by the
+ * empty name. Only the statements steps report as modified are hashed again, if they do so
+ * (see OptimiserStep::reportsModifications).
+ */
+class ChangeTracker
+{
+public:
+	ChangeTracker(Dialect const& _dialect, size_t _concurrency):
+		m_dialect(_dialect),
+		m_concurrency(_concurrency)
+	{}
+
+	/// Takes note of the state of @a _ast after arbitrary modifications.
+	/// Stops tracking changes if @a _ast is not grouped.
+	void update(Block const& _ast);
+	/// Takes note of the state of @a _ast after modifications of at most the top-level statements
+	/// named in @a _modified, the removal of top-level statements and the addition of new ones.
+	void update(Block const& _ast, std::set<YulString> const& _modified);
+	/// Takes note of the state of @a _ast after the function-local step @a _step processed
+	/// the top-level statements selected by @a _processed and did not modify any other ones.
+	void update(std::string const& _step, Block const& _ast, std::vector<bool> const& _processed);
+
+	/// @returns for every top-level statement of @a _ast whether @a _step might change it.
+	/// Requires changes to be tracked and @a _ast to be unchanged since the last update.
+	std::vector<bool> statementsToProcess(std::string const& _step, Block const& _ast) const;
+
+	/// @returns true if changes are tracked.
+	bool tracking() const { return m_tracking; }
+	/// @returns the value of CodeSize::codeSizeIncludingFunctions for the code at the time of
+	/// the last update. Requires changes to be tracked.
+	size_t codeSize() const;
+	/// @returns how many top-level statements function-local steps did not have to process so far.
+	size_t skippedStatements() const { return m_skippedStatements; }
+
+private:
+	struct Fingerprint
+	{
+		util::h256 hash;
+		size_t codeSize = 0;
+		/// Names of all functions and builtins called by the statement.
+		std::set<YulString> callees;
+		bool containsMSize = false;
+	};
+	struct Entry
+	{
+		Fingerprint fingerprint;
+		/// Steps that would not change the statement.
+		std::set<std::string> stableUnder;
+	};
+
+	/// Takes note of the state of @a _ast, assuming that the top-level statements not selected
+	/// by @a _selection did not change. All of them are selected if @a _selection is null.
+	void updateSelected(Block const& _ast, std::vector<bool> const* _selection);
+	/// @returns the fingerprints of the top-level statements of @a _ast selected by @a _selection
+	/// or of all of them if @a _selection is null.
+	std::vector<std::optional<Fingerprint>> fingerprints(
+		Block const& _ast,
+		std::vector<bool> const* _selection
+	) const;
+	/// Marks the statements named @a _changed and all statements calling them, directly
+	/// or indirectly, as not stable under any step.
+	void invalidate(std::set<YulString> const& _changed);
+	/// Recomputes whether the code contains msize and marks all statements as not stable
+	/// under any step if that changed.
+	void updateMSize();
+
+	Dialect const& m_dialect;
+	size_t m_concurrency = 1;
+	bool m_tracking = false;
+	bool m_containsMSize = false;
+	std::map<YulString, Entry> m_entries;
+	size_t m_skippedStatements = 0;
+};
+
+}
@@ -20,6 +20,7 @@
  */
 
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/BlockHasher.h>
@@ -44,9 +45,19 @@ void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _
 	cse(_ast);
 }
 
+void CommonSubexpressionEliminator::runConcurrently(OptimiserStepContext& _context, Block& _ast, size_t _concurrency)
+{
+	YulStringMap<SideEffects> const functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	forEachTopLevelStatementConcurrently(_context, _ast, _concurrency, [&](Statement& _statement) {
+		CommonSubexpressionEliminator cse{_context.dialect, functionSideEffects};
+		static_cast<ASTModifier&>(cse).visit(_statement);
+	});
+}
+
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
 	Dialect const& _dialect,
-	std::map<YulString, SideEffects> _functionSideEffects
+	YulStringMap<SideEffects> _functionSideEffects
 ):
 	DataFlowAnalyzer(_dialect, MemoryAndStorage::Ignore, std::move(_functionSideEffects))
 {
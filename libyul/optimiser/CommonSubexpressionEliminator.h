@@ -46,6 +46,7 @@ class CommonSubexpressionEliminator: public DataFlowAnalyzer
 public:
 	static constexpr char const* name{"CommonSubexpressionEliminator"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static void runConcurrently(OptimiserStepContext&, Block& _ast, size_t _concurrency);
 
 	using DataFlowAnalyzer::operator();
 	void operator()(FunctionDefinition&) override;
@@ -53,7 +54,7 @@ public:
 private:
 	CommonSubexpressionEliminator(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects
+		YulStringMap<SideEffects> _functionSideEffects
 	);
 
 protected:
@@ -62,7 +63,7 @@ protected:
 
 	void assignValue(YulString _variable, Expression const* _value) override;
 private:
-	std::set<YulString> m_returnVariables;
+	YulStringSet m_returnVariables;
 	std::unordered_map<
 		std::reference_wrapper<Expression const>,
 		std::set<YulString>,
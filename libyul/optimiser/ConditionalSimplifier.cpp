@@ -16,6 +16,7 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 #include <libyul/optimiser/ConditionalSimplifier.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/AST.h>
 #include <libyul/optimiser/NameCollector.h>
@@ -34,6 +35,16 @@ void ConditionalSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 	}(_ast);
 }
 
+void ConditionalSimplifier::runConcurrently(OptimiserStepContext& _context, Block& _ast, size_t _concurrency)
+{
+	YulStringMap<ControlFlowSideEffects> const functionSideEffects =
+		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed();
+	forEachTopLevelStatementConcurrently(_context, _ast, _concurrency, [&](Statement& _statement) {
+		ConditionalSimplifier simplifier{_context.dialect, functionSideEffects};
+		static_cast<ASTModifier&>(simplifier).visit(_statement);
+	});
+}
+
 void ConditionalSimplifier::operator()(Switch& _switch)
 {
 	visit(*_switch.expression);
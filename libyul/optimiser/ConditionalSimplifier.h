@@ -21,6 +21,7 @@
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/ASTForward.h>
 #include <libyul/Dialect.h>
+#include <libyul/YulStringMap.h>
 #include <libsolutil/Common.h>
 
 namespace solidity::yul
@@ -54,6 +55,7 @@ class ConditionalSimplifier: public ASTModifier
 public:
 	static constexpr char const* name{"ConditionalSimplifier"};
 	static void run(OptimiserStepContext& _context, Block& _ast);
+	static void runConcurrently(OptimiserStepContext&, Block& _ast, size_t _concurrency);
 
 	using ASTModifier::operator();
 	void operator()(Switch& _switch) override;
@@ -62,12 +64,12 @@ public:
 private:
 	explicit ConditionalSimplifier(
 		Dialect const& _dialect,
-		std::map<YulString, ControlFlowSideEffects> _sideEffects
+		YulStringMap<ControlFlowSideEffects> _sideEffects
 	):
 		m_dialect(_dialect), m_functionSideEffects(std::move(_sideEffects))
 	{}
 	Dialect const& m_dialect;
-	std::map<YulString, ControlFlowSideEffects> m_functionSideEffects;
+	YulStringMap<ControlFlowSideEffects> m_functionSideEffects;
 };
 
 }
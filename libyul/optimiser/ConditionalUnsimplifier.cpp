@@ -16,6 +16,7 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
@@ -35,6 +36,16 @@ void ConditionalUnsimplifier::run(OptimiserStepContext& _context, Block& _ast)
 	}(_ast);
 }
 
+void ConditionalUnsimplifier::runConcurrently(OptimiserStepContext& _context, Block& _ast, size_t _concurrency)
+{
+	YulStringMap<ControlFlowSideEffects> const functionSideEffects =
+		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed();
+	forEachTopLevelStatementConcurrently(_context, _ast, _concurrency, [&](Statement& _statement) {
+		ConditionalUnsimplifier unsimplifier{_context.dialect, functionSideEffects};
+		static_cast<ASTModifier&>(unsimplifier).visit(_statement);
+	});
+}
+
 void ConditionalUnsimplifier::operator()(Switch& _switch)
 {
 	visit(*_switch.expression);
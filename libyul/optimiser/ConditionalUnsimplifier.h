@@ -20,6 +20,7 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/Dialect.h>
+#include <libyul/YulStringMap.h>
 #include <libsolutil/Common.h>
 
 namespace solidity::yul
@@ -34,6 +35,7 @@ class ConditionalUnsimplifier: public ASTModifier
 public:
 	static constexpr char const* name{"ConditionalUnsimplifier"};
 	static void run(OptimiserStepContext& _context, Block& _ast);
+	static void runConcurrently(OptimiserStepContext&, Block& _ast, size_t _concurrency);
 
 	using ASTModifier::operator();
 	void operator()(Switch& _switch) override;
@@ -42,12 +44,12 @@ public:
 private:
 	explicit ConditionalUnsimplifier(
 		Dialect const& _dialect,
-		std::map<YulString, ControlFlowSideEffects> const& _sideEffects
+		YulStringMap<ControlFlowSideEffects> const& _sideEffects
 	):
 		m_dialect(_dialect), m_functionSideEffects(_sideEffects)
 	{}
 	Dialect const& m_dialect;
-	std::map<YulString, ControlFlowSideEffects> const& m_functionSideEffects;
+	YulStringMap<ControlFlowSideEffects> const& m_functionSideEffects;
 };
 
 }
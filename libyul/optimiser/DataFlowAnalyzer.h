@@ -26,14 +26,22 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/KnowledgeBase.h>
 #include <libyul/YulString.h>
+#include <libyul/YulStringMap.h>
 #include <libyul/AST.h> // Needed for m_zero below.
+#include <libyul/Exceptions.h>
 #include <libyul/SideEffects.h>
 
 #include <libsolutil/Numeric.h>
 #include <libsolutil/Common.h>
+#include <libsolutil/CommonData.h>
 
+#include <algorithm>
 #include <map>
+#include <optional>
 #include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -71,6 +79,8 @@ struct AssignedValue
  * This works also for memory (where addresses overlap) because one branch is always an
  * older version of the other and thus overlapping contents would have been deleted already
  * at the point of assignment.
+ * Instead of copying the knowledge before a branch, the changes made inside the branch are
+ * recorded, so that only the changed keys have to be compared when joining.
  *
  * The DataFlowAnalyzer currently does not deal with the ``leave`` statement. This is because
  * it only matters at the end of a function body, which is a point in the code a derived class
@@ -89,7 +99,7 @@ public:
 	explicit DataFlowAnalyzer(
 		Dialect const& _dialect,
 		MemoryAndStorage _analyzeStores,
-		std::map<YulString, SideEffects> _functionSideEffects = {}
+		YulStringMap<SideEffects> _functionSideEffects = {}
 	);
 
 	using ASTModifier::operator();
@@ -105,7 +115,7 @@ public:
 	/// @returns the current value of the given variable, if known - always movable.
 	AssignedValue const* variableValue(YulString _variable) const { return util::valueOrNullptr(m_state.value, _variable); }
 	std::set<YulString> const* references(YulString _variable) const { return util::valueOrNullptr(m_state.references, _variable); }
-	std::map<YulString, AssignedValue> const& allValues() const { return m_state.value; }
+	YulStringMap<AssignedValue> const& allValues() const { return m_state.value; }
 	std::optional<YulString> storageValue(YulString _key) const;
 	std::optional<YulString> memoryValue(YulString _key) const;
 	std::optional<YulString> keccakValue(YulString _start, YulString _length) const;
@@ -165,36 +175,140 @@ protected:
 	Dialect const& m_dialect;
 	/// Side-effects of user-defined functions. Worst-case side-effects are assumed
 	/// if this is not provided or the function is not found.
-	std::map<YulString, SideEffects> m_functionSideEffects;
+	YulStringMap<SideEffects> m_functionSideEffects;
 
 private:
+	/// Map that records the previous values of the entries it changes while a checkpoint is open,
+	/// so that the knowledge at the checkpoint does not have to be copied.
+	template <typename Map>
+	class JournaledMap
+	{
+	public:
+		using Key = typename Map::key_type;
+		using Value = typename Map::mapped_type;
+
+		Value const* find(Key const& _key) const { return util::valueOrNullptr(m_entries, _key); }
+
+		void set(Key const& _key, Value const& _value)
+		{
+			auto [it, inserted] = m_entries.emplace(_key, _value);
+			if (!inserted && it->second != _value)
+			{
+				record(_key, it->second);
+				it->second = _value;
+			}
+			else if (inserted)
+				record(_key, std::nullopt);
+		}
+		void erase(Key const& _key)
+		{
+			if (auto it = m_entries.find(_key); it != m_entries.end())
+			{
+				record(_key, it->second);
+				m_entries.erase(it);
+			}
+		}
+		/// Erases all entries for which @a _predicate(key, value) is true.
+		template <typename Predicate>
+		void eraseIf(Predicate const& _predicate)
+		{
+			for (auto it = m_entries.begin(); it != m_entries.end();)
+				if (_predicate(it->first, it->second))
+				{
+					record(it->first, it->second);
+					it = m_entries.erase(it);
+				}
+				else
+					++it;
+		}
+		void clear()
+		{
+			if (m_openCheckpoints == 0)
+				m_entries.clear();
+			else
+				eraseIf([](Key const&, Value const&) { return true; });
+		}
+
+		/// Starts recording changes. @returns the checkpoint to be passed to joinWithCheckpoint().
+		size_t openCheckpoint()
+		{
+			++m_openCheckpoints;
+			return m_journal.size();
+		}
+		/// Erases all entries whose value differs from the one they had at @a _checkpoint
+		/// or that did not exist at that point. Only visits the entries changed since then.
+		void joinWithCheckpoint(size_t _checkpoint)
+		{
+			yulAssert(m_openCheckpoints > 0 && _checkpoint <= m_journal.size());
+			// Order the changes since the checkpoint by key and then by their position, so that
+			// the first change of each key records its value at the checkpoint.
+			m_changeOrder.clear();
+			for (size_t i = _checkpoint; i < m_journal.size(); ++i)
+				m_changeOrder.push_back(i);
+			std::sort(m_changeOrder.begin(), m_changeOrder.end(), [&](size_t _a, size_t _b) {
+				return std::tie(m_journal[_a].first, _a) < std::tie(m_journal[_b].first, _b);
+			});
+			for (size_t i = 0; i < m_changeOrder.size(); ++i)
+			{
+				// Erasing appends to the journal, so its entries are only accessed by index.
+				size_t const change = m_changeOrder[i];
+				if (i > 0 && m_journal[m_changeOrder[i - 1]].first == m_journal[change].first)
+					continue;
+				if (Value const* currentValue = find(m_journal[change].first))
+					if (!m_journal[change].second || *m_journal[change].second != *currentValue)
+						erase(Key{m_journal[change].first});
+			}
+			if (--m_openCheckpoints == 0)
+				m_journal.clear();
+		}
+
+	private:
+		void record(Key const& _key, std::optional<Value> _previousValue)
+		{
+			if (m_openCheckpoints > 0)
+				m_journal.emplace_back(_key, std::move(_previousValue));
+		}
+
+		Map m_entries;
+		/// Keys changed while a checkpoint is open, together with their previous values.
+		std::vector<std::pair<Key, std::optional<Value>>> m_journal;
+		/// Positions in the journal, reused by every join to avoid allocating.
+		std::vector<size_t> m_changeOrder;
+		size_t m_openCheckpoints = 0;
+	};
+
 	struct Environment
 	{
-		std::unordered_map<YulString, YulString> storage;
-		std::unordered_map<YulString, YulString> memory;
+		JournaledMap<std::unordered_map<YulString, YulString>> storage;
+		JournaledMap<std::unordered_map<YulString, YulString>> memory;
 		/// If keccak[s, l] = y then y := keccak256(s, l) occurs in the code.
-		std::map<std::pair<YulString, YulString>, YulString> keccak;
+		JournaledMap<std::map<std::pair<YulString, YulString>, YulString>> keccak;
+	};
+	/// Positions in the journals of the environment before entering a branch.
+	struct EnvironmentCheckpoint
+	{
+		size_t storage = 0;
+		size_t memory = 0;
+		size_t keccak = 0;
 	};
 	struct State
 	{
 		/// Current values of variables, always movable.
-		std::map<YulString, AssignedValue> value;
+		YulStringMap<AssignedValue> value;
 		/// m_references[a].contains(b) <=> the current expression assigned to a references b
-		std::unordered_map<YulString, std::set<YulString>> references;
+		YulStringMap<std::set<YulString>> references;
 
 		Environment environment;
 	};
 
+	/// Records the knowledge about storage and memory at the current point in the control-flow.
+	EnvironmentCheckpoint openCheckpoint();
+
 	/// Joins knowledge about storage and memory with an older point in the control-flow.
 	/// This only works if the current state is a direct successor of the older point,
-	/// i.e. `_olderState.storage` and `_olderState.memory` cannot have additional changes.
+	/// i.e. the knowledge at `_checkpoint` cannot have additional changes.
 	/// Does nothing if memory and storage analysis is disabled / ignored.
-	void joinKnowledge(Environment const& _olderEnvironment);
-
-	static void joinKnowledgeHelper(
-		std::unordered_map<YulString, YulString>& _thisData,
-		std::unordered_map<YulString, YulString> const& _olderData
-	);
+	void joinKnowledge(EnvironmentCheckpoint const& _checkpoint);
 
 	State m_state;
 
@@ -212,7 +326,7 @@ protected:
 	struct Scope
 	{
 		explicit Scope(bool _isFunction): isFunction(_isFunction) {}
-		std::set<YulString> variables;
+		YulStringSet variables;
 		bool isFunction;
 	};
 	/// Special expression whose address will be used in m_value.
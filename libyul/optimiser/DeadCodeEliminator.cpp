@@ -20,6 +20,7 @@
  */
 
 #include <libyul/optimiser/DeadCodeEliminator.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/ControlFlowSideEffectsCollector.h>
@@ -43,6 +44,16 @@ void DeadCodeEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	}(_ast);
 }
 
+void DeadCodeEliminator::runConcurrently(OptimiserStepContext& _context, Block& _ast, size_t _concurrency)
+{
+	YulStringMap<ControlFlowSideEffects> const functionSideEffects =
+		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed();
+	forEachTopLevelStatementConcurrently(_context, _ast, _concurrency, [&](Statement& _statement) {
+		DeadCodeEliminator eliminator{_context.dialect, functionSideEffects};
+		static_cast<ASTModifier&>(eliminator).visit(_statement);
+	});
+}
+
 void DeadCodeEliminator::operator()(ForLoop& _for)
 {
 	yulAssert(_for.pre.statements.empty(), "DeadCodeEliminator needs ForLoopInitRewriter as a prerequisite.");
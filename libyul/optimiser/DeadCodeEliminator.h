@@ -24,6 +24,7 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/YulString.h>
 #include <libyul/ControlFlowSideEffects.h>
+#include <libyul/YulStringMap.h>
 
 #include <map>
 #include <set>
@@ -54,6 +55,7 @@ class DeadCodeEliminator: public ASTModifier
 public:
 	static constexpr char const* name{"DeadCodeEliminator"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static void runConcurrently(OptimiserStepContext&, Block& _ast, size_t _concurrency);
 
 	using ASTModifier::operator();
 	void operator()(ForLoop& _for) override;
@@ -62,11 +64,11 @@ public:
 private:
 	DeadCodeEliminator(
 		Dialect const& _dialect,
-		std::map<YulString, ControlFlowSideEffects> _sideEffects
+		YulStringMap<ControlFlowSideEffects> _sideEffects
 	): m_dialect(_dialect), m_functionSideEffects(std::move(_sideEffects)) {}
 
 	Dialect const& m_dialect;
-	std::map<YulString, ControlFlowSideEffects> m_functionSideEffects;
+	YulStringMap<ControlFlowSideEffects> m_functionSideEffects;
 };
 
 }
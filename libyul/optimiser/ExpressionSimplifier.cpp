@@ -37,6 +37,14 @@ void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 	ExpressionSimplifier{_context.dialect}(_ast);
 }
 
+void ExpressionSimplifier::runConcurrently(OptimiserStepContext& _context, Block& _ast, size_t _concurrency)
+{
+	forEachTopLevelStatementConcurrently(_context, _ast, _concurrency, [&](Statement& _statement) {
+		ExpressionSimplifier simplifier{_context.dialect};
+		static_cast<ASTModifier&>(simplifier).visit(_statement);
+	});
+}
+
 void ExpressionSimplifier::visit(Expression& _expression)
 {
 	ASTModifier::visit(_expression);
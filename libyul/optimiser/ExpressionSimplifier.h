@@ -46,6 +46,7 @@ class ExpressionSimplifier: public DataFlowAnalyzer
 public:
 	static constexpr char const* name{"ExpressionSimplifier"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static void runConcurrently(OptimiserStepContext&, Block& _ast, size_t _concurrency);
 
 	using ASTModifier::operator();
 	void visit(Expression& _expression) override;
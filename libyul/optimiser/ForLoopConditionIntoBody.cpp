@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/AST.h>
 
@@ -30,6 +31,14 @@ void ForLoopConditionIntoBody::run(OptimiserStepContext& _context, Block& _ast)
 	ForLoopConditionIntoBody{_context.dialect}(_ast);
 }
 
+void ForLoopConditionIntoBody::runConcurrently(OptimiserStepContext& _context, Block& _ast, size_t _concurrency)
+{
+	forEachTopLevelStatementConcurrently(_context, _ast, _concurrency, [&](Statement& _statement) {
+		ForLoopConditionIntoBody rewriter{_context.dialect};
+		static_cast<ASTModifier&>(rewriter).visit(_statement);
+	});
+}
+
 void ForLoopConditionIntoBody::operator()(ForLoop& _forLoop)
 {
 	if (
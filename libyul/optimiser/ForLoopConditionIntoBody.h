@@ -45,6 +45,7 @@ class ForLoopConditionIntoBody: public ASTModifier
 public:
 	static constexpr char const* name{"ForLoopConditionIntoBody"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static void runConcurrently(OptimiserStepContext&, Block& _ast, size_t _concurrency);
 
 	using ASTModifier::operator();
 	void operator()(ForLoop& _forLoop) override;
@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 
 #include <libyul/optimiser/ForLoopConditionOutOfBody.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
@@ -31,6 +32,14 @@ void ForLoopConditionOutOfBody::run(OptimiserStepContext& _context, Block& _ast)
 	ForLoopConditionOutOfBody{_context.dialect}(_ast);
 }
 
+void ForLoopConditionOutOfBody::runConcurrently(OptimiserStepContext& _context, Block& _ast, size_t _concurrency)
+{
+	forEachTopLevelStatementConcurrently(_context, _ast, _concurrency, [&](Statement& _statement) {
+		ForLoopConditionOutOfBody rewriter{_context.dialect};
+		static_cast<ASTModifier&>(rewriter).visit(_statement);
+	});
+}
+
 void ForLoopConditionOutOfBody::operator()(ForLoop& _forLoop)
 {
 	ASTModifier::operator()(_forLoop);
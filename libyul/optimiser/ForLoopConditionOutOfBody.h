@@ -60,6 +60,7 @@ class ForLoopConditionOutOfBody: public ASTModifier
 public:
 	static constexpr char const* name{"ForLoopConditionOutOfBody"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static void runConcurrently(OptimiserStepContext&, Block& _ast, size_t _concurrency);
 
 	using ASTModifier::operator();
 	void operator()(ForLoop& _forLoop) override;
@@ -49,6 +49,8 @@ void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
 	inliner.run(Pass::InlineTiny);
 	inliner.run(Pass::InlineRest);
+	if (_context.modifiedTopLevelStatements)
+		*_context.modifiedTopLevelStatements += inliner.m_modifiedFunctions;
 }
 
 FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
@@ -298,6 +300,7 @@ std::vector<Statement> InlineModifier::performInline(Statement& _statement, Func
 	assertThrow(!!function, OptimizerException, "Attempt to inline invalid function.");
 
 	m_driver.tentativelyUpdateCodeSize(function->name, m_currentFunction);
+	m_driver.inlinedInto(m_currentFunction);
 
 	// helper function to create a new variable that is supposed to model
 	// an existing variable.
@@ -71,6 +71,7 @@ class FullInliner: public ASTModifier
 {
 public:
 	static constexpr char const* name{"FullInliner"};
+	static constexpr bool reportsModifications = true;
 	static void run(OptimiserStepContext& _context, Block& _ast);
 
 	/// Inlining heuristic.
@@ -90,6 +91,10 @@ public:
 	/// should be determined after inlining is completed.
 	void tentativelyUpdateCodeSize(YulString _function, YulString _callSite);
 
+	/// Takes note that a call was inlined into @a _callSite, which is the name of a function
+	/// or the empty name for the main block.
+	void inlinedInto(YulString _callSite) { m_modifiedFunctions.insert(_callSite); }
+
 private:
 	enum Pass { InlineTiny, InlineRest };
 
@@ -120,6 +125,8 @@ private:
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulString> m_constants;
 	std::map<YulString, size_t> m_functionSizes;
+	/// Functions calls were inlined into, including the empty name for the main block.
+	std::set<YulString> m_modifiedFunctions;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
@@ -22,15 +22,26 @@
 
 #include <libyul/optimiser/FunctionGrouper.h>
 
+#include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/AST.h>
 
 using namespace solidity;
 using namespace solidity::yul;
 
 
+void FunctionGrouper::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (isGrouped(_ast))
+		return;
+	FunctionGrouper{}(_ast);
+	// Only the main block is new, the function definitions are moved unchanged.
+	if (_context.modifiedTopLevelStatements)
+		_context.modifiedTopLevelStatements->insert({});
+}
+
 void FunctionGrouper::operator()(Block& _block)
 {
-	if (alreadyGrouped(_block))
+	if (isGrouped(_block))
 		return;
 
 	std::vector<Statement> reordered;
@@ -46,7 +57,7 @@ void FunctionGrouper::operator()(Block& _block)
 	_block.statements = std::move(reordered);
 }
 
-bool FunctionGrouper::alreadyGrouped(Block const& _block)
+bool FunctionGrouper::isGrouped(Block const& _block)
 {
 	if (_block.statements.empty())
 		return false;
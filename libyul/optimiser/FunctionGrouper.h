@@ -41,14 +41,16 @@ class FunctionGrouper
 {
 public:
 	static constexpr char const* name{"FunctionGrouper"};
-	static void run(OptimiserStepContext&, Block& _ast) { FunctionGrouper{}(_ast); }
+	static constexpr bool reportsModifications = true;
+	static void run(OptimiserStepContext& _context, Block& _ast);
 
 	void operator()(Block& _block);
 
+	/// @returns true if @a _block already is of the form established by this step.
+	static bool isGrouped(Block const& _block);
+
 private:
 	FunctionGrouper() = default;
-
-	bool alreadyGrouped(Block const& _block);
 };
 
 }
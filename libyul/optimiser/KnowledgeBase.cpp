@@ -193,10 +193,13 @@ void KnowledgeBase::reset(YulString _var)
 				// just with _var replaced by newRepresentative
 				m_offsets[groupMember].offset -= newOffset;
 			}
-			m_groupMembers[newRepresentative] = std::move(*group);
-
+			// Inserting into m_groupMembers can move its entries, so the group is moved out first.
+			std::set<YulString> members = std::move(*group);
+			m_groupMembers.erase(_var);
+			m_groupMembers[newRepresentative] = std::move(members);
 		}
-		m_groupMembers.erase(_var);
+		else
+			m_groupMembers.erase(_var);
 	}
 }
 
@@ -23,6 +23,7 @@
 
 #include <libyul/ASTForward.h>
 #include <libyul/YulString.h>
+#include <libyul/YulStringMap.h>
 
 #include <libsolutil/Common.h>
 #include <libsolutil/Numeric.h>
@@ -118,11 +119,12 @@ private:
 
 	/// Offsets for each variable to one representative per group.
 	/// The empty string is the representative of the constant value zero.
-	std::map<YulString, VariableOffset> m_offsets;
+	YulStringMap<VariableOffset> m_offsets;
 	/// Last known value of each variable we queried.
-	std::map<YulString, Expression const*> m_lastKnownValue;
+	YulStringMap<Expression const*> m_lastKnownValue;
 	/// For each representative, variables that use it to offset from.
-	std::map<YulString, std::set<YulString>> m_groupMembers;
+	/// The members are ordered, so that the choice of a new representative is deterministic.
+	YulStringMap<std::set<YulString>> m_groupMembers;
 };
 
 }
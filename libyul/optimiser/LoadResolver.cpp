@@ -52,6 +52,22 @@ void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 	}(_ast);
 }
 
+void LoadResolver::runConcurrently(OptimiserStepContext& _context, Block& _ast, size_t _concurrency)
+{
+	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	YulStringMap<SideEffects> const functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	forEachTopLevelStatementConcurrently(_context, _ast, _concurrency, [&](Statement& _statement) {
+		LoadResolver resolver{
+			_context.dialect,
+			functionSideEffects,
+			containsMSize,
+			_context.expectedExecutionsPerDeployment
+		};
+		static_cast<ASTModifier&>(resolver).visit(_statement);
+	});
+}
+
 void LoadResolver::visit(Expression& _e)
 {
 	DataFlowAnalyzer::visit(_e);
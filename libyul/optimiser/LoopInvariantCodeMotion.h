@@ -49,7 +49,7 @@ private:
 	explicit LoopInvariantCodeMotion(
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables,
-		std::map<YulString, SideEffects> const& _functionSideEffects,
+		YulStringMap<SideEffects> const& _functionSideEffects,
 		bool _containsMSize
 	):
 		m_containsMSize(_containsMSize),
@@ -69,7 +69,7 @@ private:
 	bool m_containsMSize = true;
 	Dialect const& m_dialect;
 	std::set<YulString> const& m_ssaVariables;
-	std::map<YulString, SideEffects> const& m_functionSideEffects;
+	YulStringMap<SideEffects> const& m_functionSideEffects;
 };
 
 }
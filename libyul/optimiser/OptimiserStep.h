@@ -23,6 +23,8 @@
 #include <optional>
 #include <string>
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -39,6 +41,13 @@ struct OptimiserStepContext
 	std::set<YulString> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// If set, function-local steps run concurrently only process the top-level statements
+	/// for which the corresponding element is true.
+	std::vector<bool> const* selectedTopLevelStatements = nullptr;
+	/// If set, steps that report their modifications (see OptimiserStep::reportsModifications)
+	/// add the names of the top-level functions they modified and the empty name if they modified
+	/// the main block. Functions they removed do not have to be added.
+	std::set<YulString>* modifiedTopLevelStatements = nullptr;
 };
 
 
@@ -52,6 +61,19 @@ struct OptimiserStep
 	virtual ~OptimiserStep() = default;
 
 	virtual void run(OptimiserStepContext&, Block&) const = 0;
+	/// @returns true if the step supports runConcurrently. Such steps process the main block
+	/// and each function of code in the form established by FunctionGrouper independently
+	/// of each other and do not create new identifiers.
+	virtual bool isFunctionLocal() const = 0;
+	/// Has the same effect as run() but processes the main block and the function definitions
+	/// of @a _ast concurrently, using at most @a _concurrency threads.
+	/// Only processes the statements selected by OptimiserStepContext::selectedTopLevelStatements.
+	/// Requires @a _ast to be in the form established by FunctionGrouper.
+	virtual void runConcurrently(OptimiserStepContext&, Block&, size_t _concurrency) const = 0;
+	/// @returns true if the step adds the top-level statements it modifies to
+	/// OptimiserStepContext::modifiedTopLevelStatements. Such steps keep code in the form
+	/// established by FunctionGrouper in that form.
+	virtual bool reportsModifications() const = 0;
 	/// @returns non-nullopt if the step cannot be run, for example because it requires
 	/// an SMT solver to be loaded, but none is available. In that case, the string
 	/// contains a human-readable reason.
@@ -73,6 +95,30 @@ private:
 	public:
 		static constexpr bool value = decltype(test<T>(0))::value;
 	};
+	template<typename T>
+	struct HasRunConcurrentlyMethod
+	{
+	private:
+		template<typename U> static auto test(int) -> decltype(
+			U::runConcurrently(std::declval<OptimiserStepContext&>(), std::declval<Block&>(), size_t{}),
+			std::true_type()
+		);
+		template<typename> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<T>(0))::value;
+	};
+
+	template<typename T>
+	struct HasReportsModificationsMember
+	{
+	private:
+		template<typename U> static auto test(int) -> decltype(U::reportsModifications, std::true_type());
+		template<typename> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<T>(0))::value;
+	};
 
 public:
 	OptimiserStepInstance(): OptimiserStep{Step::name} {}
@@ -80,6 +126,24 @@ public:
 	{
 		Step::run(_context, _ast);
 	}
+	bool isFunctionLocal() const override
+	{
+		return HasRunConcurrentlyMethod<Step>::value;
+	}
+	void runConcurrently(OptimiserStepContext& _context, Block& _ast, size_t _concurrency) const override
+	{
+		if constexpr (HasRunConcurrentlyMethod<Step>::value)
+			Step::runConcurrently(_context, _ast, _concurrency);
+		else
+			yulAssert(false, "Step " + name + " is not function-local.");
+	}
+	bool reportsModifications() const override
+	{
+		if constexpr (HasReportsModificationsMember<Step>::value)
+			return Step::reportsModifications;
+		else
+			return false;
+	}
 	std::optional<std::string> invalidInCurrentEnvironment() const override
 	{
 		if constexpr (HasInvalidInCurrentEnvironmentMethod<Step>::value)
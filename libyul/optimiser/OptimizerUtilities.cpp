@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/OptimizerUtilities.h>
 
+#include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <libyul/Dialect.h>
@@ -28,6 +29,7 @@
 
 #include <liblangutil/Token.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
 
 #include <range/v3/action/remove_if.hpp>
 
@@ -55,6 +57,22 @@ void yul::removeEmptyBlocks(Block& _block)
 	ranges::actions::remove_if(_block.statements, isEmptyBlock);
 }
 
+void yul::forEachTopLevelStatementConcurrently(
+	OptimiserStepContext const& _context,
+	Block& _ast,
+	size_t _concurrency,
+	std::function<void(Statement&)> const& _visit
+)
+{
+	yulAssert(FunctionGrouper::isGrouped(_ast), "Code has to be grouped into main block and functions.");
+	std::vector<bool> const* selection = _context.selectedTopLevelStatements;
+	yulAssert(!selection || selection->size() == _ast.statements.size());
+	util::parallelFor(_concurrency, _ast.statements.size(), [&](size_t _index) {
+		if (!selection || (*selection)[_index])
+			_visit(_ast.statements[_index]);
+	});
+}
+
 bool yul::isRestrictedIdentifier(Dialect const& _dialect, YulString const& _identifier)
 {
 	return _identifier.empty() || hasLeadingOrTrailingDot(_identifier.str()) || TokenTraits::isYulKeyword(_identifier.str()) || _dialect.reservedIdentifier(_identifier);
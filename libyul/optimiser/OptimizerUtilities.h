@@ -26,8 +26,10 @@
 #include <libyul/Dialect.h>
 #include <libyul/YulString.h>
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <functional>
 #include <optional>
 
 namespace solidity::evmasm
@@ -43,6 +45,17 @@ namespace solidity::yul
 /// the canonical form.
 void removeEmptyBlocks(Block& _block);
 
+/// Calls @a _visit for the main block and for every function definition of @a _ast, which has to be
+/// in the form established by FunctionGrouper, using at most @a _concurrency threads.
+/// Skips the statements not selected by OptimiserStepContext::selectedTopLevelStatements.
+/// Used to implement function-local optimiser steps. @a _visit must not access other statements.
+void forEachTopLevelStatementConcurrently(
+	OptimiserStepContext const& _context,
+	Block& _ast,
+	size_t _concurrency,
+	std::function<void(Statement&)> const& _visit
+);
+
 /// Returns true if a given literal can not be used as an identifier.
 /// This includes Yul keywords and builtins of the given dialect.
 bool isRestrictedIdentifier(Dialect const& _dialect, YulString const& _identifier);
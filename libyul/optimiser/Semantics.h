@@ -24,6 +24,7 @@
 #include <libyul/AST.h>
 #include <libyul/Object.h>
 #include <libyul/SideEffects.h>
+#include <libyul/YulStringMap.h>
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 
@@ -42,23 +43,23 @@ class SideEffectsCollector: public ASTWalker
 public:
 	explicit SideEffectsCollector(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr
+		YulStringMap<SideEffects> const* _functionSideEffects = nullptr
 	): m_dialect(_dialect), m_functionSideEffects(_functionSideEffects) {}
 	SideEffectsCollector(
 		Dialect const& _dialect,
 		Expression const& _expression,
-		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr
+		YulStringMap<SideEffects> const* _functionSideEffects = nullptr
 	);
 	SideEffectsCollector(Dialect const& _dialect, Statement const& _statement);
 	SideEffectsCollector(
 		Dialect const& _dialect,
 		Block const& _ast,
-		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr
+		YulStringMap<SideEffects> const* _functionSideEffects = nullptr
 	);
 	SideEffectsCollector(
 		Dialect const& _dialect,
 		ForLoop const& _ast,
-		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr
+		YulStringMap<SideEffects> const* _functionSideEffects = nullptr
 	);
 
 	using ASTWalker::operator();
@@ -117,7 +118,7 @@ public:
 
 private:
 	Dialect const& m_dialect;
-	std::map<YulString, SideEffects> const* m_functionSideEffects = nullptr;
+	YulStringMap<SideEffects> const* m_functionSideEffects = nullptr;
 	SideEffects m_sideEffects;
 };
 
@@ -130,7 +131,7 @@ private:
 class SideEffectsPropagator
 {
 public:
-	static std::map<YulString, SideEffects> sideEffects(
+	static YulStringMap<SideEffects> sideEffects(
 		Dialect const& _dialect,
 		CallGraph const& _directCallGraph
 	);
@@ -195,7 +196,7 @@ class MovableChecker: public SideEffectsCollector
 public:
 	explicit MovableChecker(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr
+		YulStringMap<SideEffects> const* _functionSideEffects = nullptr
 	): SideEffectsCollector(_dialect, _functionSideEffects) {}
 	MovableChecker(Dialect const& _dialect, Expression const& _expression);
 
@@ -231,7 +232,7 @@ public:
 
 	TerminationFinder(
 		Dialect const& _dialect,
-		std::map<YulString, ControlFlowSideEffects> const* _functionSideEffects = nullptr
+		YulStringMap<ControlFlowSideEffects> const* _functionSideEffects = nullptr
 	): m_dialect(_dialect), m_functionSideEffects(_functionSideEffects) {}
 
 	/// @returns the index of the first statement in the provided sequence
@@ -256,7 +257,7 @@ public:
 
 private:
 	Dialect const& m_dialect;
-	std::map<YulString, ControlFlowSideEffects> const* m_functionSideEffects;
+	YulStringMap<ControlFlowSideEffects> const* m_functionSideEffects;
 };
 
 }
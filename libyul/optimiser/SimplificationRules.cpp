@@ -32,11 +32,45 @@
 #include <libevmasm/RuleList.h>
 #include <libsolutil/StringUtils.h>
 
+#include <mutex>
+
 using namespace solidity;
 using namespace solidity::evmasm;
 using namespace solidity::langutil;
 using namespace solidity::yul;
 
+namespace
+{
+
+/// @returns the expressions matched by the match groups of the patterns during the last match
+/// on the current thread.
+std::map<unsigned, Expression const*>& matchGroups()
+{
+	thread_local std::map<unsigned, Expression const*> groups;
+	return groups;
+}
+
+/// @returns the rules for @a _version, which are created once and shared by all threads.
+SimplificationRules const& rulesForVersion(std::optional<EVMVersion> _version)
+{
+	thread_local std::optional<EVMVersion> lastVersion;
+	thread_local SimplificationRules const* lastRules = nullptr;
+	if (lastRules && lastVersion == _version)
+		return *lastRules;
+
+	static std::mutex mutex;
+	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules const>> evmRules;
+	std::lock_guard lock(mutex);
+	auto& rules = evmRules[_version];
+	if (!rules)
+		rules = std::make_unique<SimplificationRules const>(_version);
+	lastVersion = _version;
+	lastRules = rules.get();
+	return *rules;
+}
+
+}
+
 SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	Expression const& _expr,
 	Dialect const& _dialect,
@@ -47,21 +81,16 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
-
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
 		version = evmDialect->evmVersion();
 
-	if (!evmRules[version])
-		evmRules[version] = std::make_unique<SimplificationRules>(version);
-
-	SimplificationRules& rules = *evmRules[version];
+	SimplificationRules const& rules = rulesForVersion(version);
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
 	{
-		rules.resetMatchGroups();
+		matchGroups().clear();
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
 				return &rule;
@@ -109,13 +138,13 @@ SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _ev
 	Pattern X;
 	Pattern Y;
 	Pattern Z;
-	A.setMatchGroup(1, m_matchGroups);
-	B.setMatchGroup(2, m_matchGroups);
-	C.setMatchGroup(3, m_matchGroups);
-	W.setMatchGroup(4, m_matchGroups);
-	X.setMatchGroup(5, m_matchGroups);
-	Y.setMatchGroup(6, m_matchGroups);
-	Z.setMatchGroup(7, m_matchGroups);
+	A.setMatchGroup(1);
+	B.setMatchGroup(2);
+	C.setMatchGroup(3);
+	W.setMatchGroup(4);
+	X.setMatchGroup(5);
+	Y.setMatchGroup(6);
+	Z.setMatchGroup(7);
 
 	addRules(simplificationRuleList(_evmVersion, A, B, C, W, X, Y, Z));
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
@@ -128,10 +157,9 @@ yul::Pattern::Pattern(evmasm::Instruction _instruction, std::initializer_list<Pa
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group)
 {
 	m_matchGroup = _group;
-	m_matchGroups = &_matchGroups;
 }
 
 bool Pattern::matches(
@@ -202,10 +230,11 @@ bool Pattern::matches(
 		// on the variables and not their values.
 		// The assumption is that CSE or local value numbering has been done prior to this step.
 
-		if (m_matchGroups->count(m_matchGroup))
+		std::map<unsigned, Expression const*>& groups = matchGroups();
+		if (groups.count(m_matchGroup))
 		{
 			assertThrow(m_kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
-			Expression const* firstMatch = (*m_matchGroups)[m_matchGroup];
+			Expression const* firstMatch = groups[m_matchGroup];
 			assertThrow(firstMatch, OptimizerException, "Match set but to null.");
 			assertThrow(
 				!std::holds_alternative<FunctionCall>(_expr) &&
@@ -217,12 +246,12 @@ bool Pattern::matches(
 			return SyntacticallyEqual{}(*firstMatch, _expr);
 		}
 		else if (m_kind == PatternKind::Any)
-			(*m_matchGroups)[m_matchGroup] = &_expr;
+			groups[m_matchGroup] = &_expr;
 		else
 		{
 			assertThrow(m_kind == PatternKind::Constant, OptimizerException, "Match group set for operation.");
 			// We do not use _expr here, because we want the actual number.
-			(*m_matchGroups)[m_matchGroup] = expr;
+			groups[m_matchGroup] = expr;
 		}
 	}
 	return true;
@@ -267,7 +296,7 @@ u256 Pattern::d() const
 Expression const& Pattern::matchGroupValue() const
 {
 	assertThrow(m_matchGroup > 0, OptimizerException, "");
-	assertThrow(!!m_matchGroups, OptimizerException, "");
-	assertThrow((*m_matchGroups)[m_matchGroup], OptimizerException, "");
-	return *(*m_matchGroups)[m_matchGroup];
+	std::map<unsigned, Expression const*>& groups = matchGroups();
+	assertThrow(groups[m_matchGroup], OptimizerException, "");
+	return *groups[m_matchGroup];
 }
@@ -16,6 +16,7 @@
 */
 // SPDX-License-Identifier: GPL-3.0
 #include <libyul/optimiser/StructuralSimplifier.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
 #include <libsolutil/CommonData.h>
@@ -85,6 +86,14 @@ void StructuralSimplifier::run(OptimiserStepContext&, Block& _ast)
 	StructuralSimplifier{}(_ast);
 }
 
+void StructuralSimplifier::runConcurrently(OptimiserStepContext& _context, Block& _ast, size_t _concurrency)
+{
+	forEachTopLevelStatementConcurrently(_context, _ast, _concurrency, [&](Statement& _statement) {
+		StructuralSimplifier simplifier;
+		static_cast<ASTModifier&>(simplifier).visit(_statement);
+	});
+}
+
 void StructuralSimplifier::operator()(Block& _block)
 {
 	simplify(_block.statements);
@@ -42,6 +42,7 @@ class StructuralSimplifier: public ASTModifier
 public:
 	static constexpr char const* name{"StructuralSimplifier"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static void runConcurrently(OptimiserStepContext&, Block& _ast, size_t _concurrency);
 
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
@@ -77,58 +77,43 @@
 
 #include <range/v3/view/map.hpp>
 #include <range/v3/action/remove.hpp>
+#include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/algorithm/count.hpp>
 #include <range/v3/algorithm/none_of.hpp>
 
+#include <chrono>
 #include <limits>
 #include <tuple>
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-#include <chrono>
-#include <fmt/format.h>
-#endif
-
 using namespace solidity;
 using namespace solidity::yul;
-#ifdef PROFILE_OPTIMIZER_STEPS
-using namespace std::chrono;
-#endif
 using namespace std::string_literals;
 
 namespace
 {
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-void outputPerformanceMetrics(map<string, int64_t> const& _metrics)
+/// @returns the number of statements and expressions in @a _ast, including function definitions.
+size_t nodeCount(Block const& _ast)
 {
-	vector<pair<string, int64_t>> durations(_metrics.begin(), _metrics.end());
-	sort(
-		durations.begin(),
-		durations.end(),
-		[](pair<string, int64_t> const& _lhs, pair<string, int64_t> const& _rhs) -> bool
-		{
-			return _lhs.second < _rhs.second;
-		}
-	);
-
-	int64_t totalDurationInMicroseconds = 0;
-	for (auto&& [step, durationInMicroseconds]: durations)
-		totalDurationInMicroseconds += durationInMicroseconds;
-
-	cerr << "Performance metrics of optimizer steps" << endl;
-	cerr << "======================================" << endl;
-	constexpr double microsecondsInSecond = 1000000;
-	for (auto&& [step, durationInMicroseconds]: durations)
-	{
-		double percentage = 100.0 * static_cast<double>(durationInMicroseconds) / static_cast<double>(totalDurationInMicroseconds);
-		double sec = static_cast<double>(durationInMicroseconds) / microsecondsInSecond;
-		cerr << fmt::format("{:>7.3f}% ({} s): {}", percentage, sec, step) << endl;
-	}
-	double totalDurationInSeconds = static_cast<double>(totalDurationInMicroseconds) / microsecondsInSecond;
-	cerr << "--------------------------------------" << endl;
-	cerr << fmt::format("{:>7}% ({:.3f} s)", 100, totalDurationInSeconds) << endl;
+	CodeWeights weights;
+	weights.expressionStatementCost = 1;
+	weights.assignmentCost = 1;
+	weights.variableDeclarationCost = 1;
+	weights.functionDefinitionCost = 1;
+	weights.ifCost = 1;
+	weights.switchCost = 1;
+	weights.caseCost = 1;
+	weights.forLoopCost = 1;
+	weights.breakCost = 1;
+	weights.continueCost = 1;
+	weights.leaveCost = 1;
+	weights.blockCost = 1;
+	weights.functionCallCost = 1;
+	weights.identifierCost = 1;
+	weights.literalCost = 1;
+	weights.literalZeroCost = 1;
+	return CodeSize::codeSizeIncludingFunctions(_ast, weights);
 }
-#endif
 
 }
 
@@ -141,7 +126,9 @@ void OptimiserSuite::run(
 	std::string_view _optimisationSequence,
 	std::string_view _optimisationCleanupSequence,
 	std::optional<size_t> _expectedExecutionsPerDeployment,
-	std::set<YulString> const& _externallyUsedIdentifiers
+	std::set<YulString> const& _externallyUsedIdentifiers,
+	size_t _concurrency,
+	OptimiserProfile* _profile
 )
 {
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
@@ -163,7 +150,7 @@ void OptimiserSuite::run(
 	NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
 	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
 
-	OptimiserSuite suite(context, Debug::None);
+	OptimiserSuite suite(context, Debug::None, _concurrency, false, _profile);
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -217,10 +204,6 @@ void OptimiserSuite::run(
 	NameSimplifier::run(suite.m_context, ast);
 	VarNameCleaner::run(suite.m_context, ast);
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-	outputPerformanceMetrics(suite.m_durationPerStepInMicroseconds);
-#endif
-
 	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
 }
 
@@ -245,9 +228,8 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static std::map<std::string, std::unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
+	static std::map<std::string, std::unique_ptr<OptimiserStep>> const instance =
+		optimiserStepCollection<
 			BlockFlattener,
 			CircularReferencesPruner,
 			CommonSubexpressionEliminator,
@@ -462,30 +444,44 @@ void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _as
 			subsequences.push_back({subsequence, true});
 	}
 
+	trackChanges(_ast);
 	// NOTE: If _repeatUntilStable is false, the value will not be used so do not calculate it.
-	size_t codeSize = (_repeatUntilStable ? CodeSize::codeSizeIncludingFunctions(_ast) : 0);
+	size_t size = (_repeatUntilStable ? codeSize(_ast) : 0);
 
-	for (size_t round = 0; round < MaxRounds; ++round)
+	size_t round = 0;
+	for (; round < MaxRounds; ++round)
 	{
 		for (auto const& [subsequence, repeat]: subsequences)
 		{
 			if (repeat)
 				runSequence(subsequence, _ast, true);
 			else
-				runSequence(abbreviationsToSteps(subsequence), _ast);
+				runSteps(abbreviationsToSteps(subsequence), _ast);
 		}
 
 		if (!_repeatUntilStable)
 			break;
 
-		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
-		if (newSize == codeSize)
+		size_t newSize = codeSize(_ast);
+		if (newSize == size)
 			break;
-		codeSize = newSize;
+		size = newSize;
 	}
+
+	if (m_profile && _repeatUntilStable)
+		m_profile->repetitions.push_back({
+			std::string(_stepAbbreviations),
+			std::min(round + 1, MaxRounds)
+		});
 }
 
 void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block& _ast)
+{
+	trackChanges(_ast);
+	runSteps(_steps, _ast);
+}
+
+void OptimiserSuite::runSteps(std::vector<std::string> const& _steps, Block& _ast)
 {
 	std::unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
@@ -494,14 +490,20 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 	{
 		if (m_debug == Debug::PrintStep)
 			std::cout << "Running " << step << std::endl;
-#ifdef PROFILE_OPTIMIZER_STEPS
-		steady_clock::time_point startTime = steady_clock::now();
-#endif
-		allSteps().at(step)->run(m_context, _ast);
-#ifdef PROFILE_OPTIMIZER_STEPS
-		steady_clock::time_point endTime = steady_clock::now();
-		m_durationPerStepInMicroseconds[step] += duration_cast<microseconds>(endTime - startTime).count();
-#endif
+		if (m_profile)
+		{
+			OptimiserProfile::StepRun stepRun{step, 0, nodeCount(_ast), 0, codeSize(_ast), 0};
+			auto startTime = std::chrono::steady_clock::now();
+			runStep(step, _ast);
+			auto endTime = std::chrono::steady_clock::now();
+			stepRun.durationInMicroseconds =
+				std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+			stepRun.nodesAfter = nodeCount(_ast);
+			stepRun.codeSizeAfter = codeSize(_ast);
+			m_profile->stepRuns.emplace_back(std::move(stepRun));
+		}
+		else
+			runStep(step, _ast);
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -516,3 +518,46 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 		}
 	}
 }
+
+void OptimiserSuite::runStep(std::string const& _step, Block& _ast)
+{
+	OptimiserStep const& optimiserStep = *allSteps().at(_step);
+	if (optimiserStep.isFunctionLocal() && m_changeTracker.tracking())
+	{
+		std::vector<bool> selection = m_changeTracker.statementsToProcess(_step, _ast);
+		if (ranges::any_of(selection, [](bool _selected) { return _selected; }))
+		{
+			ScopedSaveAndRestore selectionSetter(m_context.selectedTopLevelStatements, &selection);
+			optimiserStep.runConcurrently(m_context, _ast, m_concurrency);
+		}
+		m_changeTracker.update(_step, _ast, selection);
+	}
+	else if (optimiserStep.reportsModifications() && m_changeTracker.tracking())
+	{
+		std::set<YulString> modified;
+		ScopedSaveAndRestore modifiedSetter(m_context.modifiedTopLevelStatements, &modified);
+		optimiserStep.run(m_context, _ast);
+		m_changeTracker.update(_ast, modified);
+	}
+	else
+	{
+		if (m_concurrency != 1 && optimiserStep.isFunctionLocal() && FunctionGrouper::isGrouped(_ast))
+			optimiserStep.runConcurrently(m_context, _ast, m_concurrency);
+		else
+			optimiserStep.run(m_context, _ast);
+		trackChanges(_ast);
+	}
+}
+
+void OptimiserSuite::trackChanges(Block const& _ast)
+{
+	if (m_trackChanges)
+		m_changeTracker.update(_ast);
+}
+
+size_t OptimiserSuite::codeSize(Block const& _ast) const
+{
+	if (m_changeTracker.tracking())
+		return m_changeTracker.codeSize();
+	return CodeSize::codeSizeIncludingFunctions(_ast);
+}
@@ -23,14 +23,17 @@
 
 #include <libyul/ASTForward.h>
 #include <libyul/YulString.h>
+#include <libyul/optimiser/ChangeTracker.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <cstdint>
 #include <set>
 #include <string>
 #include <string_view>
 #include <memory>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -40,6 +43,38 @@ struct Dialect;
 class GasMeter;
 struct Object;
 
+/**
+ * Record of the work done by an optimiser suite, used to tune optimisation sequences
+ * against their cost. Recording it does not change the result of the optimisation.
+ */
+struct OptimiserProfile
+{
+	/// A single run of an optimiser step on the whole code.
+	struct StepRun
+	{
+		std::string step;
+		/// Wall time taken by the step, including the bookkeeping for tracking changes.
+		std::int64_t durationInMicroseconds = 0;
+		/// Number of statements and expressions before and after the step.
+		size_t nodesBefore = 0;
+		size_t nodesAfter = 0;
+		/// Value of CodeSize::codeSizeIncludingFunctions before and after the step.
+		size_t codeSizeBefore = 0;
+		size_t codeSizeAfter = 0;
+	};
+	/// A run of a bracketed subsequence, which is repeated until the code size is stable.
+	struct Repetition
+	{
+		std::string sequence;
+		size_t rounds = 0;
+	};
+
+	/// Step runs in the order of execution.
+	std::vector<StepRun> stepRuns;
+	/// Repetitions in the order of their completion, i.e. nested ones before the enclosing ones.
+	std::vector<Repetition> repetitions;
+};
+
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
  * Only optimizes the code of the provided object, does not descend into the sub-objects.
@@ -59,9 +94,31 @@ public:
 		PrintStep,
 		PrintChanges
 	};
-	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
+	/// @param _concurrency maximum number of threads used to run function-local steps
+	///        (see OptimiserStep::isFunctionLocal) on different functions concurrently.
+	/// @param _trackChanges if true, function-local steps are not run on the main block or
+	///        functions they did not change the last time, unless these or the functions they
+	///        call changed in the meantime (see ChangeTracker). Does not change the result.
+	///        Disabled by default, since it is not yet shown to make the optimiser faster.
+	/// @param _profile if not null, the steps and repetitions run by the suite are recorded there.
+	OptimiserSuite(
+		OptimiserStepContext& _context,
+		Debug _debug = Debug::None,
+		size_t _concurrency = 1,
+		bool _trackChanges = false,
+		OptimiserProfile* _profile = nullptr
+	):
+		m_context(_context),
+		m_debug(_debug),
+		m_concurrency(_concurrency),
+		m_trackChanges(_trackChanges),
+		m_changeTracker(_context.dialect, _concurrency),
+		m_profile(_profile)
+	{}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// The result does not depend on @a _concurrency.
+	/// If @a _profile is not null, the work done by the suite is recorded there.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -70,7 +127,9 @@ public:
 		std::string_view _optimisationSequence,
 		std::string_view _optimisationCleanupSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		size_t _concurrency = 1,
+		OptimiserProfile* _profile = nullptr
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -84,16 +143,29 @@ public:
 	void runSequence(std::vector<std::string> const& _steps, Block& _ast);
 	void runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable = false);
 
+	/// @returns how often function-local steps did not have to process the main block
+	/// or a function because changes are tracked.
+	size_t skippedStatements() const { return m_changeTracker.skippedStatements(); }
+
 	static std::map<std::string, std::unique_ptr<OptimiserStep>> const& allSteps();
 	static std::map<std::string, char> const& stepNameToAbbreviationMap();
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
+	void runSteps(std::vector<std::string> const& _steps, Block& _ast);
+	/// Runs @a _step on @a _ast, using the change tracker if possible.
+	void runStep(std::string const& _step, Block& _ast);
+	/// Updates m_changeTracker after arbitrary modifications of @a _ast.
+	void trackChanges(Block const& _ast);
+	/// @returns CodeSize::codeSizeIncludingFunctions of @a _ast.
+	size_t codeSize(Block const& _ast) const;
+
 	OptimiserStepContext& m_context;
 	Debug m_debug;
-#ifdef PROFILE_OPTIMIZER_STEPS
-	std::map<std::string, int64_t> m_durationPerStepInMicroseconds;
-#endif
+	size_t m_concurrency = 1;
+	bool m_trackChanges = false;
+	ChangeTracker m_changeTracker;
+	OptimiserProfile* m_profile = nullptr;
 };
 
 }
@@ -52,6 +52,22 @@ void UnusedAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	remover(_ast);
 }
 
+void UnusedAssignEliminator::runConcurrently(OptimiserStepContext& _context, Block& _ast, size_t _concurrency)
+{
+	YulStringMap<ControlFlowSideEffects> const controlFlowSideEffects =
+		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed();
+	forEachTopLevelStatementConcurrently(_context, _ast, _concurrency, [&](Statement& _statement) {
+		UnusedAssignEliminator uae{_context.dialect, controlFlowSideEffects};
+		static_cast<ASTWalker&>(uae).visit(_statement);
+
+		uae.m_storesToRemove += uae.m_allStores - uae.m_usedStores;
+
+		std::set<Statement const*> toRemove{uae.m_storesToRemove.begin(), uae.m_storesToRemove.end()};
+		StatementRemover remover{toRemove};
+		remover.visit(_statement);
+	});
+}
+
 void UnusedAssignEliminator::operator()(Identifier const& _identifier)
 {
 	markUsed(_identifier.name);
@@ -118,10 +118,11 @@ class UnusedAssignEliminator: public UnusedStoreBase
 public:
 	static constexpr char const* name{"UnusedAssignEliminator"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	static void runConcurrently(OptimiserStepContext&, Block& _ast, size_t _concurrency);
 
 	explicit UnusedAssignEliminator(
 		Dialect const& _dialect,
-		std::map<YulString, ControlFlowSideEffects> _controlFlowSideEffects
+		YulStringMap<ControlFlowSideEffects> _controlFlowSideEffects
 	):
 		UnusedStoreBase(_dialect),
 		m_controlFlowSideEffects(_controlFlowSideEffects)
@@ -144,7 +145,7 @@ private:
 	void markUsed(YulString _variable);
 
 	std::set<YulString> m_returnVariables;
-	std::map<YulString, ControlFlowSideEffects> m_controlFlowSideEffects;
+	YulStringMap<ControlFlowSideEffects> m_controlFlowSideEffects;
 };
 
 }
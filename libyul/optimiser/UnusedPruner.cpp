@@ -30,12 +30,19 @@
 #include <libyul/Dialect.h>
 #include <libyul/SideEffects.h>
 
+#include <libsolutil/Common.h>
+
 using namespace solidity;
 using namespace solidity::yul;
 
 void UnusedPruner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	UnusedPruner::runUntilStabilisedOnFullAST(_context.dialect, _ast, _context.reservedIdentifiers);
+	UnusedPruner::runUntilStabilisedOnFullAST(
+		_context.dialect,
+		_ast,
+		_context.reservedIdentifiers,
+		_context.modifiedTopLevelStatements
+	);
 	FunctionGrouper::run(_context, _ast);
 }
 
@@ -43,12 +50,14 @@ UnusedPruner::UnusedPruner(
 	Dialect const& _dialect,
 	Block& _ast,
 	bool _allowMSizeOptimization,
-	std::map<YulString, SideEffects> const* _functionSideEffects,
-	std::set<YulString> const& _externallyUsedFunctions
+	YulStringMap<SideEffects> const* _functionSideEffects,
+	std::set<YulString> const& _externallyUsedFunctions,
+	std::set<YulString>* _modifiedTopLevelStatements
 ):
 	m_dialect(_dialect),
 	m_allowMSizeOptimization(_allowMSizeOptimization),
-	m_functionSideEffects(_functionSideEffects)
+	m_functionSideEffects(_functionSideEffects),
+	m_modifiedTopLevelStatements(_modifiedTopLevelStatements)
 {
 	m_references = ReferencesCounter::countReferences(_ast);
 	for (auto const& f: _externallyUsedFunctions)
@@ -71,6 +80,8 @@ UnusedPruner::UnusedPruner(
 
 void UnusedPruner::operator()(Block& _block)
 {
+	size_t const statementCount = _block.statements.size();
+	bool replacedStatement = false;
 	for (auto&& statement: _block.statements)
 		if (std::holds_alternative<FunctionDefinition>(statement))
 		{
@@ -106,11 +117,14 @@ void UnusedPruner::operator()(Block& _block)
 					statement = Block{std::move(varDecl.debugData), {}};
 				}
 				else if (varDecl.variables.size() == 1 && m_dialect.discardFunction(varDecl.variables.front().type))
+				{
 					statement = ExpressionStatement{varDecl.debugData, FunctionCall{
 						varDecl.debugData,
 						{varDecl.debugData, m_dialect.discardFunction(varDecl.variables.front().type)->name},
 						{*std::move(varDecl.value)}
 					}};
+					replacedStatement = true;
+				}
 			}
 		}
 		else if (std::holds_alternative<ExpressionStatement>(statement))
@@ -126,24 +140,44 @@ void UnusedPruner::operator()(Block& _block)
 			}
 		}
 
+	// All other modifications replace statements by empty blocks.
 	removeEmptyBlocks(_block);
 
-	ASTModifier::operator()(_block);
+	if (!m_modifiedTopLevelStatements)
+		ASTModifier::operator()(_block);
+	else if (m_currentTopLevelStatement)
+	{
+		if (replacedStatement || _block.statements.size() != statementCount)
+			m_modifiedTopLevelStatements->insert(*m_currentTopLevelStatement);
+		ASTModifier::operator()(_block);
+	}
+	else
+		// This is the root block. Removed functions do not have to be reported.
+		for (Statement& statement: _block.statements)
+		{
+			FunctionDefinition const* function = std::get_if<FunctionDefinition>(&statement);
+			ScopedSaveAndRestore currentSetter(
+				m_currentTopLevelStatement,
+				std::optional<YulString>{function ? function->name : YulString{}}
+			);
+			visit(statement);
+		}
 }
 
 void UnusedPruner::runUntilStabilised(
 	Dialect const& _dialect,
 	Block& _ast,
 	bool _allowMSizeOptimization,
-	std::map<YulString, SideEffects> const* _functionSideEffects,
-	std::set<YulString> const& _externallyUsedFunctions
+	YulStringMap<SideEffects> const* _functionSideEffects,
+	std::set<YulString> const& _externallyUsedFunctions,
+	std::set<YulString>* _modifiedTopLevelStatements
 )
 {
 	while (true)
 	{
 		UnusedPruner pruner(
 			_dialect, _ast, _allowMSizeOptimization, _functionSideEffects,
-							_externallyUsedFunctions);
+							_externallyUsedFunctions, _modifiedTopLevelStatements);
 		pruner(_ast);
 		if (!pruner.shouldRunAgain())
 			return;
@@ -153,13 +187,21 @@ void UnusedPruner::runUntilStabilised(
 void UnusedPruner::runUntilStabilisedOnFullAST(
 	Dialect const& _dialect,
 	Block& _ast,
-	std::set<YulString> const& _externallyUsedFunctions
+	std::set<YulString> const& _externallyUsedFunctions,
+	std::set<YulString>* _modifiedTopLevelStatements
 )
 {
-	std::map<YulString, SideEffects> functionSideEffects =
+	YulStringMap<SideEffects> functionSideEffects =
 		SideEffectsPropagator::sideEffects(_dialect, CallGraphGenerator::callGraph(_ast));
 	bool allowMSizeOptimization = !MSizeFinder::containsMSize(_dialect, _ast);
-	runUntilStabilised(_dialect, _ast, allowMSizeOptimization, &functionSideEffects, _externallyUsedFunctions);
+	runUntilStabilised(
+		_dialect,
+		_ast,
+		allowMSizeOptimization,
+		&functionSideEffects,
+		_externallyUsedFunctions,
+		_modifiedTopLevelStatements
+	);
 }
 
 void UnusedPruner::runUntilStabilised(
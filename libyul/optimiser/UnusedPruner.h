@@ -24,8 +24,10 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/YulString.h>
+#include <libyul/YulStringMap.h>
 
 #include <map>
+#include <optional>
 #include <set>
 
 namespace solidity::yul
@@ -50,6 +52,7 @@ class UnusedPruner: public ASTModifier
 {
 public:
 	static constexpr char const* name{"UnusedPruner"};
+	static constexpr bool reportsModifications = true;
 	static void run(OptimiserStepContext& _context, Block& _ast);
 
 
@@ -60,12 +63,15 @@ public:
 	bool shouldRunAgain() const { return m_shouldRunAgain; }
 
 	// Run the pruner until the code does not change anymore.
+	// If @a _modifiedTopLevelStatements is not null, the names of the top-level functions that
+	// were modified but not removed and the empty name for a modified main block are added to it.
 	static void runUntilStabilised(
 		Dialect const& _dialect,
 		Block& _ast,
 		bool _allowMSizeOptimization,
-		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr,
-		std::set<YulString> const& _externallyUsedFunctions = {}
+		YulStringMap<SideEffects> const* _functionSideEffects = nullptr,
+		std::set<YulString> const& _externallyUsedFunctions = {},
+		std::set<YulString>* _modifiedTopLevelStatements = nullptr
 	);
 
 	static void run(
@@ -84,7 +90,8 @@ public:
 	static void runUntilStabilisedOnFullAST(
 		Dialect const& _dialect,
 		Block& _ast,
-		std::set<YulString> const& _externallyUsedFunctions = {}
+		std::set<YulString> const& _externallyUsedFunctions = {},
+		std::set<YulString>* _modifiedTopLevelStatements = nullptr
 	);
 
 	// Run the pruner until the code does not change anymore.
@@ -104,8 +111,9 @@ private:
 		Dialect const& _dialect,
 		Block& _ast,
 		bool _allowMSizeOptimization,
-		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr,
-		std::set<YulString> const& _externallyUsedFunctions = {}
+		YulStringMap<SideEffects> const* _functionSideEffects = nullptr,
+		std::set<YulString> const& _externallyUsedFunctions = {},
+		std::set<YulString>* _modifiedTopLevelStatements = nullptr
 	);
 	UnusedPruner(
 		Dialect const& _dialect,
@@ -119,9 +127,13 @@ private:
 
 	Dialect const& m_dialect;
 	bool m_allowMSizeOptimization = false;
-	std::map<YulString, SideEffects> const* m_functionSideEffects = nullptr;
+	YulStringMap<SideEffects> const* m_functionSideEffects = nullptr;
 	bool m_shouldRunAgain = false;
 	std::map<YulString, size_t> m_references;
+	std::set<YulString>* m_modifiedTopLevelStatements = nullptr;
+	/// Name of the top-level function visited or the empty name for the main block,
+	/// if modified statements are reported and the root block is not visited.
+	std::optional<YulString> m_currentTopLevelStatement;
 };
 
 }
@@ -51,7 +51,7 @@ static std::string const thirtyTwo{"@ 32"};
 
 void UnusedStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	std::map<YulString, SideEffects> functionSideEffects = SideEffectsPropagator::sideEffects(
+	YulStringMap<SideEffects> functionSideEffects = SideEffectsPropagator::sideEffects(
 		_context.dialect,
 		CallGraphGenerator::callGraph(_ast)
 	);
@@ -93,8 +93,8 @@ void UnusedStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
 
 UnusedStoreEliminator::UnusedStoreEliminator(
 	Dialect const& _dialect,
-	std::map<YulString, SideEffects> const& _functionSideEffects,
-	std::map<YulString, ControlFlowSideEffects> _controlFlowSideEffects,
+	YulStringMap<SideEffects> const& _functionSideEffects,
+	YulStringMap<ControlFlowSideEffects> _controlFlowSideEffects,
 	std::map<YulString, AssignedValue> const& _ssaValues,
 	bool _ignoreMemory
 ):
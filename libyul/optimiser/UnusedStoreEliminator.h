@@ -64,8 +64,8 @@ public:
 
 	explicit UnusedStoreEliminator(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> const& _functionSideEffects,
-		std::map<YulString, ControlFlowSideEffects> _controlFlowSideEffects,
+		YulStringMap<SideEffects> const& _functionSideEffects,
+		YulStringMap<ControlFlowSideEffects> _controlFlowSideEffects,
 		std::map<YulString, AssignedValue> const& _ssaValues,
 		bool _ignoreMemory
 	);
@@ -116,8 +116,8 @@ private:
 	std::optional<YulString> identifierNameIfSSA(Expression const& _expression) const;
 
 	bool const m_ignoreMemory;
-	std::map<YulString, SideEffects> const& m_functionSideEffects;
-	std::map<YulString, ControlFlowSideEffects> m_controlFlowSideEffects;
+	YulStringMap<SideEffects> const& m_functionSideEffects;
+	YulStringMap<ControlFlowSideEffects> m_controlFlowSideEffects;
 	std::map<YulString, AssignedValue> const& m_ssaValues;
 
 	std::map<Statement const*, Operation> m_storeOperations;
@@ -32,6 +32,7 @@
 #include <libsolidity/ast/ASTJsonExporter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
@@ -333,6 +334,31 @@ void CommandLineInterface::handleIROptimizedAst(std::string const& _contractName
 	}
 }
 
+void CommandLineInterface::handleYulOptimizerProfile(std::string const& _contractName)
+{
+	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	if (!m_options.optimizer.profileYul)
+		return;
+
+	if (!m_options.output.dir.empty())
+		createFile(
+			m_compiler->filesystemFriendlyName(_contractName) + "_yul_optimizer_profile.json",
+			util::jsonPrint(
+				m_compiler->yulOptimizerProfile(_contractName),
+				m_options.formatting.json
+			)
+		);
+	else
+	{
+		sout() << "Yul optimizer profile:" << std::endl;
+		sout() << util::jsonPrint(
+			m_compiler->yulOptimizerProfile(_contractName),
+			m_options.formatting.json
+		) << std::endl;
+	}
+}
+
 void CommandLineInterface::handleBytecode(std::string const& _contract)
 {
 	solAssert(
@@ -732,6 +758,10 @@ bool CommandLineInterface::parseArguments(int _argc, char const* const* _argv)
 
 void CommandLineInterface::processInput()
 {
+	if (!m_options.modelChecker.cacheDir.empty())
+		m_solverCommand.setCache(std::make_shared<CompilationCache>(m_options.modelChecker.cacheDir));
+	m_solverCommand.setSessions(m_options.modelChecker.solverSessions);
+
 	if (m_options.output.evmVersion < EVMVersion::constantinople())
 		report(
 			Error::Severity::Warning,
@@ -754,8 +784,11 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
-		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << std::endl;
+		bool outputComplete = compiler.compile(m_standardJsonInput.value(), sout());
+		sout() << std::endl;
 		m_standardJsonInput.reset();
+		if (!outputComplete)
+			solThrow(CommandLineExecutionError, "Internal error while writing the standard JSON output.");
 		break;
 	}
 	case InputMode::LanguageServer:
@@ -844,6 +877,18 @@ void CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.viaIR);
+		m_compiler->setParallelism(m_options.output.jobs);
+		// The AST, the assembly text, gas estimates and the optimizer profile are not stored in the cache.
+		if (
+			!m_options.output.cacheDir.empty() &&
+			!m_options.optimizer.profileYul &&
+			!m_options.compiler.estimateGas &&
+			!m_options.compiler.outputs.asm_ &&
+			!m_options.compiler.outputs.astCompactJson &&
+			!m_options.compiler.outputs.irOptimizedAstJson &&
+			!(m_options.compiler.combinedJsonRequests && m_options.compiler.combinedJsonRequests->ast)
+		)
+			m_compiler->setCompilationCache(std::make_shared<CompilationCache>(m_options.output.cacheDir));
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setEOFVersion(m_options.output.eofVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
@@ -854,7 +899,8 @@ void CommandLineInterface::compile()
 			m_options.compiler.outputs.ir ||
 			m_options.compiler.outputs.irOptimized ||
 			m_options.compiler.outputs.irAstJson ||
-			m_options.compiler.outputs.irOptimizedAstJson
+			m_options.compiler.outputs.irOptimizedAstJson ||
+			m_options.optimizer.profileYul
 		);
 		m_compiler->enableEvmBytecodeGeneration(
 			m_options.compiler.estimateGas ||
@@ -1234,6 +1280,12 @@ void CommandLineInterface::assembleYul(yul::YulStack::Language _language, yul::Y
 			sout() << stack.print() << std::endl;
 		}
 
+		if (m_options.optimizer.profileYul)
+		{
+			sout() << std::endl << "Yul optimizer profile:" << std::endl;
+			sout() << util::jsonPrint(stack.optimiserProfile(), m_options.formatting.json) << std::endl;
+		}
+
 		yul::MachineAssemblyObject object;
 		object = stack.assemble(_targetMachine);
 		object.bytecode->link(m_options.linker.libraries);
@@ -1274,7 +1326,10 @@ void CommandLineInterface::outputCompilationResults()
 
 	CompilerOutputs astOutputSelection;
 	astOutputSelection.astCompactJson = true;
-	if (m_options.compiler.outputs != CompilerOutputs() && m_options.compiler.outputs != astOutputSelection)
+	if (
+		(m_options.compiler.outputs != CompilerOutputs() && m_options.compiler.outputs != astOutputSelection) ||
+		m_options.optimizer.profileYul
+	)
 	{
 		// Currently AST is the only output allowed with --stop-after parsing. For all of the others
 		// we can safely assume that full compilation was performed and successful.
@@ -1295,6 +1350,7 @@ void CommandLineInterface::outputCompilationResults()
 			handleIRAst(contract);
 			handleIROptimized(contract);
 			handleIROptimizedAst(contract);
+			handleYulOptimizerProfile(contract);
 			handleSignatureHashes(contract);
 			handleMetadata(contract);
 			handleABI(contract);
@@ -44,6 +44,7 @@ static std::string const g_strAllowPaths = "allow-paths";
 static std::string const g_strBasePath = "base-path";
 static std::string const g_strIncludePath = "include-path";
 static std::string const g_strAssemble = "assemble";
+static std::string const g_strCacheDir = "cache-dir";
 static std::string const g_strCombinedJson = "combined-json";
 static std::string const g_strEVM = "evm";
 static std::string const g_strEVMVersion = "evm-version";
@@ -54,6 +55,7 @@ static std::string const g_strGas = "gas";
 static std::string const g_strHelp = "help";
 static std::string const g_strImportAst = "import-ast";
 static std::string const g_strImportEvmAssemblerJson = "import-asm-json";
+static std::string const g_strJobs = "jobs";
 static std::string const g_strInputFile = "input-file";
 static std::string const g_strYul = "yul";
 static std::string const g_strYulDialect = "yul-dialect";
@@ -67,18 +69,22 @@ static std::string const g_strMachine = "machine";
 static std::string const g_strNoCBORMetadata = "no-cbor-metadata";
 static std::string const g_strMetadataHash = "metadata-hash";
 static std::string const g_strMetadataLiteral = "metadata-literal";
+static std::string const g_strModelCheckerCache = "model-checker-cache";
 static std::string const g_strModelCheckerContracts = "model-checker-contracts";
 static std::string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static std::string const g_strModelCheckerEngine = "model-checker-engine";
 static std::string const g_strModelCheckerExtCalls = "model-checker-ext-calls";
 static std::string const g_strModelCheckerInvariants = "model-checker-invariants";
+static std::string const g_strModelCheckerPortfolio = "model-checker-portfolio";
 static std::string const g_strModelCheckerPrintQuery = "model-checker-print-query";
 static std::string const g_strModelCheckerShowProvedSafe = "model-checker-show-proved-safe";
 static std::string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
 static std::string const g_strModelCheckerShowUnsupported = "model-checker-show-unsupported";
+static std::string const g_strModelCheckerSolverSessions = "model-checker-solver-sessions";
 static std::string const g_strModelCheckerSolvers = "model-checker-solvers";
 static std::string const g_strModelCheckerTargets = "model-checker-targets";
 static std::string const g_strModelCheckerTimeout = "model-checker-timeout";
+static std::string const g_strModelCheckerWorkers = "model-checker-workers";
 static std::string const g_strModelCheckerBMCLoopIterations = "model-checker-bmc-loop-iterations";
 static std::string const g_strNone = "none";
 static std::string const g_strNoOptimizeYul = "no-optimize-yul";
@@ -89,6 +95,7 @@ static std::string const g_strOptimizeYul = "optimize-yul";
 static std::string const g_strYulOptimizations = "yul-optimizations";
 static std::string const g_strOutputDir = "output-dir";
 static std::string const g_strOverwrite = "overwrite";
+static std::string const g_strProfileYulOptimizer = "profile-yul-optimizer";
 static std::string const g_strRevertStrings = "revert-strings";
 static std::string const g_strStopAfter = "stop-after";
 static std::string const g_strParsing = "parsing";
@@ -235,6 +242,8 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
 		output.viaIR == _other.output.viaIR &&
+		output.jobs == _other.output.jobs &&
+		output.cacheDir == _other.output.cacheDir &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
@@ -256,7 +265,10 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.optimizeYul == _other.optimizer.optimizeYul &&
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.profileYul == _other.optimizer.profileYul &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
+		modelChecker.cacheDir == _other.modelChecker.cacheDir &&
+		modelChecker.solverSessions == _other.modelChecker.solverSessions &&
 		modelChecker.settings == _other.modelChecker.settings;
 }
 
@@ -290,6 +302,8 @@ OptimiserSettings CommandLineOptions::optimiserSettings() const
 			solAssert(settings.yulOptimiserCleanupSteps == OptimiserSettings::DefaultYulOptimiserCleanupSteps);
 	}
 
+	settings.profileYulOptimiser = optimizer.profileYul;
+
 	return settings;
 }
 
@@ -627,6 +641,19 @@ General Information)").c_str(),
 			g_strViaIR.c_str(),
 			"Turn on compilation mode via the IR."
 		)
+		(
+			g_strJobs.c_str(),
+			po::value<size_t>()->value_name("n"),
+			"Number of threads used to optimise and assemble contracts compiled via the IR. "
+			"Zero uses one thread per hardware thread. The output does not depend on this setting."
+		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Directory used to cache compilation artifacts across compiler runs. Sources whose contents, "
+			"imports and settings did not change are not recompiled. The cache is not used if the AST, "
+			"the EVM assembly or gas estimates are requested."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<std::string>()->value_name(util::joinHumanReadable(g_revertStringsArgs, ",")),
@@ -824,11 +851,23 @@ General Information)").c_str(),
 			po::value<std::string>()->value_name("steps"),
 			"Forces Yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strProfileYulOptimizer.c_str(),
+			"Output the optimizer steps run on the Yul code of each contract with their duration, "
+			"their effect on the size of the code and the number of rounds of each repeated part of the sequence. "
+			"Does not influence the generated code."
+		)
 	;
 	desc.add(optimizerOptions);
 
 	po::options_description smtCheckerOptions("Model Checker Options");
 	smtCheckerOptions.add_options()
+		(
+			g_strModelCheckerCache.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Directory used to record the responses of the SMT solvers called via their binaries across compiler runs. "
+			"Queries that were already answered by the same solver with the same options are not solved again."
+		)
 		(
 			g_strModelCheckerContracts.c_str(),
 			po::value<std::string>()->value_name("default,<source>:<contract>")->default_value("default"),
@@ -859,6 +898,13 @@ General Information)").c_str(),
 			" Multiple types of invariants can be selected at the same time, separated by a comma and no spaces."
 			" By default no invariants are reported."
 		)
+		(
+			g_strModelCheckerPortfolio.c_str(),
+			po::value<std::string>()->value_name("all,race")->default_value("all"),
+			"Select how BMC queries are sent to multiple solvers:"
+			" one after the other, reporting conflicting answers (all),"
+			" or concurrently, using the first answer and stopping the other solvers (race)."
+		)
 		(
 			g_strModelCheckerPrintQuery.c_str(),
 			"Print the queries created by the SMTChecker in the SMTLIB2 format."
@@ -875,6 +921,11 @@ General Information)").c_str(),
 			g_strModelCheckerShowUnsupported.c_str(),
 			"Show all unsupported language features separately."
 		)
+		(
+			g_strModelCheckerSolverSessions.c_str(),
+			"Keep the processes of SMT solvers called via their binaries running and stream the queries to them, "
+			"instead of starting a new process for every query. Only used for cvc5."
+		)
 		(
 			g_strModelCheckerSolvers.c_str(),
 			po::value<std::string>()->value_name("cvc5,eld,z3,smtlib2")->default_value("z3"),
@@ -894,6 +945,12 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit."
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerWorkers.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Set the number of threads solving the CHC queries of the verification targets concurrently. "
+			"0 means one per hardware thread. The default is 1."
+		)
 		(
 			g_strModelCheckerBMCLoopIterations.c_str(),
 			po::value<unsigned>(),
@@ -992,9 +1049,12 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerCache, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerDivModNoSlacks, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerEngine, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1003,8 +1063,10 @@ void CommandLineParser::processArgs()
 		{g_strModelCheckerShowProvedSafe, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnproved, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnsupported, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerSolverSessions, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson}},
 		{g_strModelCheckerSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTimeout, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerWorkers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerBMCLoopIterations, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}}
@@ -1032,6 +1094,7 @@ void CommandLineParser::processArgs()
 
 	checkMutuallyExclusive({g_strColor, g_strNoColor});
 	checkMutuallyExclusive({g_strStopAfter, g_strGas});
+	checkMutuallyExclusive({g_strStopAfter, g_strProfileYulOptimizer});
 
 	for (std::string const& option: CompilerOutputs::componentMap() | ranges::views::keys)
 		if (option != CompilerOutputs::componentName(&CompilerOutputs::astCompactJson))
@@ -1079,7 +1142,7 @@ void CommandLineParser::processArgs()
 				"Option --" + g_strOptimizeRuns + " is only valid in compiler and assembler modes."
 			);
 
-		for (std::string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations})
+		for (std::string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations, g_strProfileYulOptimizer})
 			if (m_args.count(option) > 0)
 				solThrow(
 					CommandLineValidationError,
@@ -1212,6 +1275,16 @@ void CommandLineParser::processArgs()
 		m_options.output.eofVersion = 1;
 	}
 
+	if (m_args.count(g_strJobs))
+		m_options.output.jobs = m_args[g_strJobs].as<size_t>();
+
+	if (m_args.count(g_strCacheDir))
+	{
+		m_options.output.cacheDir = m_args[g_strCacheDir].as<std::string>();
+		if (m_options.output.cacheDir.empty())
+			solThrow(CommandLineValidationError, "Option --" + g_strCacheDir + " requires a non-empty path.");
+	}
+
 	if (m_args.count(g_strNoOptimizeYul) > 0 && m_args.count(g_strOptimizeYul) > 0)
 		solThrow(
 			CommandLineValidationError,
@@ -1254,6 +1327,8 @@ void CommandLineParser::processArgs()
 		m_options.optimizer.yulSteps = m_args[g_strYulOptimizations].as<std::string>();
 	}
 
+	m_options.optimizer.profileYul = (m_args.count(g_strProfileYulOptimizer) > 0);
+
 	if (m_options.input.mode == InputMode::Assembler)
 	{
 		std::vector<std::string> const nonAssemblyModeOptions = {
@@ -1336,6 +1411,15 @@ void CommandLineParser::processArgs()
 		m_options.metadata.format = CompilerStack::MetadataFormat::NoMetadata;
 	}
 
+	if (m_args.count(g_strModelCheckerCache))
+	{
+		m_options.modelChecker.cacheDir = m_args[g_strModelCheckerCache].as<std::string>();
+		if (m_options.modelChecker.cacheDir.empty())
+			solThrow(CommandLineValidationError, "Option --" + g_strModelCheckerCache + " requires a non-empty path.");
+	}
+
+	m_options.modelChecker.solverSessions = (m_args.count(g_strModelCheckerSolverSessions) > 0);
+
 	if (m_args.count(g_strModelCheckerContracts))
 	{
 		std::string contractsStr = m_args[g_strModelCheckerContracts].as<std::string>();
@@ -1375,6 +1459,15 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.invariants = *invs;
 	}
 
+	if (m_args.count(g_strModelCheckerPortfolio))
+	{
+		std::string mode = m_args[g_strModelCheckerPortfolio].as<std::string>();
+		std::optional<ModelCheckerPortfolio> portfolio = ModelCheckerPortfolio::fromString(mode);
+		if (!portfolio)
+			solThrow(CommandLineValidationError, "Invalid option for --" + g_strModelCheckerPortfolio + ": " + mode);
+		m_options.modelChecker.settings.portfolio = *portfolio;
+	}
+
 	if (m_args.count(g_strModelCheckerShowProvedSafe))
 		m_options.modelChecker.settings.showProvedSafe = true;
 
@@ -1412,6 +1505,9 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strModelCheckerTimeout))
 		m_options.modelChecker.settings.timeout = m_args[g_strModelCheckerTimeout].as<unsigned>();
 
+	if (m_args.count(g_strModelCheckerWorkers))
+		m_options.modelChecker.settings.workers = m_args[g_strModelCheckerWorkers].as<unsigned>();
+
 	if (m_args.count(g_strModelCheckerBMCLoopIterations))
 	{
 		if (!m_options.modelChecker.settings.engine.bmc)
@@ -1426,12 +1522,14 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerEngine) ||
 		m_args.count(g_strModelCheckerExtCalls) ||
 		m_args.count(g_strModelCheckerInvariants) ||
+		m_args.count(g_strModelCheckerPortfolio) ||
 		m_args.count(g_strModelCheckerShowProvedSafe) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
 		m_args.count(g_strModelCheckerShowUnsupported) ||
 		m_args.count(g_strModelCheckerSolvers) ||
 		m_args.count(g_strModelCheckerTargets) ||
-		m_args.count(g_strModelCheckerTimeout);
+		m_args.count(g_strModelCheckerTimeout) ||
+		m_args.count(g_strModelCheckerWorkers);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 
 	solAssert(
@@ -184,6 +184,8 @@ struct CommandLineOptions
 		bool overwriteFiles = false;
 		langutil::EVMVersion evmVersion;
 		bool viaIR = false;
+		size_t jobs = 1;
+		boost::filesystem::path cacheDir;
 		RevertStrings revertStrings = RevertStrings::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
@@ -228,12 +230,16 @@ struct CommandLineOptions
 		bool optimizeYul = false;
 		std::optional<unsigned> expectedExecutionsPerDeployment;
 		std::optional<std::string> yulSteps;
+		bool profileYul = false;
 	} optimizer;
 
 	struct
 	{
 		bool initialize = false;
 		ModelCheckerSettings settings;
+		/// Directory of the persistent store of SMT solver responses. Not used if empty.
+		boost::filesystem::path cacheDir;
+		bool solverSessions = false;
 	} modelChecker;
 };
 
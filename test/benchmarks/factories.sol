@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.8.0;
+
+// A pool contract of moderate size that is created by nine different factories.
+// Via the IR, the code of a created contract is embedded into the code of every contract creating it.
+contract Pool {
+    struct Position {
+        uint128 liquidity;
+        uint64 lastUpdate;
+        uint64 feeGrowth;
+    }
+
+    event Deposit(address indexed owner, uint256 amount, uint256 shares);
+    event Withdrawal(address indexed owner, uint256 amount, uint256 shares);
+    event Transfer(address indexed from, address indexed to, uint256 value);
+    event Approval(address indexed owner, address indexed spender, uint256 value);
+
+    error InsufficientBalance(uint256 available, uint256 required);
+    error InsufficientAllowance(uint256 available, uint256 required);
+    error Paused();
+    error Unauthorized(address caller);
+
+    string public name;
+    string public symbol;
+    address public immutable factory;
+    address public owner;
+    uint8 public immutable feeBasisPoints;
+    bool public paused;
+
+    uint256 public totalSupply;
+    uint256 public totalAssets;
+    mapping(address => uint256) public balanceOf;
+    mapping(address => mapping(address => uint256)) public allowance;
+    mapping(address => Position) public positions;
+    address[] public holders;
+
+    modifier onlyOwner() {
+        if (msg.sender != owner)
+            revert Unauthorized(msg.sender);
+        _;
+    }
+
+    modifier whenNotPaused() {
+        if (paused)
+            revert Paused();
+        _;
+    }
+
+    constructor(string memory _name, string memory _symbol, address _owner, uint8 _feeBasisPoints) {
+        name = _name;
+        symbol = _symbol;
+        owner = _owner;
+        factory = msg.sender;
+        feeBasisPoints = _feeBasisPoints;
+    }
+
+    function setPaused(bool _paused) external onlyOwner {
+        paused = _paused;
+    }
+
+    function transferOwnership(address _owner) external onlyOwner {
+        owner = _owner;
+    }
+
+    function convertToShares(uint256 _assets) public view returns (uint256) {
+        return totalSupply == 0 ? _assets : _assets * totalSupply / totalAssets;
+    }
+
+    function convertToAssets(uint256 _shares) public view returns (uint256) {
+        return totalSupply == 0 ? _shares : _shares * totalAssets / totalSupply;
+    }
+
+    function deposit() external payable whenNotPaused returns (uint256 shares) {
+        uint256 fee = msg.value * feeBasisPoints / 10000;
+        shares = convertToShares(msg.value - fee);
+        if (balanceOf[msg.sender] == 0)
+            holders.push(msg.sender);
+        _mint(msg.sender, shares);
+        totalAssets += msg.value - fee;
+        _updatePosition(msg.sender, int256(shares));
+        emit Deposit(msg.sender, msg.value, shares);
+    }
+
+    function withdraw(uint256 _shares) external whenNotPaused returns (uint256 assets) {
+        assets = convertToAssets(_shares);
+        _burn(msg.sender, _shares);
+        totalAssets -= assets;
+        _updatePosition(msg.sender, -int256(_shares));
+        emit Withdrawal(msg.sender, assets, _shares);
+        (bool success, ) = msg.sender.call{value: assets}("");
+        require(success, "Transfer failed");
+    }
+
+    function transfer(address _to, uint256 _value) external returns (bool) {
+        _transfer(msg.sender, _to, _value);
+        return true;
+    }
+
+    function approve(address _spender, uint256 _value) external returns (bool) {
+        allowance[msg.sender][_spender] = _value;
+        emit Approval(msg.sender, _spender, _value);
+        return true;
+    }
+
+    function transferFrom(address _from, address _to, uint256 _value) external returns (bool) {
+        uint256 allowed = allowance[_from][msg.sender];
+        if (allowed != type(uint256).max) {
+            if (allowed < _value)
+                revert InsufficientAllowance(allowed, _value);
+            allowance[_from][msg.sender] = allowed - _value;
+        }
+        _transfer(_from, _to, _value);
+        return true;
+    }
+
+    function holderBalances(uint256 _start, uint256 _count) external view returns (address[] memory accounts, uint256[] memory balances) {
+        uint256 end = _start + _count > holders.length ? holders.length : _start + _count;
+        accounts = new address[](end - _start);
+        balances = new uint256[](end - _start);
+        for (uint256 i = _start; i < end; ++i) {
+            accounts[i - _start] = holders[i];
+            balances[i - _start] = balanceOf[holders[i]];
+        }
+    }
+
+    function _transfer(address _from, address _to, uint256 _value) internal whenNotPaused {
+        uint256 available = balanceOf[_from];
+        if (available < _value)
+            revert InsufficientBalance(available, _value);
+        unchecked {
+            balanceOf[_from] = available - _value;
+        }
+        if (balanceOf[_to] == 0)
+            holders.push(_to);
+        balanceOf[_to] += _value;
+        _updatePosition(_from, -int256(_value));
+        _updatePosition(_to, int256(_value));
+        emit Transfer(_from, _to, _value);
+    }
+
+    function _mint(address _to, uint256 _value) internal {
+        totalSupply += _value;
+        balanceOf[_to] += _value;
+        emit Transfer(address(0), _to, _value);
+    }
+
+    function _burn(address _from, uint256 _value) internal {
+        uint256 available = balanceOf[_from];
+        if (available < _value)
+            revert InsufficientBalance(available, _value);
+        unchecked {
+            balanceOf[_from] = available - _value;
+            totalSupply -= _value;
+        }
+        emit Transfer(_from, address(0), _value);
+    }
+
+    function _updatePosition(address _account, int256 _delta) internal {
+        Position storage position = positions[_account];
+        uint256 elapsed = block.timestamp - position.lastUpdate;
+        position.feeGrowth += uint64(elapsed * position.liquidity / 1e18);
+        position.liquidity = uint128(uint256(int256(uint256(position.liquidity)) + _delta));
+        position.lastUpdate = uint64(block.timestamp);
+    }
+}
+
+abstract contract PoolFactory {
+    Pool[] public pools;
+    mapping(bytes32 => Pool) public poolByKey;
+
+    event PoolCreated(Pool pool, string name);
+
+    function feeBasisPoints() internal pure virtual returns (uint8);
+
+    function createPool(string calldata _name, string calldata _symbol) external returns (Pool pool) {
+        bytes32 key = keccak256(abi.encode(_name, _symbol));
+        require(address(poolByKey[key]) == address(0), "Pool exists");
+        pool = new Pool{salt: key}(_name, _symbol, msg.sender, feeBasisPoints());
+        pools.push(pool);
+        poolByKey[key] = pool;
+        emit PoolCreated(pool, _name);
+    }
+
+    function poolCount() external view returns (uint256) {
+        return pools.length;
+    }
+}
+
+contract StablePoolFactory is PoolFactory {
+    function feeBasisPoints() internal pure override returns (uint8) { return 1; }
+}
+
+contract LowFeePoolFactory is PoolFactory {
+    function feeBasisPoints() internal pure override returns (uint8) { return 5; }
+}
+
+contract StandardPoolFactory is PoolFactory {
+    function feeBasisPoints() internal pure override returns (uint8) { return 30; }
+}
+
+contract HighFeePoolFactory is PoolFactory {
+    function feeBasisPoints() internal pure override returns (uint8) { return 100; }
+}
+
+contract ExoticPoolFactory is PoolFactory {
+    function feeBasisPoints() internal pure override returns (uint8) { return 200; }
+}
+
+contract PermissionedPoolFactory is PoolFactory {
+    address public immutable admin = msg.sender;
+
+    function feeBasisPoints() internal pure override returns (uint8) { return 10; }
+
+    function createPermissioned(string calldata _name, address _owner) external returns (Pool) {
+        require(msg.sender == admin, "Not admin");
+        return new Pool(_name, _name, _owner, feeBasisPoints());
+    }
+}
+
+contract BatchPoolFactory {
+    function createBatch(string[] calldata _names, uint8 _fee) external returns (Pool[] memory pools) {
+        pools = new Pool[](_names.length);
+        for (uint256 i = 0; i < _names.length; ++i)
+            pools[i] = new Pool(_names[i], _names[i], msg.sender, _fee);
+    }
+}
+
+contract MigrationFactory {
+    Pool public immutable genesisPool = new Pool("Genesis", "GEN", msg.sender, 0);
+
+    function migrate(string calldata _name) external returns (Pool) {
+        return new Pool(_name, _name, msg.sender, 0);
+    }
+}
+
+contract CloneRegistry {
+    mapping(address => Pool[]) public poolsOf;
+
+    function deploy(string calldata _name, uint8 _fee) external returns (Pool pool) {
+        pool = new Pool(_name, _name, msg.sender, _fee);
+        poolsOf[msg.sender].push(pool);
+    }
+
+    function poolCode() external pure returns (bytes memory) {
+        return type(Pool).creationCode;
+    }
+}
@@ -67,7 +67,7 @@ function benchmark_contract {
         "$(< "${output_dir}/time-and-status-${pipeline}.txt")"
 }
 
-benchmarks=("verifier.sol" "OptimizorClub.sol" "chains.sol")
+benchmarks=("verifier.sol" "OptimizorClub.sol" "chains.sol" "factories.sol")
 time_bin_path=$(type -P time)
 
 echo "| File                 | Pipeline | Bytecode size | Time     | Exit code |"
@@ -0,0 +1,95 @@
+#!/usr/bin/env bash
+
+#------------------------------------------------------------------------------
+# Bash script comparing the compilation time of the optimized via-IR pipeline
+# when run on a single thread and on multiple threads.
+# ------------------------------------------------------------------------------
+# This file is part of solidity.
+#
+# solidity is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# solidity is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with solidity.  If not, see <http://www.gnu.org/licenses/>
+#
+# (c) 2024 solidity contributors.
+#------------------------------------------------------------------------------
+
+set -euo pipefail
+
+REPO_ROOT=$(cd "$(dirname "$0")/../../" && pwd)
+SOLIDITY_BUILD_DIR=${SOLIDITY_BUILD_DIR:-${REPO_ROOT}/build}
+
+# shellcheck source=scripts/common.sh
+source "${REPO_ROOT}/scripts/common.sh"
+# shellcheck source=scripts/common_cmdline.sh
+source "${REPO_ROOT}/scripts/common_cmdline.sh"
+
+(( $# <= 2 )) || fail "Too many arguments. Usage: parallel.sh [<solc-path>] [<jobs>]"
+
+solc="${1:-${SOLIDITY_BUILD_DIR}/solc/solc}"
+jobs="${2:-$(nproc)}"
+command_available "$solc" --version
+
+output_dir=$(mktemp -d -t solc-benchmark-XXXXXX)
+
+function cleanup() {
+    rm -r "${output_dir}"
+    exit
+}
+
+trap cleanup SIGINT SIGTERM
+
+function benchmark_contract {
+    local job_count="$1"
+    local input_path="$2"
+
+    local solc_command=("${solc}" --via-ir --optimize --bin --jobs "$job_count" "${input_path}")
+    local time_args=(--output "${output_dir}/time-${job_count}.txt" --quiet --format '%e')
+
+    "$time_bin_path" \
+        "${time_args[@]}" \
+        "${solc_command[@]}" \
+        > "${output_dir}/bytecode-${job_count}.bin" \
+        2>> "${output_dir}/benchmark-warn-err.txt"
+
+    cat "${output_dir}/time-${job_count}.txt"
+}
+
+benchmarks=("verifier.sol" "OptimizorClub.sol" "chains.sol" "factories.sol")
+time_bin_path=$(type -P time)
+
+echo "| File                 | Jobs | Time (1 job) | Time (${jobs} jobs) | Speedup |"
+echo "|----------------------|-----:|-------------:|-------------:|--------:|"
+
+for input_file in "${benchmarks[@]}"
+do
+    serial_time=$(benchmark_contract 1 "${REPO_ROOT}/test/benchmarks/${input_file}")
+    parallel_time=$(benchmark_contract "$jobs" "${REPO_ROOT}/test/benchmarks/${input_file}")
+
+    # The output must not depend on the number of threads.
+    cmp --silent "${output_dir}/bytecode-1.bin" "${output_dir}/bytecode-${jobs}.bin" || \
+        fail "Bytecode of ${input_file} differs between 1 and ${jobs} jobs."
+
+    printf '| %-20s | %4d | %10s s | %10s s | %6sx |\n' \
+        '`'"$input_file"'`' \
+        "$jobs" \
+        "$serial_time" \
+        "$parallel_time" \
+        "$(awk "BEGIN { printf \"%.2f\", ${serial_time} / (${parallel_time} > 0 ? ${parallel_time} : 0.01) }")"
+done
+
+echo
+echo "======================================================="
+echo "Warnings and errors generated during run:"
+echo "======================================================="
+echo "$(< "${output_dir}/benchmark-warn-err.txt")"
+
+cleanup
@@ -0,0 +1,10 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.6.0;
+pragma abicoder v2;
+
+contract C {}
+contract D {
+    function f() public {
+        C c = new C();
+    }
+}
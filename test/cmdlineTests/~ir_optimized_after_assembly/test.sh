@@ -0,0 +1,49 @@
+#!/usr/bin/env bash
+set -eo pipefail
+
+# shellcheck source=scripts/common.sh
+source "${REPO_ROOT}/scripts/common.sh"
+
+# The optimized IR is printed from the Yul object that is assembled into the bytecode and whose
+# sub-objects are reused by the contracts creating them. Printing it must give the same output
+# regardless of whether the object has been assembled before.
+function test_ir_optimized_after_assembly()
+{
+    (( $# <= 2 )) || fail "This function accepts at most two arguments."
+    local solidity_file="$1"
+    local optimize_flag="$2"
+    [[ $optimize_flag == --optimize || $optimize_flag == "" ]] || assertFail "The second argument must be --optimize if present."
+
+    local optimizer_flags=()
+    [[ $optimize_flag == "" ]] || optimizer_flags+=("$optimize_flag")
+
+    SOLTMPDIR=$(mktemp -d -t "cmdline-test-ir-optimized-after-assembly-XXXXXX")
+
+    msg_on_error --no-stderr \
+        "$SOLC" --ir-optimized --ir-optimized-ast --debug-info all "${optimizer_flags[@]}" \
+            "$solidity_file" -o "${SOLTMPDIR}/without_assembly"
+    msg_on_error --no-stderr \
+        "$SOLC" --via-ir --bin --asm --ir-optimized --ir-optimized-ast --debug-info all "${optimizer_flags[@]}" \
+            "$solidity_file" -o "${SOLTMPDIR}/with_assembly"
+
+    # Only compare the files present in both directories, i.e. the optimized IR and its AST.
+    diff_values \
+        "$(cd "${SOLTMPDIR}/without_assembly" && find . -type f | sort | xargs cat)" \
+        "$(cd "${SOLTMPDIR}/with_assembly" && find . -type f -name '*_opt*' | sort | xargs cat)"
+
+    rm -r "$SOLTMPDIR"
+}
+
+contracts=(
+    externalTests/solc-js/DAO/TokenCreation.sol
+    libsolidity/semanticTests/externalContracts/deposit_contract.sol
+    libsolidity/semanticTests/externalContracts/snark.sol
+)
+
+for contractFile in "${contracts[@]}"
+do
+    printTask "    - ${contractFile}"
+    test_ir_optimized_after_assembly "${REPO_ROOT}/test/${contractFile}"
+    printTask "    - ${contractFile} (optimized)"
+    test_ir_optimized_after_assembly "${REPO_ROOT}/test/${contractFile}" --optimize
+done
@@ -0,0 +1,198 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the way SMTPortfolio combines the answers of its solvers.
+ */
+
+#include <libsmtutil/SMTPortfolio.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <condition_variable>
+#include <mutex>
+
+using namespace solidity::smtutil;
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+/// Solver that answers every query with a fixed result or, if it has none,
+/// blocks until it is interrupted and then returns UNKNOWN.
+/// Like the real solvers, it gives up on a check right away if it was interrupted before.
+class FakeSolver: public SolverInterface
+{
+public:
+	/// @param _startsLate if true, checks only start after the solver was interrupted,
+	/// as if the thread of the solver was scheduled after another solver answered.
+	explicit FakeSolver(std::optional<CheckResult> _result, bool _startsLate = false):
+		m_result(_result), m_startsLate(_startsLate)
+	{}
+
+	void reset() override {}
+	void push() override {}
+	void pop() override {}
+	void declareVariable(std::string const&, SortPointer const&) override {}
+	void addAssertion(Expression const&) override {}
+
+	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const&) override
+	{
+		std::unique_lock lock(m_mutex);
+		if (m_startsLate)
+			m_interruptedCondition.wait(lock, [&] { return m_interruptRequested; });
+		if (m_interruptRequested)
+			return {CheckResult::UNKNOWN, {}};
+		++m_solvedChecks;
+		if (m_result)
+			return {*m_result, {}};
+		m_interruptedCondition.wait(lock, [&] { return m_interruptRequested; });
+		return {CheckResult::UNKNOWN, {}};
+	}
+
+	void interrupt() override
+	{
+		std::lock_guard lock(m_mutex);
+		m_interruptRequested = true;
+		++m_interruptions;
+		m_interruptedCondition.notify_all();
+	}
+
+	void clearInterrupt() override
+	{
+		std::lock_guard lock(m_mutex);
+		m_interruptRequested = false;
+	}
+
+	/// @returns true if interrupt() was ever called.
+	bool interrupted()
+	{
+		std::lock_guard lock(m_mutex);
+		return m_interruptions > 0;
+	}
+
+	/// @returns true if an interrupt is in effect.
+	bool interruptRequested()
+	{
+		std::lock_guard lock(m_mutex);
+		return m_interruptRequested;
+	}
+
+	/// @returns how many checks the solver did not give up on right away.
+	size_t solvedChecks()
+	{
+		std::lock_guard lock(m_mutex);
+		return m_solvedChecks;
+	}
+
+private:
+	std::optional<CheckResult> m_result;
+	bool m_startsLate = false;
+	std::mutex m_mutex;
+	std::condition_variable m_interruptedCondition;
+	bool m_interruptRequested = false;
+	size_t m_interruptions = 0;
+	size_t m_solvedChecks = 0;
+};
+
+CheckResult check(SMTPortfolio::Mode _mode, std::vector<std::optional<CheckResult>> const& _results)
+{
+	std::vector<std::unique_ptr<SolverInterface>> solvers;
+	for (std::optional<CheckResult> result: _results)
+		solvers.emplace_back(std::make_unique<FakeSolver>(result));
+	SMTPortfolio portfolio(std::move(solvers), {}, _mode);
+	return portfolio.check({}).first;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioTest)
+
+BOOST_AUTO_TEST_CASE(wait_for_all)
+{
+	auto const mode = SMTPortfolio::Mode::WaitForAll;
+	BOOST_CHECK(check(mode, {CheckResult::UNKNOWN, CheckResult::SATISFIABLE}) == CheckResult::SATISFIABLE);
+	BOOST_CHECK(check(mode, {CheckResult::ERROR, CheckResult::UNKNOWN}) == CheckResult::UNKNOWN);
+	BOOST_CHECK(check(mode, {CheckResult::ERROR, CheckResult::ERROR}) == CheckResult::ERROR);
+	BOOST_CHECK(check(mode, {CheckResult::SATISFIABLE, CheckResult::UNSATISFIABLE}) == CheckResult::CONFLICTING);
+}
+
+BOOST_AUTO_TEST_CASE(race)
+{
+	auto const mode = SMTPortfolio::Mode::Race;
+	BOOST_CHECK(check(mode, {CheckResult::UNKNOWN, CheckResult::SATISFIABLE}) == CheckResult::SATISFIABLE);
+	BOOST_CHECK(check(mode, {CheckResult::ERROR, CheckResult::UNKNOWN}) == CheckResult::UNKNOWN);
+	BOOST_CHECK(check(mode, {CheckResult::ERROR, CheckResult::ERROR}) == CheckResult::ERROR);
+	// Only returns because the first answer interrupts the blocking solvers.
+	BOOST_CHECK(check(mode, {std::nullopt, CheckResult::UNSATISFIABLE, std::nullopt}) == CheckResult::UNSATISFIABLE);
+}
+
+BOOST_AUTO_TEST_CASE(race_interrupts_only_running_solvers)
+{
+	std::vector<std::unique_ptr<SolverInterface>> solvers;
+	solvers.emplace_back(std::make_unique<FakeSolver>(std::nullopt));
+	solvers.emplace_back(std::make_unique<FakeSolver>(CheckResult::SATISFIABLE));
+	auto* blocking = dynamic_cast<FakeSolver*>(solvers[0].get());
+	auto* answering = dynamic_cast<FakeSolver*>(solvers[1].get());
+	SMTPortfolio portfolio(std::move(solvers), {}, SMTPortfolio::Mode::Race);
+
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(blocking->interrupted());
+	BOOST_CHECK(!answering->interrupted());
+}
+
+BOOST_AUTO_TEST_CASE(race_interrupts_solvers_that_have_not_started)
+{
+	std::vector<std::unique_ptr<SolverInterface>> solvers;
+	solvers.emplace_back(std::make_unique<FakeSolver>(CheckResult::UNSATISFIABLE, true));
+	solvers.emplace_back(std::make_unique<FakeSolver>(CheckResult::SATISFIABLE));
+	auto* late = dynamic_cast<FakeSolver*>(solvers[0].get());
+	auto* answering = dynamic_cast<FakeSolver*>(solvers[1].get());
+	SMTPortfolio portfolio(std::move(solvers), {}, SMTPortfolio::Mode::Race);
+
+	// The late solver starts its check after it was interrupted, so it gives up
+	// instead of solving the query and its answer does not conflict with the first one.
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(late->interrupted());
+	BOOST_CHECK_EQUAL(late->solvedChecks(), 0);
+	BOOST_CHECK_EQUAL(answering->solvedChecks(), 1);
+
+	// The interrupt only applies to the check it was meant for.
+	BOOST_CHECK(!late->interruptRequested());
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::SATISFIABLE);
+	BOOST_CHECK_EQUAL(answering->solvedChecks(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(race_withdraws_interrupts_after_check)
+{
+	std::vector<std::unique_ptr<SolverInterface>> solvers;
+	solvers.emplace_back(std::make_unique<FakeSolver>(CheckResult::UNKNOWN));
+	solvers.emplace_back(std::make_unique<FakeSolver>(CheckResult::SATISFIABLE));
+	SMTPortfolio portfolio(std::move(solvers), {}, SMTPortfolio::Mode::Race);
+
+	// An interrupt that arrives between two checks makes the next check give up,
+	// but does not affect the ones after it.
+	portfolio.interrupt();
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::UNKNOWN);
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::SATISFIABLE);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
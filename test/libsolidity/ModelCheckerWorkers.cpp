@@ -0,0 +1,141 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for solving the CHC queries of the verification targets on several threads.
+ */
+
+#include <libsolidity/formal/ModelChecker.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/Keccak256.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+std::string const source = R"(
+	// SPDX-License-Identifier: GPL-3.0
+	pragma solidity >=0.0;
+	contract C {
+		uint x;
+		function f(uint y) public {
+			x = y;
+			g();
+		}
+		function h() public view {
+			g();
+		}
+		function g() internal view {
+			assert(x < 10);
+		}
+		function i(uint a, uint b) public pure returns (uint) {
+			require(a < 100 && b < 100);
+			assert(a + b < 200);
+			return a - b;
+		}
+	}
+)";
+
+/// @returns the warnings and infos of the CHC engine, including the counterexamples, in the order reported.
+std::vector<std::string> checkWithWorkers(
+	unsigned _workers,
+	smtutil::SMTSolverChoice _solvers,
+	ReadCallback::Callback _callback = {}
+)
+{
+	ModelCheckerSettings settings;
+	settings.engine = ModelCheckerEngine::CHC();
+	settings.solvers = _solvers;
+	settings.targets = ModelCheckerTargets::All();
+	settings.showUnproved = true;
+	settings.showProvedSafe = true;
+	settings.workers = _workers;
+
+	CompilerStack compilerStack(std::move(_callback));
+	compilerStack.setSources({{"A.sol", source}});
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setModelCheckerSettings(settings);
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contracts failed");
+
+	std::vector<std::string> messages;
+	for (auto const& error: compilerStack.errors())
+		messages.push_back(langutil::SourceReferenceFormatter::formatErrorInformation(*error, compilerStack));
+	return messages;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ModelCheckerWorkersTest)
+
+BOOST_AUTO_TEST_CASE(results_do_not_depend_on_workers)
+{
+	if (solidity::test::CommonOptions::get().disableSMT || !ModelChecker::availableSolvers().z3)
+		return;
+
+	std::vector<std::string> const sequential = checkWithWorkers(1, smtutil::SMTSolverChoice::Z3());
+	BOOST_CHECK(!sequential.empty());
+	BOOST_CHECK(checkWithWorkers(4, smtutil::SMTSolverChoice::Z3()) == sequential);
+}
+
+BOOST_AUTO_TEST_CASE(callback_is_not_called_concurrently)
+{
+	std::atomic<unsigned> callsInProgress = 0;
+	std::atomic<bool> concurrentCall = false;
+	std::vector<std::string> queries;
+	// Answers depend only on the query, so that the results show whether the queries are the same.
+	// The callback is not thread-safe, since it records the queries in a vector.
+	ReadCallback::Callback callback = [&](std::string const& _kind, std::string const& _query) {
+		if (_kind != ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
+			return ReadCallback::Result{false, "Unexpected callback kind."};
+		if (++callsInProgress > 1)
+			concurrentCall = true;
+		queries.push_back(_query);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		--callsInProgress;
+		return ReadCallback::Result{true, util::keccak256(_query)[0] % 2 ? "sat\n" : "unsat\n"};
+	};
+
+	std::vector<std::string> const sequential = checkWithWorkers(1, smtutil::SMTSolverChoice::SMTLIB2(), callback);
+	std::vector<std::string> const sequentialQueries = std::move(queries);
+	queries.clear();
+	BOOST_CHECK(!sequentialQueries.empty());
+
+	BOOST_CHECK(checkWithWorkers(4, smtutil::SMTSolverChoice::SMTLIB2(), callback) == sequential);
+	BOOST_CHECK(!concurrentCall);
+	std::sort(queries.begin(), queries.end());
+	std::vector<std::string> sortedSequentialQueries = sequentialQueries;
+	std::sort(sortedSequentialQueries.begin(), sortedSequentialQueries.end());
+	BOOST_CHECK(queries == sortedSequentialQueries);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the way solver sessions split queries into commands.
+ */
+
+#include <libsolidity/interface/SMTSolverSession.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(SMTSolverSessionTest)
+
+BOOST_AUTO_TEST_CASE(split_commands)
+{
+	std::string script =
+		"; comment (with parentheses\n"
+		"(set-logic ALL)\n"
+		"(declare-fun |x (;)| () Int) ; comment\n"
+		"(assert (= |x (;)|\n 1))(echo \"a)\"\"b\")\n";
+	BOOST_CHECK((SMTSolverSession::splitCommands(script) == std::vector<std::string>{
+		"(set-logic ALL)",
+		"(declare-fun |x (;)| () Int)",
+		"(assert (= |x (;)|\n 1))",
+		"(echo \"a)\"\"b\")"
+	}));
+}
+
+BOOST_AUTO_TEST_CASE(parse)
+{
+	SMTSolverSession::Script script = SMTSolverSession::parse(
+		"(set-option :produce-models true)\n"
+		"(set-logic ALL)\n"
+		"(declare-datatypes ((T 0)) (((T_accessor (T_0 Int)))))\n"
+		"(declare-fun |x_0| () Int)\n"
+		"(assert (> |x_0| 0))\n"
+		"(declare-fun |f| (Int) Bool)\n"
+		"(declare-const |EVALEXPR_0| Int)\n"
+		"(check-sat)\n"
+	);
+	BOOST_CHECK((script.options == std::vector<std::string>{"(set-option :produce-models true)", "(set-logic ALL)"}));
+	BOOST_REQUIRE_EQUAL(script.declarations.size(), 3);
+	BOOST_CHECK_EQUAL(script.declarations[0].first, script.declarations[0].second);
+	BOOST_CHECK_EQUAL(script.declarations[1].first, "|x_0|");
+	BOOST_CHECK_EQUAL(script.declarations[1].second, "(declare-fun |x_0| () Int)");
+	BOOST_CHECK_EQUAL(script.declarations[2].first, "|f|");
+	BOOST_CHECK((script.commands == std::vector<std::string>{
+		"(assert (> |x_0| 0))",
+		"(declare-const |EVALEXPR_0| Int)",
+		"(check-sat)"
+	}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -221,6 +221,36 @@ BOOST_AUTO_TEST_CASE(type_identifiers)
 	BOOST_CHECK_EQUAL(InaccessibleDynamicType().identifier(), "t_inaccessible");
 }
 
+BOOST_AUTO_TEST_CASE(interned_types)
+{
+	auto requestTypes = []() {
+		Type const* uint8Array = TypeProvider::array(DataLocation::Memory, TypeProvider::uint(8));
+		return std::vector<Type const*>{
+			uint8Array,
+			TypeProvider::withLocation(TypeProvider::array(DataLocation::CallData, TypeProvider::uint(8)), DataLocation::Memory, true),
+			TypeProvider::array(DataLocation::Storage, uint8Array, 3),
+			TypeProvider::array(DataLocation::Storage, TypeProvider::array(DataLocation::Storage, TypeProvider::uint(8)), 3),
+			TypeProvider::withLocation(TypeProvider::bytesCalldata(), DataLocation::Memory, true),
+			TypeProvider::tuple({uint8Array, TypeProvider::boolean()}),
+			TypeProvider::mapping(TypeProvider::address(), "owner", uint8Array, ""),
+			TypeProvider::function(TypePointers{uint8Array}, TypePointers{}, strings{"a"}, strings{}, FunctionType::Kind::Internal, StateMutability::Pure),
+			TypeProvider::typeType(uint8Array),
+		};
+	};
+
+	std::vector<Type const*> types = requestTypes();
+	BOOST_CHECK(types[1] == types[0]);
+	BOOST_CHECK(types[3] == types[2]);
+	BOOST_CHECK(types[4] == TypeProvider::bytesMemory());
+	BOOST_CHECK(TypeProvider::tuple({types[0]}) != TypeProvider::tuple({TypeProvider::boolean()}));
+	BOOST_CHECK(TypeProvider::mapping(TypeProvider::address(), "spender", types[0], "") != types[6]);
+
+	// Requesting the same types again does not create any new ones.
+	size_t const typeCount = TypeProvider::generalTypeCount();
+	BOOST_CHECK(requestTypes() == types);
+	BOOST_CHECK_EQUAL(TypeProvider::generalTypeCount(), typeCount);
+}
+
 BOOST_AUTO_TEST_CASE(encoded_sizes)
 {
 	BOOST_CHECK_EQUAL(IntegerType(16).calldataEncodedSize(true), 32);
@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <set>
+#include <sstream>
 
 using namespace solidity::evmasm;
 using namespace std::string_literals;
@@ -1405,6 +1406,219 @@ BOOST_AUTO_TEST_CASE(use_stack_optimization)
 	BOOST_CHECK(result["errors"][0]["type"] == "CompilerError");
 }
 
+BOOST_AUTO_TEST_CASE(yul_optimizer_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"fileA": { "A": [ "evm.bytecode.object", "metadata" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { uint x; function f(uint a) public { for (uint i = 0; i < a; ++i) x += i; } }"
+			}
+		}
+	}
+	)";
+
+	Json parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json contract = getContractResult(result, "fileA", "A");
+	BOOST_REQUIRE(contract.is_object());
+	BOOST_CHECK(!contract.contains("yulOptimizerProfile"));
+	std::string const bytecode = contract["evm"]["bytecode"]["object"].get<std::string>();
+	std::string const metadata = contract["metadata"].get<std::string>();
+
+	parsedInput["settings"]["optimizer"]["details"]["yulDetails"]["profile"] = true;
+	result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	contract = getContractResult(result, "fileA", "A");
+	BOOST_REQUIRE(contract.is_object());
+	// The profile is not part of the metadata, so neither the metadata nor the bytecode change.
+	BOOST_CHECK_EQUAL(contract["metadata"].get<std::string>(), metadata);
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].get<std::string>() == bytecode);
+
+	Json const& profile = contract["yulOptimizerProfile"];
+	BOOST_REQUIRE(profile.is_array());
+	// The deployed object is optimized before the creation object.
+	BOOST_REQUIRE_EQUAL(profile.size(), 2);
+	BOOST_CHECK(profile[0]["object"].get<std::string>().find("_deployed") != std::string::npos);
+	BOOST_CHECK(profile[1]["object"].get<std::string>().find("_deployed") == std::string::npos);
+	for (Json const& objectProfile: profile)
+	{
+		BOOST_REQUIRE(objectProfile["steps"].is_array());
+		BOOST_CHECK(!objectProfile["steps"].empty());
+		for (Json const& step: objectProfile["steps"])
+		{
+			BOOST_CHECK(step["step"].is_string());
+			BOOST_CHECK(step["durationMicroseconds"].is_number_integer());
+			BOOST_CHECK(step["nodesBefore"].is_number_unsigned());
+			BOOST_CHECK(step["nodesAfter"].is_number_unsigned());
+			BOOST_CHECK(step["codeSizeChange"].is_number_integer());
+		}
+		BOOST_REQUIRE(objectProfile["repetitions"].is_array());
+		BOOST_CHECK(!objectProfile["repetitions"].empty());
+		for (Json const& repetition: objectProfile["repetitions"])
+		{
+			BOOST_CHECK(repetition["sequence"].is_string());
+			BOOST_CHECK(repetition["rounds"].get<size_t>() >= 1);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(yul_optimizer_profile_invalid_type)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true, "details": { "yulDetails": { "profile": "yes" } } }
+		},
+		"sources": {
+			"fileA": { "content": "contract A { }" }
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.optimizer.details.profile\" must be Boolean"));
+}
+
+BOOST_AUTO_TEST_CASE(timings)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": [ "*" ], "": [ "*" ] }
+			}
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public returns (B) { return new B(); } } contract B { }"
+			}
+		}
+	}
+	)";
+
+	Json parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	// The wildcard does not select the timings.
+	BOOST_CHECK(!result.contains("timings"));
+
+	parsedInput["settings"]["outputSelection"]["fileA"][""] = Json::array({"timings"});
+	result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["timings"].is_object());
+
+	auto phaseNames = [](Json const& _phases) {
+		std::vector<std::string> names;
+		for (Json const& phase: _phases)
+		{
+			BOOST_CHECK(phase["durationMicroseconds"].is_number_integer());
+			BOOST_CHECK(!phase.contains("allocatedBytes") || phase["allocatedBytes"].is_number_integer());
+			names.emplace_back(phase["phase"].get<std::string>());
+		}
+		return names;
+	};
+
+	std::vector<std::string> analysisPhases = phaseNames(result["timings"]["phases"]);
+	BOOST_REQUIRE(!analysisPhases.empty());
+	BOOST_CHECK_EQUAL(analysisPhases.front(), "parsing");
+	BOOST_CHECK(util::contains(analysisPhases, "typeChecker"));
+
+	std::vector<std::string> const contractPhases{
+		"irGeneration",
+		"irParsing",
+		"yulOptimization",
+		"evmCodeTransform",
+		"evmasmOptimization",
+		"assembly"
+	};
+	for (char const* contractName: {"A", "B"})
+	{
+		Json const& phases = result["timings"]["contracts"]["fileA"][contractName];
+		BOOST_REQUIRE(phases.is_array());
+		BOOST_CHECK(phaseNames(phases) == contractPhases);
+	}
+
+	// The same code was already generated by the first compilation.
+	Json const& stackLayoutCache = result["timings"]["stackLayoutCache"];
+	for (char const* cache: {"shuffles", "combinations", "idealLayouts"})
+	{
+		BOOST_CHECK(stackLayoutCache[cache]["hits"].is_number_unsigned());
+		BOOST_CHECK(stackLayoutCache[cache]["misses"].is_number_unsigned());
+	}
+	BOOST_CHECK(stackLayoutCache["shuffles"]["hits"].get<size_t>() > 0);
+
+	// The heap is not attributed to contracts that may have been compiled concurrently.
+	parsedInput["settings"]["parallelism"] = 2u;
+	result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	for (char const* contractName: {"A", "B"})
+	{
+		Json const& phases = result["timings"]["contracts"]["fileA"][contractName];
+		BOOST_REQUIRE(phases.is_array());
+		BOOST_CHECK(phaseNames(phases) == contractPhases);
+		for (Json const& phase: phases)
+			BOOST_CHECK(!phase.contains("allocatedBytes"));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	std::vector<std::string> inputs{
+		R"({
+			"language": "Solidity",
+			"sources": {
+				"a": {"content": "contract B { function f() public pure { uint x; } } contract A {}"},
+				"a.sol": {"content": "import \"a\"; contract C is B { function g() public returns (A) { return new A(); } }"}
+			},
+			"settings": {
+				"outputSelection": {
+					"*": {"*": ["abi", "evm.bytecode.object", "evm.methodIdentifiers"], "": ["ast"]},
+					"a.sol": {"C": ["evm.deployedBytecode.sourceMap"]}
+				}
+			}
+		})",
+		R"({
+			"language": "Solidity",
+			"sources": {"a.sol": {"content": "contract C {"}},
+			"settings": {"outputSelection": {"*": {"*": ["abi"]}}}
+		})",
+		R"({
+			"language": "Yul",
+			"sources": {"a.yul": {"content": "{ sstore(0, 1) }"}},
+			"settings": {"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}
+		})",
+		R"({"language": "Solidity", "sources": {)"
+	};
+
+	for (util::JsonFormat const& format: {util::JsonFormat{util::JsonFormat::Compact}, util::JsonFormat{util::JsonFormat::Pretty, 3}})
+		for (std::string const& input: inputs)
+		{
+			solidity::frontend::StandardCompiler compiler({}, format);
+			std::ostringstream output;
+			BOOST_CHECK(compiler.compile(input, output));
+			BOOST_CHECK_EQUAL(output.str(), compiler.compile(input));
+		}
+}
+
 BOOST_AUTO_TEST_CASE(standard_output_selection_wildcard)
 {
 	char const* input = R"(
@@ -0,0 +1,297 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsolidity/interface/CompilationCache.h
+
+#include <libsolidity/interface/CompilationCache.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <test/Common.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/StringUtils.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+#define TEST_CASE_NAME (boost::unit_test::framework::current_test_case().p_name)
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+std::map<std::string, std::string> const sources = {
+	{"A.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		import "L.sol";
+		contract A {
+			function f(uint x) public pure returns (uint) {
+				uint unused;
+				return L.twice(x);
+			}
+			function g() public returns (address) { return address(new B()); }
+		}
+		contract B { uint public b = 7; }
+	)"},
+	{"L.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		library L { function twice(uint x) internal pure returns (uint) { return 2 * x; } }
+	)"},
+	{"C.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		contract C { function h() public view returns (uint) { return block.number; } }
+	)"},
+};
+
+/// Outputs of a compilation, copied so that the compiler stack is destroyed before the next
+/// compilation starts.
+struct Artifacts
+{
+	bool restoredFromCache = false;
+	std::vector<std::string> restoredContracts;
+	std::vector<std::string> errors;
+	std::map<std::string, std::vector<std::string>> contracts;
+};
+
+Artifacts compile(
+	std::map<std::string, std::string> const& _sources,
+	std::shared_ptr<CompilationCache> _cache,
+	bool _viaIR = false
+)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources(_sources);
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setViaIR(_viaIR);
+	compilerStack.enableIRGeneration(true);
+	if (_cache)
+		compilerStack.setCompilationCache(std::move(_cache));
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contracts failed");
+
+	Artifacts artifacts;
+	artifacts.restoredFromCache = compilerStack.restoredFromCache();
+	artifacts.restoredContracts = compilerStack.contractsRestoredFromCache();
+	for (auto const& error: compilerStack.errors())
+		// The pre-release warning does not have a source location and is not cached.
+		if (error->comment()->find("pre-release compiler") == std::string::npos)
+			artifacts.errors.push_back(
+				Error::formatErrorType(error->type()) + " " +
+				std::to_string(error->errorId().error) + " " +
+				*error->sourceLocation()->sourceName + ":" +
+				std::to_string(error->sourceLocation()->start) + " " +
+				*error->comment()
+			);
+	for (std::string const& name: compilerStack.contractNames())
+	{
+		std::vector<std::string> immutableReferences;
+		for (auto const& [hash, reference]: compilerStack.runtimeObject(name).immutableReferences)
+			immutableReferences.push_back(hash.str() + " " + reference.first + " " + std::to_string(reference.second.size()));
+		artifacts.contracts[name] = {
+			util::toHex(compilerStack.object(name).bytecode),
+			util::toHex(compilerStack.runtimeObject(name).bytecode),
+			joinHumanReadable(immutableReferences),
+			*compilerStack.sourceMapping(name),
+			*compilerStack.runtimeSourceMapping(name),
+			compilerStack.metadata(name),
+			jsonCompactPrint(compilerStack.contractABI(name)),
+			jsonCompactPrint(compilerStack.interfaceSymbols(name)),
+			jsonCompactPrint(compilerStack.assemblyJSON(name)),
+			compilerStack.yulIR(name),
+			compilerStack.yulIROptimized(name),
+		};
+	}
+	return artifacts;
+}
+
+void checkSameArtifacts(Artifacts const& _expected, Artifacts const& _actual)
+{
+	BOOST_CHECK(_expected.errors == _actual.errors);
+	BOOST_REQUIRE(_expected.contracts.size() == _actual.contracts.size());
+	for (auto const& [name, expectedOutputs]: _expected.contracts)
+	{
+		BOOST_TEST_CONTEXT("contract " << name)
+		{
+			BOOST_REQUIRE(_actual.contracts.count(name));
+			std::vector<std::string> const& actualOutputs = _actual.contracts.at(name);
+			for (size_t i = 0; i < expectedOutputs.size(); ++i)
+				BOOST_CHECK_EQUAL(expectedOutputs[i], actualOutputs[i]);
+		}
+	}
+}
+
+/// Applies @a _modify to every entry stored in the cache directory @a _directory.
+void modifyEntries(boost::filesystem::path const& _directory, std::function<void(Json&)> const& _modify)
+{
+	for (auto const& file: boost::filesystem::recursive_directory_iterator(_directory))
+		if (boost::filesystem::is_regular_file(file.path()))
+		{
+			Json entry;
+			BOOST_REQUIRE(jsonParseStrict(readFileAsString(file.path()), entry));
+			_modify(entry);
+			std::ofstream(file.path().string(), std::ios::trunc) << jsonCompactPrint(entry);
+		}
+}
+
+/// Applies @a _modify to the code generation artifacts of every contract in @a _entry.
+void modifyCode(Json& _entry, std::function<void(Json&)> const& _modify)
+{
+	for (auto& [name, contract]: _entry["contracts"].items())
+		if (contract.contains("code"))
+			_modify(contract["code"]);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CompilationCacheTest)
+
+BOOST_AUTO_TEST_CASE(warm_rebuild_restores_all_artifacts)
+{
+	for (bool viaIR: {false, true})
+	{
+		TemporaryDirectory tempDir(TEST_CASE_NAME);
+		auto cache = std::make_shared<CompilationCache>(tempDir.path());
+
+		auto uncached = compile(sources, nullptr, viaIR);
+		auto cold = compile(sources, cache, viaIR);
+		auto warm = compile(sources, cache, viaIR);
+
+		BOOST_CHECK(!cold.restoredFromCache);
+		BOOST_CHECK(cold.restoredContracts.empty());
+		BOOST_CHECK(warm.restoredFromCache);
+		BOOST_CHECK((warm.restoredContracts == std::vector<std::string>{"A.sol:A", "A.sol:B", "C.sol:C", "L.sol:L"}));
+		// The warning about the unused variable is reported again.
+		BOOST_CHECK_EQUAL(warm.errors.size(), 1);
+		checkSameArtifacts(uncached, cold);
+		checkSameArtifacts(uncached, warm);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(changed_source_is_recompiled)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	auto cache = std::make_shared<CompilationCache>(tempDir.path());
+	compile(sources, cache);
+
+	// A change in an imported source unit invalidates the entries of all source units importing it,
+	// while the artifacts of the unrelated source unit are still restored.
+	std::map<std::string, std::string> changedSources = sources;
+	changedSources["L.sol"] += "\n// trailing comment\n";
+	auto changed = compile(changedSources, cache);
+	BOOST_CHECK(!changed.restoredFromCache);
+	BOOST_CHECK((changed.restoredContracts == std::vector<std::string>{"C.sol:C"}));
+	checkSameArtifacts(compile(changedSources, nullptr), changed);
+
+	auto warm = compile(changedSources, cache);
+	BOOST_CHECK(warm.restoredFromCache);
+	checkSameArtifacts(changed, warm);
+}
+
+BOOST_AUTO_TEST_CASE(changed_settings_are_not_restored)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	auto cache = std::make_shared<CompilationCache>(tempDir.path());
+	compile(sources, cache, false);
+
+	auto viaIR = compile(sources, cache, true);
+	BOOST_CHECK(!viaIR.restoredFromCache);
+	checkSameArtifacts(compile(sources, nullptr, true), viaIR);
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_entries_are_ignored)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	auto cache = std::make_shared<CompilationCache>(tempDir.path());
+	auto cold = compile(sources, cache);
+
+	for (auto const& entry: boost::filesystem::recursive_directory_iterator(tempDir.path()))
+		if (boost::filesystem::is_regular_file(entry.path()))
+			std::ofstream(entry.path().string(), std::ios::trunc) << "{ not json";
+
+	auto rebuilt = compile(sources, cache);
+	BOOST_CHECK(!rebuilt.restoredFromCache);
+	checkSameArtifacts(cold, rebuilt);
+}
+
+BOOST_AUTO_TEST_CASE(malformed_entries_are_ignored)
+{
+	// Entries that are valid JSON, but do not have the expected shape, e.g. because they were
+	// written by another compiler version, are treated as missing.
+	std::map<std::string, std::function<void(Json&)>> const modifications = {
+		{"missing errors", [](Json& _entry) { _entry.erase("compilationErrors"); }},
+		{"missing contracts", [](Json& _entry) { _entry["contracts"] = Json::object(); }},
+		{"missing bytecode", [](Json& _entry) {
+			modifyCode(_entry, [](Json& _code) { _code.erase("deployedBytecode"); });
+		}},
+		{"wrong metadata type", [](Json& _entry) {
+			for (auto& [name, contract]: _entry["contracts"].items())
+				contract["metadata"] = 1;
+		}},
+		{"invalid hex", [](Json& _entry) {
+			modifyCode(_entry, [](Json& _code) { _code["bytecode"]["bytecode"] = "0xzz"; });
+		}},
+		{"invalid link reference offset", [](Json& _entry) {
+			modifyCode(_entry, [](Json& _code) { _code["bytecode"]["linkReferences"]["1x"] = "L.sol:L"; });
+		}},
+		{"unknown error type", [](Json& _entry) {
+			_entry["analysisErrors"].emplace_back(Json{{"type", "Bogus"}, {"errorId", 1}, {"message", ""}});
+		}},
+	};
+
+	for (auto const& [description, modify]: modifications)
+	{
+		BOOST_TEST_CONTEXT(description)
+		{
+			TemporaryDirectory tempDir(TEST_CASE_NAME);
+			auto cache = std::make_shared<CompilationCache>(tempDir.path());
+			auto cold = compile(sources, cache);
+			modifyEntries(tempDir.path(), modify);
+
+			auto rebuilt = compile(sources, cache);
+			BOOST_CHECK(!rebuilt.restoredFromCache);
+			BOOST_CHECK(rebuilt.restoredContracts.empty());
+			checkSameArtifacts(cold, rebuilt);
+
+			// The malformed entries were replaced.
+			auto warm = compile(sources, cache);
+			BOOST_CHECK(warm.restoredFromCache);
+			checkSameArtifacts(cold, warm);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
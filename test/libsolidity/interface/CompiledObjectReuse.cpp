@@ -0,0 +1,151 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for the reuse of the optimized objects of created contracts in the IR pipeline.
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libyul/YulStack.h>
+
+#include <test/Common.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <string>
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+std::string const source = R"(
+	// SPDX-License-Identifier: GPL-3.0
+	pragma solidity >=0.0;
+	contract C {
+		uint immutable x;
+		constructor(uint _x) { x = _x; }
+		function f(uint y) public view returns (uint) { return x * y + 1; }
+	}
+	contract D {
+		C public c;
+		constructor() { c = new C(1); }
+		function g() public returns (address) { return address(new C(2)); }
+	}
+	contract E {
+		function h() public returns (bytes memory) { return abi.encode(new D(), type(C).creationCode); }
+	}
+	contract F {
+		function k() public returns (address) { return address(new C(3)); }
+	}
+)";
+
+/// @returns the creation bytecode of the contract @a _contractName built from its unoptimized IR
+/// by a separate Yul stack, which optimizes and assembles the objects of created contracts again.
+bytes compileIRWithoutReuse(CompilerStack const& _compilerStack, std::string const& _contractName)
+{
+	yul::YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		std::nullopt,
+		yul::YulStack::Language::StrictAssembly,
+		OptimiserSettings::standard(),
+		langutil::DebugInfoSelection::Default()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _compilerStack.yulIR(_contractName)));
+	stack.optimize();
+	yul::MachineAssemblyObject object = stack.assemble(yul::YulStack::Machine::EVM);
+	BOOST_REQUIRE(object.bytecode);
+	return object.bytecode->bytecode;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CompiledObjectReuseTest)
+
+BOOST_AUTO_TEST_CASE(created_objects_are_optimized_once)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources({{"A.sol", source}});
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setViaIR(true);
+	OptimiserSettings settings = OptimiserSettings::standard();
+	settings.profileYulOptimiser = true;
+	compilerStack.setOptimiserSettings(settings);
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contracts failed");
+
+	// The profile lists every object the optimizer ran on. The objects of created contracts,
+	// which are embedded into the IR of D, E and F, are not among them, since they were
+	// optimized with the created contracts and reused.
+	for (std::string const& name: compilerStack.contractNames())
+	{
+		std::string const contractName = name.substr(name.find(':') + 1);
+		Json const profile = compilerStack.yulOptimizerProfile(name);
+		BOOST_REQUIRE(profile.is_array());
+		BOOST_CHECK_EQUAL(profile.size(), 2);
+		for (Json const& objectProfile: profile)
+			BOOST_CHECK_MESSAGE(
+				boost::starts_with(objectProfile.at("object").get<std::string>(), contractName + "_"),
+				name + " optimized " + objectProfile.at("object").get<std::string>()
+			);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(bytecode_does_not_depend_on_reuse)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources({{"A.sol", source}});
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setViaIR(true);
+	compilerStack.setOptimiserSettings(true);
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contracts failed");
+
+	for (std::string const& name: compilerStack.contractNames())
+		BOOST_CHECK_EQUAL(
+			util::toHex(compilerStack.object(name).bytecode),
+			util::toHex(compileIRWithoutReuse(compilerStack, name))
+		);
+}
+
+BOOST_AUTO_TEST_CASE(result_does_not_depend_on_parallelism)
+{
+	std::map<std::string, bytes> serialBytecode;
+	for (size_t parallelism: {1, 2, 4, 16})
+	{
+		CompilerStack compilerStack;
+		compilerStack.setSources({{"A.sol", source}});
+		compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		compilerStack.setViaIR(true);
+		compilerStack.setOptimiserSettings(true);
+		compilerStack.setParallelism(parallelism);
+		BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contracts failed");
+
+		for (std::string const& name: compilerStack.contractNames())
+			if (parallelism == 1)
+				serialBytecode[name] = compilerStack.object(name).bytecode;
+			else
+				BOOST_CHECK_EQUAL(util::toHex(compilerStack.object(name).bytecode), util::toHex(serialBytecode.at(name)));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,187 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for the incremental analysis of CompilerStack.
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace solidity::langutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+std::map<std::string, std::string> const sources = {
+	{"L.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		library L { function twice(uint x) internal pure returns (uint) { return 2 * x; } }
+	)"},
+	{"A.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		import "L.sol";
+		contract A {
+			function f(uint x) public pure returns (uint) {
+				uint unused;
+				return L.twice(x);
+			}
+		}
+	)"},
+	{"B.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		import "A.sol";
+		contract B is A {
+			function g() public returns (uint) { return f(1); }
+		}
+	)"},
+	{"C.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		contract C { function h() public view returns (uint) { return 1; } }
+	)"},
+};
+
+std::set<std::string> const allSourceNames = {"A.sol", "B.sol", "C.sol", "L.sol"};
+
+std::vector<std::string> analyze(CompilerStack& _compilerStack, std::map<std::string, std::string> const& _sources)
+{
+	_compilerStack.reset(true);
+	_compilerStack.setSources(_sources);
+	_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+
+	std::vector<std::string> errors;
+	for (auto const& error: _compilerStack.errors())
+		errors.push_back(
+			Error::formatErrorType(error->type()) + " " +
+			std::to_string(error->errorId().error) + " " +
+			*error->sourceLocation()->sourceName + ":" +
+			std::to_string(error->sourceLocation()->start)
+		);
+	// Errors of reused source units are reported before the errors of the analysed ones.
+	std::sort(errors.begin(), errors.end());
+	return errors;
+}
+
+/// Analyses @a _sources incrementally after @a _previousSources and compares the result
+/// with a full analysis.
+void checkIncrementalAnalysis(
+	std::map<std::string, std::string> const& _previousSources,
+	std::map<std::string, std::string> const& _sources,
+	std::set<std::string> const& _expectedReusedSources
+)
+{
+	CompilerStack compilerStack;
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.enableIncrementalAnalysis();
+	analyze(compilerStack, _previousSources);
+	BOOST_CHECK(compilerStack.reusedSources().empty());
+
+	std::vector<std::string> incrementalErrors = analyze(compilerStack, _sources);
+	BOOST_CHECK(compilerStack.reusedSources() == _expectedReusedSources);
+	bool incrementalSuccess = compilerStack.state() == CompilerStack::State::AnalysisSuccessful;
+
+	compilerStack.reset(true);
+	compilerStack.enableIncrementalAnalysis(false);
+	std::vector<std::string> fullErrors = analyze(compilerStack, _sources);
+	BOOST_CHECK(compilerStack.reusedSources().empty());
+	BOOST_CHECK_EQUAL(incrementalSuccess, compilerStack.state() == CompilerStack::State::AnalysisSuccessful);
+	BOOST_CHECK_EQUAL_COLLECTIONS(incrementalErrors.begin(), incrementalErrors.end(), fullErrors.begin(), fullErrors.end());
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(IncrementalAnalysisTest)
+
+BOOST_AUTO_TEST_CASE(unchanged_sources_are_reused)
+{
+	checkIncrementalAnalysis(sources, sources, allSourceNames);
+}
+
+BOOST_AUTO_TEST_CASE(importers_of_changed_source_are_analysed)
+{
+	std::map<std::string, std::string> changedSources = sources;
+	changedSources["L.sol"] += "\nfunction unusedFree(uint x) pure returns (uint) { uint y; return x; }\n";
+	checkIncrementalAnalysis(sources, changedSources, {"C.sol"});
+
+	changedSources = sources;
+	changedSources["C.sol"] += "\ncontract D { function k() public {} }\n";
+	checkIncrementalAnalysis(sources, changedSources, {"A.sol", "B.sol", "L.sol"});
+}
+
+BOOST_AUTO_TEST_CASE(removed_and_added_sources)
+{
+	std::map<std::string, std::string> changedSources = sources;
+	changedSources.erase("C.sol");
+	changedSources["D.sol"] = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		import "B.sol";
+		contract D is B { function k() public view returns (uint) { return 2; } }
+	)";
+	checkIncrementalAnalysis(sources, changedSources, {"A.sol", "B.sol", "L.sol"});
+}
+
+BOOST_AUTO_TEST_CASE(errors_in_changed_source)
+{
+	std::map<std::string, std::string> brokenSources = sources;
+	brokenSources["B.sol"] += "\ncontract E { function k() public { undeclared(); } }\n";
+	checkIncrementalAnalysis(sources, brokenSources, {"A.sol", "C.sol", "L.sol"});
+	// Nothing is retained from an analysis that failed without reusing source units.
+	checkIncrementalAnalysis(brokenSources, sources, {});
+
+	// Source units reused by a failed analysis are kept for the next one.
+	CompilerStack compilerStack;
+	compilerStack.enableIncrementalAnalysis();
+	analyze(compilerStack, sources);
+	analyze(compilerStack, brokenSources);
+	BOOST_CHECK(compilerStack.state() < CompilerStack::State::AnalysisSuccessful);
+	analyze(compilerStack, sources);
+	BOOST_CHECK(compilerStack.state() == CompilerStack::State::AnalysisSuccessful);
+	BOOST_CHECK((compilerStack.reusedSources() == std::set<std::string>{"A.sol", "C.sol", "L.sol"}));
+}
+
+BOOST_AUTO_TEST_CASE(changed_settings_disable_reuse)
+{
+	CompilerStack compilerStack;
+	compilerStack.enableIncrementalAnalysis();
+	analyze(compilerStack, sources);
+	compilerStack.reset(true);
+	compilerStack.setEVMVersion(EVMVersion::paris());
+	analyze(compilerStack, sources);
+	BOOST_CHECK(compilerStack.reusedSources().empty());
+	analyze(compilerStack, sources);
+	BOOST_CHECK(compilerStack.reusedSources() == allSourceNames);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
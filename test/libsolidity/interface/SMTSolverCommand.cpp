@@ -0,0 +1,371 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsolidity/interface/SMTSolverCommand.h, run against a fake solver binary.
+
+#include <libsolidity/interface/SMTSolverCommand.h>
+
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The fake solver is a shell script.
+#if !defined(_WIN32)
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Answers a query with the response given by its assertion `(answer <response>)`.
+/// The responses `hang` and `crash` make it sleep or fail instead.
+/// Every start of the solver, except to ask for its version, appends its arguments to the file `calls`.
+///
+/// Started with `--incremental`, it reads the commands from the standard input, appends them to
+/// the file `input` and answers `check-sat` and `echo` commands. The responses `flaky` and `unsupported`
+/// then make it fail or report an error, while a solver started for a single query answers them with `sat`.
+std::string const fakeSolverScript = R"SCRIPT(#!/bin/sh
+if [ "$1" = "--version" ]; then
+	echo "fake cvc5"
+	exit 0
+fi
+directory=$(dirname "$0")
+echo "$@" >> "$directory/calls"
+
+case " $* " in *" --incremental "*)
+	answer=
+	while IFS= read -r command; do
+		echo "$command" >> "$directory/input"
+		case "$command" in
+			*"(answer "*) answer=$(echo "$command" | sed 's/.*(answer \([a-z]*\)).*/\1/') ;;
+			"(check-sat)")
+				case "$answer" in
+					hang) exec sleep 60 ;;
+					crash|flaky) exit 1 ;;
+					unsupported) echo '(error "unsupported")' ;;
+					*) echo "$answer" ;;
+				esac ;;
+			"(echo "*) echo "$command" | sed 's/(echo \(.*\))/\1/' ;;
+		esac
+	done
+	exit 0
+esac
+
+for query; do :; done
+answer=$(sed -n 's/.*(answer \([a-z]*\)).*/\1/p' "$query")
+case "$answer" in
+	hang) exec sleep 60 ;;
+	crash) exit 1 ;;
+	flaky|unsupported) echo sat ;;
+	*) echo "$answer" ;;
+esac
+)SCRIPT";
+
+/// @returns an SMT-LIB2 query that the fake solver answers with @a _answer.
+std::string query(std::string const& _answer, std::string const& _variable = "x")
+{
+	return
+		"(set-logic ALL)\n"
+		"(declare-fun |" + _variable + "| () Int)\n"
+		"(assert (answer " + _answer + "))\n"
+		"(check-sat)\n";
+}
+
+/// Installs the fake solver as `cvc5` in front of the search path and provides a cache for its responses.
+class FakeSolverFixture
+{
+public:
+	FakeSolverFixture():
+		m_tempDir("smt-solver-command-test"),
+		m_cache(std::make_shared<CompilationCache>(m_tempDir.path() / "cache"))
+	{
+		boost::filesystem::path const solver = m_tempDir.path() / "cvc5";
+		std::ofstream(solver.string()) << fakeSolverScript;
+		boost::filesystem::permissions(solver, boost::filesystem::owner_all);
+
+		if (char const* path = std::getenv("PATH"))
+			m_originalPath = path;
+		setenv("PATH", (m_tempDir.path().string() + ":" + m_originalPath).c_str(), 1);
+	}
+
+	~FakeSolverFixture()
+	{
+		setenv("PATH", m_originalPath.c_str(), 1);
+	}
+
+	std::string solve(SMTSolverCommand const& _command, std::string const& _query)
+	{
+		ReadCallback::Result result = _command.solve(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _query);
+		BOOST_REQUIRE_MESSAGE(result.success, result.responseOrErrorMessage);
+		return result.responseOrErrorMessage;
+	}
+
+	/// @returns the arguments of every start of the solver to solve queries.
+	std::vector<std::string> solverCalls() const { return lines("calls"); }
+	/// @returns how often the solver was started to solve a query.
+	size_t solverStarts() const { return solverCalls().size(); }
+	/// @returns the commands sent to solver sessions.
+	std::vector<std::string> sessionInput() const { return lines("input"); }
+
+	size_t cacheEntries() const
+	{
+		size_t entries = 0;
+		if (boost::filesystem::exists(m_cache->directory()))
+			for (auto const& entry: boost::filesystem::recursive_directory_iterator(m_cache->directory()))
+				if (boost::filesystem::is_regular_file(entry.path()))
+					++entries;
+		return entries;
+	}
+
+	/// Waits until the solver was started @a _starts times.
+	void waitForSolverStarts(size_t _starts) const
+	{
+		for (size_t i = 0; i < 1000 && solverStarts() < _starts; ++i)
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		BOOST_REQUIRE_EQUAL(solverStarts(), _starts);
+	}
+
+protected:
+	std::vector<std::string> lines(std::string const& _fileName) const
+	{
+		std::ifstream file((m_tempDir.path() / _fileName).string());
+		std::vector<std::string> lines;
+		for (std::string line; std::getline(file, line);)
+			lines.emplace_back(std::move(line));
+		return lines;
+	}
+
+	util::TemporaryDirectory m_tempDir;
+	std::shared_ptr<CompilationCache> m_cache;
+	std::string m_originalPath;
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(SMTSolverCommandTest, FakeSolverFixture)
+
+BOOST_AUTO_TEST_CASE(cache_hit)
+{
+	SMTSolverCommand command;
+	command.setCvc5(std::nullopt);
+	command.setCache(m_cache);
+
+	BOOST_CHECK_EQUAL(solve(command, query("sat")), "sat");
+	BOOST_CHECK_EQUAL(solverStarts(), 1);
+	BOOST_CHECK_EQUAL(cacheEntries(), 1);
+
+	BOOST_CHECK_EQUAL(solve(command, query("sat")), "sat");
+	BOOST_CHECK_EQUAL(solverStarts(), 1);
+
+	// The responses are also found by later compiler runs.
+	SMTSolverCommand laterCommand;
+	laterCommand.setCvc5(std::nullopt);
+	laterCommand.setCache(m_cache);
+	BOOST_CHECK_EQUAL(solve(laterCommand, query("sat")), "sat");
+	BOOST_CHECK_EQUAL(solverStarts(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(cache_miss)
+{
+	SMTSolverCommand command;
+	command.setCvc5(std::nullopt);
+	command.setCache(m_cache);
+	BOOST_CHECK_EQUAL(solve(command, query("sat")), "sat");
+	BOOST_CHECK_EQUAL(solverStarts(), 1);
+
+	// Another query.
+	BOOST_CHECK_EQUAL(solve(command, query("sat", "y")), "sat");
+	BOOST_CHECK_EQUAL(solverStarts(), 2);
+
+	// The same query with another timeout, which changes the arguments of the solver.
+	command.setCvc5(10000);
+	BOOST_CHECK_EQUAL(solve(command, query("sat")), "sat");
+	BOOST_CHECK_EQUAL(solverStarts(), 3);
+	BOOST_CHECK_EQUAL(cacheEntries(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(unknown_is_not_stored_under_timeout)
+{
+	SMTSolverCommand command;
+	command.setCache(m_cache);
+
+	command.setCvc5(10000);
+	BOOST_CHECK_EQUAL(solve(command, query("unknown")), "unknown");
+	BOOST_CHECK_EQUAL(solve(command, query("unknown")), "unknown");
+	BOOST_CHECK_EQUAL(solverStarts(), 2);
+	BOOST_CHECK_EQUAL(cacheEntries(), 0);
+
+	// Without a timeout the resource limit makes the response deterministic.
+	command.setCvc5(std::nullopt);
+	BOOST_CHECK_EQUAL(solve(command, query("unknown")), "unknown");
+	BOOST_CHECK_EQUAL(solve(command, query("unknown")), "unknown");
+	BOOST_CHECK_EQUAL(solverStarts(), 3);
+	BOOST_CHECK_EQUAL(cacheEntries(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(failed_query_is_not_stored)
+{
+	SMTSolverCommand command;
+	command.setCvc5(std::nullopt);
+	command.setCache(m_cache);
+
+	solve(command, query("crash"));
+	solve(command, query("crash"));
+	BOOST_CHECK_EQUAL(solverStarts(), 2);
+	BOOST_CHECK_EQUAL(cacheEntries(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(nothing_stored_after_interrupt)
+{
+	SMTSolverCommand command;
+	command.setCvc5(std::nullopt);
+	command.setCache(m_cache);
+
+	std::thread solver([&]() { solve(command, query("hang")); });
+	waitForSolverStarts(1);
+	command.interrupt();
+	solver.join();
+	BOOST_CHECK_EQUAL(cacheEntries(), 0);
+
+	// Queries started after the interrupt give up without starting the solver.
+	BOOST_CHECK_EQUAL(solve(command, query("sat")), "unknown");
+	BOOST_CHECK_EQUAL(solverStarts(), 1);
+	BOOST_CHECK_EQUAL(cacheEntries(), 0);
+
+	command.clearInterrupt();
+	BOOST_CHECK_EQUAL(solve(command, query("sat")), "sat");
+	BOOST_CHECK_EQUAL(solverStarts(), 2);
+	BOOST_CHECK_EQUAL(cacheEntries(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(session_protocol)
+{
+	SMTSolverCommand command;
+	command.setCvc5(std::nullopt);
+	command.setSessions(true);
+
+	BOOST_CHECK_EQUAL(solve(command, query("sat")), "sat");
+	BOOST_CHECK_EQUAL(solve(command, query("unsat")), "unsat");
+	BOOST_CHECK_EQUAL(solve(command, query("sat", "y")), "sat");
+
+	// All queries are solved by one process, which receives the options and each declaration once.
+	BOOST_CHECK((solverCalls() == std::vector<std::string>{"--lang=smt2 --incremental --rlimit-per 12000"}));
+	BOOST_CHECK((sessionInput() == std::vector<std::string>{
+		"(set-logic ALL)",
+		"(declare-fun |x| () Int)",
+		"(push 1)",
+		"(assert (answer sat))",
+		"(check-sat)",
+		"(pop 1)",
+		"(echo \"solc-query-1\")",
+		"(push 1)",
+		"(assert (answer unsat))",
+		"(check-sat)",
+		"(pop 1)",
+		"(echo \"solc-query-2\")",
+		"(declare-fun |y| () Int)",
+		"(push 1)",
+		"(assert (answer sat))",
+		"(check-sat)",
+		"(pop 1)",
+		"(echo \"solc-query-3\")"
+	}));
+}
+
+BOOST_AUTO_TEST_CASE(session_fallback)
+{
+	SMTSolverCommand command;
+	command.setCvc5(std::nullopt);
+	command.setSessions(true);
+
+	// Queries on which the session crashes or reports an error are solved again by a single process.
+	BOOST_CHECK_EQUAL(solve(command, query("flaky")), "sat");
+	BOOST_CHECK_EQUAL(solve(command, query("unsupported")), "sat");
+	// The failed sessions are replaced by new ones.
+	BOOST_CHECK_EQUAL(solve(command, query("sat")), "sat");
+	BOOST_CHECK_EQUAL(solve(command, query("unsat")), "unsat");
+
+	std::string const session = "--lang=smt2 --incremental --rlimit-per 12000";
+	std::vector<std::string> const calls = solverCalls();
+	BOOST_REQUIRE_EQUAL(calls.size(), 5);
+	BOOST_CHECK_EQUAL(calls[0], session);
+	BOOST_CHECK(boost::starts_with(calls[1], "--rlimit 12000 "));
+	BOOST_CHECK_EQUAL(calls[2], session);
+	BOOST_CHECK(boost::starts_with(calls[3], "--rlimit 12000 "));
+	BOOST_CHECK_EQUAL(calls[4], session);
+}
+
+BOOST_AUTO_TEST_CASE(session_watchdog)
+{
+	SMTSolverCommand command;
+	command.setCvc5(100);
+	command.setCache(m_cache);
+	command.setSessions(true);
+
+	// The solver does not enforce the timeout, so the watchdog terminates it.
+	auto const start = std::chrono::steady_clock::now();
+	BOOST_CHECK_EQUAL(solve(command, query("hang")), "unknown");
+	BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(30));
+	BOOST_CHECK_EQUAL(solverStarts(), 1);
+	BOOST_CHECK_EQUAL(cacheEntries(), 0);
+
+	BOOST_CHECK_EQUAL(solve(command, query("sat")), "sat");
+	BOOST_CHECK_EQUAL(solverStarts(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(session_responses_are_keyed_by_session_arguments)
+{
+	SMTSolverCommand command;
+	command.setCvc5(std::nullopt);
+	command.setCache(m_cache);
+	command.setSessions(true);
+	BOOST_CHECK_EQUAL(solve(command, query("sat")), "sat");
+	BOOST_CHECK_EQUAL(solve(command, query("sat")), "sat");
+	BOOST_CHECK_EQUAL(solverStarts(), 1);
+
+	// A single process uses other arguments, so it does not get the response of the session.
+	SMTSolverCommand processCommand;
+	processCommand.setCvc5(std::nullopt);
+	processCommand.setCache(m_cache);
+	BOOST_CHECK_EQUAL(solve(processCommand, query("sat")), "sat");
+	BOOST_CHECK_EQUAL(solverStarts(), 2);
+	BOOST_CHECK_EQUAL(cacheEntries(), 2);
+
+	// A response of the process that replaced a failed session is stored under the arguments of the process.
+	BOOST_CHECK_EQUAL(solve(command, query("flaky")), "sat");
+	BOOST_CHECK_EQUAL(solverStarts(), 3);
+	BOOST_CHECK_EQUAL(solve(processCommand, query("flaky")), "sat");
+	BOOST_CHECK_EQUAL(solverStarts(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+
+#endif
@@ -0,0 +1,115 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ParallelTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(effective_concurrency)
+{
+	BOOST_CHECK_EQUAL(effectiveConcurrency(1), 1);
+	BOOST_CHECK_EQUAL(effectiveConcurrency(7), 7);
+	BOOST_CHECK(effectiveConcurrency(0) >= 1);
+}
+
+BOOST_AUTO_TEST_CASE(no_tasks)
+{
+	bool called = false;
+	parallelFor(4, 0, [&](size_t) { called = true; });
+	BOOST_CHECK(!called);
+}
+
+BOOST_AUTO_TEST_CASE(every_index_exactly_once)
+{
+	for (size_t concurrency: {1, 2, 4, 16})
+	{
+		std::vector<std::atomic<unsigned>> calls(100);
+		parallelFor(concurrency, calls.size(), [&](size_t _index) { ++calls[_index]; });
+		for (auto const& count: calls)
+			BOOST_CHECK_EQUAL(count.load(), 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(serial_runs_in_order)
+{
+	std::vector<size_t> order;
+	parallelFor(1, 5, [&](size_t _index) { order.push_back(_index); });
+	BOOST_CHECK((order == std::vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_exception_of_smallest_index)
+{
+	for (size_t concurrency: {1, 3, 8})
+	{
+		std::string message;
+		try
+		{
+			parallelFor(concurrency, 50, [](size_t _index) {
+				if (_index == 7 || _index == 9 || _index == 40)
+					throw std::runtime_error(std::to_string(_index));
+			});
+		}
+		catch (std::runtime_error const& _error)
+		{
+			message = _error.what();
+		}
+		BOOST_CHECK_EQUAL(message, "7");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(threads_are_reused)
+{
+	static std::atomic<size_t> threads{0};
+	struct ThreadCounter
+	{
+		ThreadCounter() { ++threads; }
+	};
+	for (size_t i = 0; i < 20; ++i)
+		parallelFor(3, 6, [&](size_t) {
+			thread_local ThreadCounter counter;
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		});
+	// The calling thread and the threads of the pool, which earlier tests may have grown to 15 threads.
+	BOOST_CHECK(threads <= 1 + 15);
+}
+
+BOOST_AUTO_TEST_CASE(nested_calls)
+{
+	std::vector<std::atomic<unsigned>> calls(64);
+	parallelFor(4, 8, [&](size_t _outer) {
+		parallelFor(4, 8, [&](size_t _inner) { ++calls[_outer * 8 + _inner]; });
+	});
+	for (auto const& count: calls)
+		BOOST_CHECK_EQUAL(count.load(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -233,6 +233,23 @@ BOOST_AUTO_TEST_CASE(invalid_param)
 	BOOST_CHECK_THROW(m("b ", "X"), WhiskersError);
 }
 
+BOOST_AUTO_TEST_CASE(same_template_different_parameters)
+{
+	// The parsed template is shared, the parameters are not.
+	std::string templ = "<?c><a><!c><#l><x><a></l></c>";
+	std::vector<std::map<std::string, std::string>> list(2);
+	list[0]["x"] = "1";
+	list[1]["x"] = "2";
+	Whiskers m1(templ);
+	Whiskers m2(templ);
+	m1("a", "A")("c", true)("l", list);
+	m2("a", "B")("c", false)("l", list);
+	BOOST_CHECK_EQUAL(m1.render(), "A");
+	BOOST_CHECK_EQUAL(m2.render(), "1B2B");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "C")("c", true)("l", list).render(), "C");
+	BOOST_CHECK_THROW(Whiskers{templ}("d", "D"), WhiskersError);
+}
+
 BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 {
 	std::string templ = "a <b >";
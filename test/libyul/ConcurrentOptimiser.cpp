@@ -0,0 +1,391 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests checking that running function-local optimiser steps and the optimisation
+ * and assembly of different sub-objects concurrently does not change the result, and neither
+ * does skipping functions that function-local steps would not change.
+ */
+
+#include <test/Common.h>
+#include <test/TestCaseReader.h>
+
+#include <libyul/YulStack.h>
+#include <libyul/AST.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <optional>
+#include <string>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// @returns the fully optimised code of @a _source or nothing if it is not valid strict assembly
+/// for the EVM version of the test run.
+std::optional<std::string> tryOptimise(std::string const& _source, size_t _concurrency)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		OptimiserSettings::full(),
+		DebugInfoSelection::All()
+	);
+	if (!stack.parseAndAnalyze("", _source) || !stack.errors().empty())
+		return std::nullopt;
+	stack.optimize(_concurrency);
+	return stack.print();
+}
+
+std::string optimise(std::string const& _source, size_t _concurrency)
+{
+	std::optional<std::string> optimised = tryOptimise(_source, _concurrency);
+	if (!optimised)
+		BOOST_FAIL("Invalid source.");
+	return *optimised;
+}
+
+/// Optimises and assembles @a _source and @returns the optimised code followed by
+/// the creation and deployed bytecode.
+std::string compile(std::string const& _source, size_t _concurrency)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		OptimiserSettings::full(),
+		DebugInfoSelection::All()
+	);
+	if (!stack.parseAndAnalyze("", _source) || !stack.errors().empty())
+		BOOST_FAIL("Invalid source.");
+	stack.optimize(_concurrency);
+	auto [creationObject, deployedObject] = stack.assembleWithDeployed("A_deployed", _concurrency);
+	BOOST_REQUIRE(creationObject.bytecode && deployedObject.bytecode);
+	return
+		stack.print() + "\n" +
+		util::toHex(creationObject.bytecode->bytecode) + "\n" +
+		util::toHex(deployedObject.bytecode->bytecode);
+}
+
+/// Compiles @a _sources via IR with full optimisation using up to @a _parallelism threads and @returns
+/// the optimised IR followed by the creation and deployed bytecode of every contract.
+std::string compileViaIR(std::map<std::string, std::string> const& _sources, size_t _parallelism)
+{
+	CompilerStack compilerStack;
+	compilerStack.setSources(_sources);
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setEOFVersion(solidity::test::CommonOptions::get().eofVersion());
+	compilerStack.setViaIR(true);
+	compilerStack.setOptimiserSettings(OptimiserSettings::full());
+	compilerStack.setParallelism(_parallelism);
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contracts failed");
+
+	std::string result;
+	for (std::string const& contract: compilerStack.contractNames())
+		result +=
+			contract + "\n" +
+			compilerStack.yulIROptimized(contract) + "\n" +
+			util::toHex(compilerStack.object(contract).bytecode) + "\n" +
+			util::toHex(compilerStack.runtimeObject(contract).bytecode) + "\n";
+	return result;
+}
+
+/// Runs the default optimiser sequence on the code of @a _source, with or without tracking changes
+/// to skip unchanged functions. @returns the optimised code and the number of skipped functions.
+std::pair<std::string, size_t> runDefaultSequence(std::string const& _source, bool _trackChanges)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		OptimiserSettings::none(),
+		DebugInfoSelection::All()
+	);
+	if (!stack.parseAndAnalyze("", _source) || !stack.errors().empty())
+		BOOST_FAIL("Invalid source.");
+	Object const& object = *stack.parserResult();
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion());
+	std::set<YulString> reservedIdentifiers;
+	Block ast = std::get<Block>(Disambiguator(dialect, *object.analysisInfo, reservedIdentifiers)(*object.code));
+	NameDispenser dispenser{dialect, ast, reservedIdentifiers};
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, 200};
+	OptimiserSuite suite(context, OptimiserSuite::Debug::None, 1, _trackChanges);
+	suite.runSequence("hgfo", ast);
+	suite.runSequence(OptimiserSettings::DefaultYulOptimiserSteps, ast);
+	suite.runSequence(OptimiserSettings::DefaultYulOptimiserCleanupSteps, ast);
+	return {AsmPrinter{dialect}(ast), suite.skippedStatements()};
+}
+
+/// Runs the step @a _step on the code of @a _source after bringing it into the form the optimiser
+/// suite establishes first. @returns the top-level statements the step reports as modified.
+std::set<YulString> reportedModifications(std::string const& _source, std::string const& _step)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		OptimiserSettings::none(),
+		DebugInfoSelection::All()
+	);
+	if (!stack.parseAndAnalyze("", _source) || !stack.errors().empty())
+		BOOST_FAIL("Invalid source.");
+	Object const& object = *stack.parserResult();
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion());
+	std::set<YulString> reservedIdentifiers;
+	Block ast = std::get<Block>(Disambiguator(dialect, *object.analysisInfo, reservedIdentifiers)(*object.code));
+	NameDispenser dispenser{dialect, ast, reservedIdentifiers};
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, 200};
+	OptimiserSuite{context}.runSequence("hgfo", ast);
+
+	std::set<YulString> modified;
+	context.modifiedTopLevelStatements = &modified;
+	OptimiserSuite::allSteps().at(_step)->run(context, ast);
+	return modified;
+}
+
+std::string const source = R"(
+	object "C" {
+		code {
+			sstore(0, f(calldataload(0), calldataload(32)))
+			sstore(1, g(calldataload(64)))
+			sstore(2, h(calldataload(96)))
+			function f(a, b) -> r {
+				for { let i := 0 } lt(i, b) { i := add(i, 1) } {
+					r := add(r, mul(a, i))
+					if gt(r, 1000) { break }
+				}
+				r := add(r, mload(0x40))
+			}
+			function g(x) -> y {
+				let t := and(x, 0xff)
+				switch t
+				case 0 { y := 1 }
+				case 1 { y := sload(x) }
+				default { y := add(t, t) }
+				if iszero(y) { revert(0, 0) }
+			}
+			function h(x) -> y {
+				mstore(0, x)
+				y := keccak256(0, 32)
+				if eq(mload(0), x) { y := add(y, f(x, 3)) }
+			}
+		}
+	}
+)";
+
+/// Contract with two factory sub-objects of different depth, one of them deploying
+/// the other one.
+std::string const objectTreeSource = R"(
+	object "A" {
+		code {
+			datacopy(0, dataoffset("A_deployed"), datasize("A_deployed"))
+			return(0, datasize("A_deployed"))
+		}
+		object "A_deployed" {
+			code {
+				let size := datasize("F")
+				datacopy(0, dataoffset("F"), size)
+				let f := create(0, 0, size)
+				size := datasize("G")
+				datacopy(0, dataoffset("G"), size)
+				sstore(f, create(0, 0, size))
+			}
+			object "F" {
+				code {
+					sstore(0, calldataload(0))
+					datacopy(0, dataoffset("F_deployed"), datasize("F_deployed"))
+					return(0, datasize("F_deployed"))
+				}
+				object "F_deployed" {
+					code {
+						function f(a) -> r { r := add(mul(a, sload(0)), 7) }
+						sstore(1, f(calldataload(0)))
+					}
+				}
+			}
+			object "G" {
+				code {
+					let size := datasize("F")
+					datacopy(0, dataoffset("F"), size)
+					sstore(0, create(0, 0, size))
+					datacopy(0, dataoffset("G_deployed"), datasize("G_deployed"))
+					return(0, datasize("G_deployed"))
+				}
+				object "G_deployed" {
+					code {
+						for { let i := 0 } lt(i, calldataload(0)) { i := add(i, 1) } {
+							sstore(i, keccak256(0, i))
+						}
+					}
+				}
+				object "F" {
+					code {
+						sstore(0, calldataload(0))
+						datacopy(0, dataoffset("F_deployed"), datasize("F_deployed"))
+						return(0, datasize("F_deployed"))
+					}
+					object "F_deployed" {
+						code {
+							function f(a) -> r { r := add(mul(a, sload(0)), 7) }
+							sstore(1, f(calldataload(0)))
+						}
+					}
+				}
+			}
+		}
+	}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(ConcurrentOptimiser)
+
+BOOST_AUTO_TEST_CASE(function_local_steps_are_marked)
+{
+	auto const& steps = OptimiserSuite::allSteps();
+	BOOST_CHECK(steps.at("ExpressionSimplifier")->isFunctionLocal());
+	BOOST_CHECK(steps.at("UnusedAssignEliminator")->isFunctionLocal());
+	BOOST_CHECK(!steps.at("FullInliner")->isFunctionLocal());
+	BOOST_CHECK(!steps.at("SSATransform")->isFunctionLocal());
+	BOOST_CHECK(!steps.at("UnusedPruner")->isFunctionLocal());
+}
+
+BOOST_AUTO_TEST_CASE(result_does_not_depend_on_concurrency)
+{
+	std::string const serial = optimise(source, 1);
+	for (size_t concurrency: {2, 4, 16})
+		BOOST_CHECK_EQUAL(optimise(source, concurrency), serial);
+}
+
+BOOST_AUTO_TEST_CASE(sub_objects_do_not_depend_on_concurrency)
+{
+	std::string const serial = compile(objectTreeSource, 1);
+	for (size_t concurrency: {2, 4, 16})
+		BOOST_CHECK_EQUAL(compile(objectTreeSource, concurrency), serial);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_tests_do_not_depend_on_concurrency)
+{
+	namespace fs = boost::filesystem;
+	size_t compared = 0;
+	fs::path const testPath = solidity::test::CommonOptions::get().testPath / "libyul/yulOptimizerTests";
+	for (fs::directory_entry const& entry: fs::recursive_directory_iterator(testPath))
+	{
+		if (entry.path().extension() != ".yul")
+			continue;
+		std::string const code = frontend::test::TestCaseReader(entry.path().string()).source();
+		// Skips the tests of other dialects and EVM versions.
+		std::optional<std::string> const serial = tryOptimise(code, 1);
+		if (!serial)
+			continue;
+		BOOST_CHECK_MESSAGE(tryOptimise(code, 4) == serial, entry.path().string());
+		++compared;
+	}
+	BOOST_CHECK(compared > 0);
+}
+
+BOOST_AUTO_TEST_CASE(external_contracts_do_not_depend_on_concurrency)
+{
+	namespace fs = boost::filesystem;
+	size_t compared = 0;
+	fs::path const testPath = solidity::test::CommonOptions::get().testPath / "libsolidity/semanticTests/externalContracts";
+	for (fs::directory_entry const& entry: fs::directory_iterator(testPath))
+	{
+		if (entry.path().extension() != ".sol")
+			continue;
+		std::map<std::string, std::string> const sources =
+			frontend::test::TestCaseReader(entry.path().string()).sources().sources;
+		BOOST_CHECK_MESSAGE(compileViaIR(sources, 4) == compileViaIR(sources, 1), entry.path().string());
+		++compared;
+	}
+	BOOST_CHECK(compared > 0);
+}
+
+BOOST_AUTO_TEST_CASE(steps_report_modified_functions)
+{
+	auto const& steps = OptimiserSuite::allSteps();
+	BOOST_CHECK(steps.at("FullInliner")->reportsModifications());
+	BOOST_CHECK(steps.at("FunctionGrouper")->reportsModifications());
+	BOOST_CHECK(steps.at("UnusedPruner")->reportsModifications());
+	BOOST_CHECK(!steps.at("SSATransform")->reportsModifications());
+	BOOST_CHECK(!steps.at("ExpressionSimplifier")->reportsModifications());
+
+	std::string const inlinerSource = R"(
+		{
+			let c := calldataload(0)
+			let x := f(c)
+			sstore(0, x)
+			function f(a) -> r { r := g(a) }
+			function g(b) -> s { s := add(b, 1) }
+			function k(d) -> e { e := calldataload(d) }
+		}
+	)";
+	BOOST_CHECK((reportedModifications(inlinerSource, "FullInliner") == std::set<YulString>{{}, YulString{"f"}}));
+
+	std::string const prunerSource = R"(
+		{
+			sstore(0, f(calldataload(0)))
+			function f(a) -> r { r := g(a) }
+			function g(b) -> s {
+				let unused := 7
+				s := add(b, 1)
+			}
+			function h() { sstore(1, 1) }
+		}
+	)";
+	std::set<YulString> const pruned = reportedModifications(prunerSource, "UnusedPruner");
+	BOOST_CHECK(pruned.count(YulString{"g"}));
+	BOOST_CHECK(!pruned.count(YulString{"f"}));
+	BOOST_CHECK(!pruned.count(YulString{}));
+
+	BOOST_CHECK(reportedModifications(prunerSource, "FunctionGrouper").empty());
+}
+
+BOOST_AUTO_TEST_CASE(result_does_not_depend_on_change_tracking)
+{
+	auto const [untracked, skippedWithoutTracking] = runDefaultSequence(source, false);
+	auto const [tracked, skipped] = runDefaultSequence(source, true);
+	BOOST_CHECK_EQUAL(tracked, untracked);
+	BOOST_CHECK_EQUAL(skippedWithoutTracking, 0);
+	BOOST_CHECK(skipped > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
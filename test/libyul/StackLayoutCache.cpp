@@ -0,0 +1,162 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the caches of stack layouts.
+ */
+
+#include <libyul/backends/evm/StackHelpers.h>
+#include <libyul/backends/evm/StackLayoutCache.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <deque>
+#include <random>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+class StackFactory
+{
+public:
+	StackSlot variable(std::string const& _name)
+	{
+		m_variables.emplace_back(Scope::Variable{""_yulstring, YulString(_name)});
+		return VariableSlot{m_variables.back()};
+	}
+
+private:
+	std::deque<Scope::Variable> m_variables;
+};
+
+/// @returns a description of the operations performed by createStackLayout and the resulting stack.
+std::string shuffle(Stack _source, Stack const& _target)
+{
+	std::string operations;
+	createStackLayout(
+		_source,
+		_target,
+		[&](unsigned _depth) { operations += "SWAP" + std::to_string(_depth) + " "; },
+		[&](StackSlot const& _slot) { operations += "PUSH/DUP(" + stackSlotToString(_slot) + ") "; },
+		[&]() { operations += "POP "; }
+	);
+	return operations + stackToString(_source);
+}
+
+class CacheEnabler
+{
+public:
+	explicit CacheEnabler(bool _enabled): m_previous(StackLayoutCaches::enabled())
+	{
+		StackLayoutCaches::setEnabled(_enabled);
+	}
+	~CacheEnabler() { StackLayoutCaches::setEnabled(m_previous); }
+
+private:
+	bool m_previous;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(StackLayoutCacheTest)
+
+BOOST_AUTO_TEST_CASE(pattern)
+{
+	StackFactory factory;
+	StackSlot a = factory.variable("a");
+	StackSlot b = factory.variable("b");
+	StackSlot x = factory.variable("x");
+	StackSlot y = factory.variable("y");
+
+	Stack source{a, b, a};
+	Stack target{b, JunkSlot{}, LiteralSlot{u256(1)}};
+	Stack renamedSource{x, y, x};
+	Stack renamedTarget{y, JunkSlot{}, LiteralSlot{u256(2)}};
+	std::optional<StackPattern> pattern = StackPattern::create({&source, &target});
+	std::optional<StackPattern> renamedPattern = StackPattern::create({&renamedSource, &renamedTarget});
+	BOOST_REQUIRE(pattern && renamedPattern);
+	BOOST_CHECK(pattern->key() == renamedPattern->key());
+	BOOST_CHECK(renamedPattern->decode(pattern->encode(Stack{b, a, JunkSlot{}})) == (Stack{y, x, JunkSlot{}}));
+
+	// Equality and the kinds of the slots matter.
+	Stack otherSource{a, b, b};
+	BOOST_CHECK(StackPattern::create({&otherSource, &target})->key() != pattern->key());
+	Stack literalTarget{b, LiteralSlot{u256(1)}, LiteralSlot{u256(1)}};
+	BOOST_CHECK(StackPattern::create({&source, &literalTarget})->key() != pattern->key());
+	// So do the flags and the boundaries of the stacks.
+	BOOST_CHECK(StackPattern::create({&source, &target}, 1)->key() != pattern->key());
+	Stack longerSource{a, b, a, b};
+	Stack shorterTarget{JunkSlot{}, LiteralSlot{u256(1)}};
+	BOOST_CHECK(StackPattern::create({&longerSource, &shorterTarget})->key() != pattern->key());
+
+	Stack large(StackPattern::maxSlots + 1, JunkSlot{});
+	BOOST_CHECK(!StackPattern::create({&large}));
+}
+
+BOOST_AUTO_TEST_CASE(replayed_shuffles_are_identical)
+{
+	StackFactory factory;
+	std::vector<StackSlot> slots;
+	std::vector<StackSlot> renamedSlots;
+	for (size_t i = 0; i < 6; ++i)
+	{
+		slots.emplace_back(factory.variable("v" + std::to_string(i)));
+		renamedSlots.emplace_back(factory.variable("w" + std::to_string(i)));
+	}
+	slots.emplace_back(LiteralSlot{u256(42)});
+	renamedSlots.emplace_back(LiteralSlot{u256(7)});
+
+	// Start with empty caches, so that none of them is full.
+	StackLayoutCaches::clear();
+	std::mt19937 random(1);
+	for (size_t iteration = 0; iteration < 500; ++iteration)
+	{
+		Stack source, target, renamedSource, renamedTarget;
+		for (size_t i = random() % 12; i > 0; --i)
+		{
+			size_t slot = random() % slots.size();
+			source.emplace_back(slots[slot]);
+			renamedSource.emplace_back(renamedSlots[slot]);
+		}
+		for (size_t i = random() % 12; i > 0; --i)
+		{
+			size_t slot = random() % (slots.size() + 1);
+			target.emplace_back(slot < slots.size() ? slots[slot] : JunkSlot{});
+			renamedTarget.emplace_back(slot < slots.size() ? renamedSlots[slot] : JunkSlot{});
+		}
+
+		std::string expectation;
+		std::string renamedExpectation;
+		{
+			CacheEnabler disable(false);
+			expectation = shuffle(source, target);
+			renamedExpectation = shuffle(renamedSource, renamedTarget);
+		}
+		CacheEnabler enable(true);
+		BOOST_CHECK_EQUAL(shuffle(source, target), expectation);
+		size_t hits = StackLayoutCaches::shuffles().statistics().hits;
+		BOOST_CHECK_EQUAL(shuffle(renamedSource, renamedTarget), renamedExpectation);
+		BOOST_CHECK_EQUAL(StackLayoutCaches::shuffles().statistics().hits, hits + 1);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
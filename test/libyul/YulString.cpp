@@ -0,0 +1,121 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for YulString and the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+	BOOST_CHECK(YulString{}.empty());
+	BOOST_CHECK(YulString{""}.empty());
+	BOOST_CHECK(YulString{""} == YulString{});
+	BOOST_CHECK_EQUAL(YulString{}.str(), "");
+	BOOST_CHECK_EQUAL(YulString{}.hash(), YulStringRepository::emptyHash());
+}
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	std::vector<YulString> first;
+	std::vector<YulString> second;
+	for (size_t i = 0; i < 1000; ++i)
+		first.emplace_back("interning_" + std::to_string(i));
+	for (size_t i = 0; i < 1000; ++i)
+		second.emplace_back("interning_" + std::to_string(i));
+
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		BOOST_CHECK(!first[i].empty());
+		BOOST_CHECK(first[i] == second[i]);
+		BOOST_CHECK_EQUAL(first[i].str(), "interning_" + std::to_string(i));
+		BOOST_CHECK_EQUAL(first[i].hash(), YulStringRepository::hash(first[i].str()));
+		if (i > 0)
+			BOOST_CHECK(first[i] != first[i - 1]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 8;
+	size_t const stringCount = 2000;
+	std::vector<std::vector<YulString>> results(threadCount);
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			// Every thread interns the same strings, but in a different order.
+			results[t].resize(stringCount);
+			for (size_t i = 0; i < stringCount; ++i)
+			{
+				size_t index = (i * 7 + t * 311) % stringCount;
+				results[t][index] = YulString("concurrent_" + std::to_string(index));
+			}
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+
+	for (size_t i = 0; i < stringCount; ++i)
+	{
+		BOOST_CHECK_EQUAL(results[0][i].str(), "concurrent_" + std::to_string(i));
+		for (size_t t = 1; t < threadCount; ++t)
+			BOOST_CHECK(results[t][i] == results[0][i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(resolution_while_interning)
+{
+	// Strings are resolved without locking while other threads add strings,
+	// which allocates new chunks of the repository.
+	std::vector<YulString> existing;
+	for (size_t i = 0; i < 500; ++i)
+		existing.emplace_back("resolved_" + std::to_string(i));
+
+	std::vector<std::thread> threads;
+	std::vector<bool> correct(4, true);
+	for (size_t t = 0; t < correct.size(); ++t)
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < 5000; ++i)
+			{
+				YulString added("added_" + std::to_string(t) + "_" + std::to_string(i));
+				if (added.str() != "added_" + std::to_string(t) + "_" + std::to_string(i))
+					correct[t] = false;
+				size_t index = (i * 13 + t) % existing.size();
+				if (existing[index].str() != "resolved_" + std::to_string(index))
+					correct[t] = false;
+			}
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+	for (bool threadCorrect: correct)
+		BOOST_CHECK(threadCorrect);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,141 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the maps and sets keyed by YulStrings.
+ */
+
+#include <libyul/YulStringMap.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringMapTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(map_basics)
+{
+	YulStringMap<int> map;
+	BOOST_CHECK(map.empty());
+	BOOST_CHECK(map.find("a"_yulstring) == map.end());
+	BOOST_CHECK(map.begin() == map.end());
+
+	map["a"_yulstring] = 1;
+	map[YulString{}] = 2;
+	BOOST_CHECK(!map.try_emplace("a"_yulstring, 3).second);
+	BOOST_CHECK(map.insert({"b"_yulstring, 4}).second);
+	BOOST_CHECK_EQUAL(map.size(), 3);
+	BOOST_CHECK_EQUAL(map.count("a"_yulstring), 1);
+	BOOST_CHECK_EQUAL(map.count("c"_yulstring), 0);
+	BOOST_CHECK_EQUAL(*util::valueOrNullptr(map, "a"_yulstring), 1);
+	BOOST_CHECK_EQUAL(*util::valueOrNullptr(map, YulString{}), 2);
+	BOOST_CHECK(!util::valueOrNullptr(map, "c"_yulstring));
+
+	BOOST_CHECK_EQUAL(map.erase("a"_yulstring), 1);
+	BOOST_CHECK_EQUAL(map.erase("a"_yulstring), 0);
+	BOOST_CHECK_EQUAL(map.size(), 2);
+	map.clear();
+	BOOST_CHECK(map.empty());
+	BOOST_CHECK(map.find("b"_yulstring) == map.end());
+}
+
+BOOST_AUTO_TEST_CASE(set_basics)
+{
+	YulStringSet set(std::vector<YulString>{"x"_yulstring, "y"_yulstring, "x"_yulstring});
+	BOOST_CHECK_EQUAL(set.size(), 2);
+	BOOST_CHECK(!set.insert("y"_yulstring).second);
+	BOOST_CHECK(set.insert("z"_yulstring).second);
+
+	YulStringSet other;
+	other.insert("w"_yulstring);
+	other += set;
+	BOOST_CHECK_EQUAL(other.size(), 4);
+	other.eraseIf([](YulString _element) { return _element != "w"_yulstring; });
+	BOOST_CHECK_EQUAL(other.size(), 1);
+	BOOST_CHECK_EQUAL(other.count("w"_yulstring), 1);
+}
+
+BOOST_AUTO_TEST_CASE(same_content_as_std_containers)
+{
+	std::vector<YulString> keys;
+	for (size_t i = 0; i < 300; ++i)
+		keys.emplace_back("key_" + std::to_string(i));
+
+	std::mt19937 random(7);
+	YulStringMap<size_t> map;
+	std::map<YulString, size_t> expectedMap;
+	YulStringSet set;
+	std::set<YulString> expectedSet;
+	for (size_t i = 0; i < 20000; ++i)
+	{
+		YulString key = keys[random() % keys.size()];
+		size_t value = random() % 5;
+		switch (random() % 4)
+		{
+		case 0:
+		case 1:
+			map[key] = value;
+			expectedMap[key] = value;
+			set.insert(key);
+			expectedSet.insert(key);
+			break;
+		case 2:
+			BOOST_REQUIRE_EQUAL(map.erase(key), expectedMap.erase(key));
+			BOOST_REQUIRE_EQUAL(set.erase(key), expectedSet.erase(key));
+			break;
+		case 3:
+			map.eraseIf([&](auto const& _entry) { return _entry.second == value; });
+			for (auto it = expectedMap.begin(); it != expectedMap.end();)
+				if (it->second == value)
+					it = expectedMap.erase(it);
+				else
+					++it;
+			break;
+		}
+
+		YulStringMap<size_t> const& constMap = map;
+		for (YulString const& probe: {key, keys[random() % keys.size()]})
+		{
+			size_t const* actual = util::valueOrNullptr(constMap, probe);
+			size_t const* expected = util::valueOrNullptr(expectedMap, probe);
+			BOOST_REQUIRE_EQUAL(!actual, !expected);
+			if (actual)
+				BOOST_REQUIRE_EQUAL(*actual, *expected);
+			BOOST_REQUIRE_EQUAL(set.count(probe), expectedSet.count(probe));
+		}
+	}
+
+	BOOST_REQUIRE_EQUAL(map.size(), expectedMap.size());
+	BOOST_REQUIRE_EQUAL(set.size(), expectedSet.size());
+	std::map<YulString, size_t> iteratedMap(map.begin(), map.end());
+	std::set<YulString> iteratedSet(set.begin(), set.end());
+	BOOST_CHECK(iteratedMap == expectedMap);
+	BOOST_CHECK(iteratedSet == expectedSet);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -120,6 +120,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--evm-version=spuriousDragon",
 			"--via-ir",
 			"--experimental-via-ir",
+			"--jobs=4",
+			"--cache-dir=/tmp/solc-cache",
 			"--revert-strings=strip",
 			"--debug-info=location",
 			"--pretty-json",
@@ -141,18 +143,23 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize-yul",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--profile-yul-optimizer",
 			"--model-checker-bmc-loop-iterations=2",
+			"--model-checker-cache=/tmp/smt-cache",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
 			"--model-checker-ext-calls=trusted",
 			"--model-checker-invariants=contract,reentrancy",
+			"--model-checker-portfolio=race",
 			"--model-checker-show-proved-safe",
 			"--model-checker-show-unproved",
 			"--model-checker-show-unsupported",
+			"--model-checker-solver-sessions",
 			"--model-checker-solvers=z3,smtlib2",
 			"--model-checker-targets=underflow,divByZero",
-			"--model-checker-timeout=5"
+			"--model-checker-timeout=5",
+			"--model-checker-workers=3"
 		};
 
 		if (inputMode == InputMode::CompilerWithASTImport)
@@ -179,6 +186,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.viaIR = true;
+		expectedOptions.output.jobs = 4;
+		expectedOptions.output.cacheDir = "/tmp/solc-cache";
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
@@ -207,6 +216,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.optimizer.optimizeYul = true;
 		expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		expectedOptions.optimizer.yulSteps = "agf";
+		expectedOptions.optimizer.profileYul = true;
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
@@ -216,6 +226,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			{true, false},
 			{ModelCheckerExtCalls::Mode::TRUSTED},
 			{{InvariantType::Contract, InvariantType::Reentrancy}},
+			{ModelCheckerPortfolio::Mode::RACE},
 			false, // --model-checker-print-query
 			true,
 			true,
@@ -223,7 +234,10 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			{false, false, true, true},
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
 			5,
+			3,
 		};
+		expectedOptions.modelChecker.cacheDir = "/tmp/smt-cache";
+		expectedOptions.modelChecker.solverSessions = true;
 
 		CommandLineOptions parsedOptions = parseCommandLine(commandLine);
 
@@ -266,6 +280,36 @@ BOOST_AUTO_TEST_CASE(via_ir_options)
 		BOOST_TEST(parseCommandLine({"solc", viaIrOption, "contract.sol"}).output.viaIR);
 }
 
+BOOST_AUTO_TEST_CASE(jobs_option)
+{
+	BOOST_TEST(parseCommandLine({"solc", "contract.sol"}).output.jobs == 1);
+	BOOST_TEST(parseCommandLine({"solc", "--jobs=0", "contract.sol"}).output.jobs == 0);
+	BOOST_TEST(parseCommandLine({"solc", "--jobs", "8", "--via-ir", "contract.sol"}).output.jobs == 8);
+}
+
+BOOST_AUTO_TEST_CASE(cache_dir_option)
+{
+	BOOST_TEST(parseCommandLine({"solc", "contract.sol"}).output.cacheDir.empty());
+	BOOST_TEST(parseCommandLine({"solc", "--cache-dir", "build/cache", "contract.sol"}).output.cacheDir == "build/cache");
+
+	std::string expectedMessage = "Option --cache-dir requires a non-empty path.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--cache-dir=", "contract.sol"}), CommandLineValidationError, hasCorrectMessage);
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_cache_option)
+{
+	BOOST_TEST(parseCommandLine({"solc", "contract.sol"}).modelChecker.cacheDir.empty());
+	BOOST_TEST(parseCommandLine({"solc", "--model-checker-cache", "build/smt", "contract.sol"}).modelChecker.cacheDir == "build/smt");
+	BOOST_TEST(parseCommandLine({"solc", "--model-checker-cache=build/smt", "--standard-json"}).modelChecker.cacheDir == "build/smt");
+	// Only the model checker settings initialize the model checker.
+	BOOST_TEST(!parseCommandLine({"solc", "--model-checker-cache=build/smt", "contract.sol"}).modelChecker.initialize);
+
+	std::string expectedMessage = "Option --model-checker-cache requires a non-empty path.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--model-checker-cache=", "contract.sol"}), CommandLineValidationError, hasCorrectMessage);
+}
+
 BOOST_AUTO_TEST_CASE(assembly_mode_options)
 {
 	static std::vector<std::tuple<std::vector<std::string>, YulStack::Machine, YulStack::Language>> const allowedCombinations = {
@@ -423,6 +467,8 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		// TODO: This should eventually contain all options.
 		{"--experimental-via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--jobs=2", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--cache-dir=cache", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-literal", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-hash=swarm", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-proved-safe", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
@@ -432,7 +478,10 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		{"--model-checker-engine=bmc", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-invariants=contract,reentrancy", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-solvers=z3,smtlib2", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-cache=cache", {"--assemble", "--yul", "--strict-assembly", "--link"}},
+		{"--model-checker-solver-sessions", {"--assemble", "--yul", "--strict-assembly", "--link"}},
 		{"--model-checker-timeout=5", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-workers=3", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-contracts=contract1.yul:A,contract2.yul:B", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-targets=underflow,divByZero", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}}
 	};
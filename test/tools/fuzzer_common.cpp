@@ -111,13 +111,15 @@ void FuzzerUtil::testCompiler(
 			frontend::ModelCheckerEngine::All(),
 			frontend::ModelCheckerExtCalls{},
 			frontend::ModelCheckerInvariants::All(),
+			frontend::ModelCheckerPortfolio{},
 			/*printQuery=*/false,
 			/*showProvedSafe=*/false,
 			/*showUnproved=*/false,
 			/*showUnsupported=*/false,
 			smtutil::SMTSolverChoice::All(),
 			frontend::ModelCheckerTargets::Default(),
-			/*timeout=*/1
+			/*timeout=*/1,
+			/*workers=*/1
 		});
 	}
 	compiler.setSources(_input);
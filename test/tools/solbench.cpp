@@ -0,0 +1,577 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compile-time benchmark: compiles a corpus of contracts through CompilerStack in several
+ * pipelines, reports the median and the spread of the compilation time and of its phases
+ * and compares them against a stored baseline.
+ */
+
+#include <test/TestCaseReader.h>
+
+#include <libsolidity/formal/ModelCheckerSettings.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/FileReader.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace fs = boost::filesystem;
+namespace po = boost::program_options;
+
+namespace
+{
+
+struct Benchmark
+{
+	std::string name;
+	std::map<std::string, std::string> sources;
+	/// Directory imports not contained in the sources are loaded from, if any.
+	std::optional<fs::path> basePath;
+};
+
+struct Pipeline
+{
+	std::string name;
+	bool viaIR = false;
+	bool optimize = false;
+};
+
+std::vector<Pipeline> const allPipelines{
+	{"legacy", false, false},
+	{"legacy-optimize", false, true},
+	{"via-ir", true, false},
+	{"via-ir-optimize", true, true}
+};
+
+/// Durations in microseconds of all runs of a benchmark in a pipeline.
+struct Samples
+{
+	std::vector<double> total;
+	std::map<std::string, std::vector<double>> phases;
+	/// Set if the compilation failed, in which case there are no samples.
+	std::optional<std::string> error;
+};
+
+struct Statistics
+{
+	double median = 0.0;
+	double standardDeviation = 0.0;
+};
+
+Statistics statistics(std::vector<double> _samples)
+{
+	Statistics result;
+	if (_samples.empty())
+		return result;
+	std::sort(_samples.begin(), _samples.end());
+	size_t const middle = _samples.size() / 2;
+	result.median = _samples.size() % 2 ? _samples[middle] : (_samples[middle - 1] + _samples[middle]) / 2.0;
+	if (_samples.size() > 1)
+	{
+		double mean = 0.0;
+		for (double sample: _samples)
+			mean += sample;
+		mean /= static_cast<double>(_samples.size());
+		double sumOfSquares = 0.0;
+		for (double sample: _samples)
+			sumOfSquares += (sample - mean) * (sample - mean);
+		result.standardDeviation = std::sqrt(sumOfSquares / static_cast<double>(_samples.size() - 1));
+	}
+	return result;
+}
+
+Json toJson(Statistics const& _statistics)
+{
+	Json result;
+	result["median"] = _statistics.median;
+	result["standardDeviation"] = _statistics.standardDeviation;
+	return result;
+}
+
+/// @returns all Solidity files at @a _path, which is either a file or a directory searched recursively,
+/// in a deterministic order.
+std::vector<fs::path> solidityFiles(fs::path const& _path)
+{
+	if (!fs::is_directory(_path))
+		return {_path};
+	std::vector<fs::path> files;
+	for (fs::directory_entry const& entry: fs::recursive_directory_iterator(_path))
+		if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+			files.push_back(entry.path());
+	std::sort(files.begin(), files.end());
+	return files;
+}
+
+/// Adds one benchmark per file at @a _path, containing only that file.
+void addFiles(std::vector<Benchmark>& _benchmarks, fs::path const& _path)
+{
+	for (fs::path const& file: solidityFiles(_path))
+		_benchmarks.push_back({
+			file.generic_string(),
+			{{file.filename().generic_string(), util::readFileAsString(file)}},
+			file.parent_path()
+		});
+}
+
+/// Adds one benchmark per test case at @a _path. The sources of a test case are the ones defined
+/// in the test file, including external sources.
+void addTestCases(std::vector<Benchmark>& _benchmarks, fs::path const& _path)
+{
+	for (fs::path const& file: solidityFiles(_path))
+	{
+		frontend::test::TestCaseReader reader(file.string());
+		_benchmarks.push_back({file.generic_string(), reader.sources().sources, std::nullopt});
+	}
+}
+
+/// Adds a single benchmark containing all files of the project at @a _path, with source unit
+/// names relative to it.
+void addProject(std::vector<Benchmark>& _benchmarks, fs::path const& _path)
+{
+	Benchmark benchmark{_path.generic_string(), {}, _path};
+	for (fs::path const& file: solidityFiles(_path))
+		benchmark.sources[fs::relative(file, _path).generic_string()] = util::readFileAsString(file);
+	_benchmarks.push_back(std::move(benchmark));
+}
+
+/// Compiles @a _benchmark in @a _pipeline once and adds the wall time of the compilation and of
+/// its phases to @a o_samples. Phases of different contracts with the same name are added up.
+/// @returns the error message if the compilation failed.
+std::optional<std::string> run(
+	Benchmark const& _benchmark,
+	Pipeline const& _pipeline,
+	EVMVersion _evmVersion,
+	ModelCheckerSettings const& _modelCheckerSettings,
+	std::vector<fs::path> const& _includePaths,
+	Samples* o_samples
+)
+{
+	std::unique_ptr<FileReader> fileReader;
+	ReadCallback::Callback readFile;
+	if (_benchmark.basePath)
+	{
+		fileReader = std::make_unique<FileReader>(*_benchmark.basePath, _includePaths);
+		fileReader->allowDirectory(*_benchmark.basePath);
+		for (fs::path const& includePath: _includePaths)
+			fileReader->allowDirectory(includePath);
+		readFile = fileReader->reader();
+	}
+
+	CompilerStack compilerStack(readFile);
+	compilerStack.setSources(_benchmark.sources);
+	compilerStack.setEVMVersion(_evmVersion);
+	compilerStack.setViaIR(_pipeline.viaIR);
+	compilerStack.setOptimiserSettings(_pipeline.optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal());
+	compilerStack.setModelCheckerSettings(_modelCheckerSettings);
+	compilerStack.enableTimings();
+
+	bool success = false;
+	auto const start = std::chrono::steady_clock::now();
+	try
+	{
+		success = compilerStack.compile();
+	}
+	catch (std::exception const& _exception)
+	{
+		return std::string("Exception during compilation: ") + _exception.what();
+	}
+	auto const end = std::chrono::steady_clock::now();
+	if (!success)
+		return SourceReferenceFormatter::formatErrorInformation(compilerStack.errors(), compilerStack);
+
+	if (!o_samples)
+		return std::nullopt;
+
+	o_samples->total.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+	std::map<std::string, double> phases;
+	Json const timings = compilerStack.timings();
+	for (Json const& phase: timings["phases"])
+		phases[phase["phase"].get<std::string>()] += phase["durationMicroseconds"].get<double>();
+	for (Json const& contracts: timings["contracts"])
+		for (Json const& contractPhases: contracts)
+			for (Json const& phase: contractPhases)
+				phases[phase["phase"].get<std::string>()] += phase["durationMicroseconds"].get<double>();
+	for (auto const& [phase, duration]: phases)
+		o_samples->phases[phase].push_back(duration);
+	return std::nullopt;
+}
+
+std::string formatStatistics(Statistics const& _statistics)
+{
+	std::ostringstream output;
+	output << std::fixed << std::setprecision(2) << std::setw(10) << _statistics.median / 1000.0 << " ms";
+	double const relativeDeviation = _statistics.median > 0.0 ? 100.0 * _statistics.standardDeviation / _statistics.median : 0.0;
+	output << " ± " << std::setprecision(1) << std::setw(5) << relativeDeviation << "%";
+	return output.str();
+}
+
+/// Compares the statistics of @a _results against @a _baseline and prints every change
+/// beyond the tolerance. @returns the number of regressions.
+size_t compare(Json const& _baseline, Json const& _results, double _tolerance, double _minDifference)
+{
+	size_t regressions = 0;
+	auto check = [&](std::string const& _what, Json const& _before, Json const& _after) {
+		double const before = _before["median"].get<double>();
+		double const after = _after["median"].get<double>();
+		double const difference = after - before;
+		if (std::abs(difference) < _minDifference || std::abs(difference) <= before * _tolerance)
+			return;
+		bool const regression = difference > 0.0;
+		if (regression)
+			++regressions;
+		std::cout <<
+			(regression ? "REGRESSION  " : "improvement ") <<
+			_what << ": " <<
+			std::fixed << std::setprecision(2) <<
+			before / 1000.0 << " ms -> " << after / 1000.0 << " ms (" <<
+			std::showpos << std::setprecision(1) << (before > 0.0 ? 100.0 * difference / before : 0.0) << std::noshowpos <<
+			"%)" << std::endl;
+	};
+
+	for (auto const& [benchmark, pipelines]: _baseline["benchmarks"].items())
+		for (auto const& [pipeline, before]: pipelines.items())
+		{
+			std::string const what = benchmark + " [" + pipeline + "]";
+			if (!_results["benchmarks"].contains(benchmark) || !_results["benchmarks"][benchmark].contains(pipeline))
+			{
+				std::cout << "missing     " << what << ": not part of this run" << std::endl;
+				continue;
+			}
+			Json const& after = _results["benchmarks"][benchmark][pipeline];
+			if (after.contains("error"))
+			{
+				if (!before.contains("error"))
+				{
+					++regressions;
+					std::cout << "REGRESSION  " << what << ": compilation failed" << std::endl;
+				}
+				continue;
+			}
+			if (before.contains("error"))
+				continue;
+			check(what, before["total"], after["total"]);
+			for (auto const& [phase, phaseBefore]: before["phases"].items())
+				if (after["phases"].contains(phase))
+					check(what + " " + phase, phaseBefore, after["phases"][phase]);
+		}
+	return regressions;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		std::vector<std::string> inputFiles;
+		std::vector<std::string> testCaseDirectories;
+		std::vector<std::string> projectDirectories;
+		std::vector<std::string> includePaths;
+		std::string pipelineNames;
+		std::string filter;
+		std::string evmVersionName;
+		std::string modelCheckerEngineName;
+		std::string baselinePath;
+		std::string outputPath;
+		size_t runs = 0;
+		size_t warmupRuns = 0;
+		double tolerance = 0.0;
+		double minDifference = 0.0;
+		po::options_description options(
+			R"(solbench, compile-time benchmark of the Solidity compiler.
+	Usage: solbench [Options] [input-file...]
+	Compiles every Solidity file given directly or found in the given directories on its own,
+	every test case (e.g. of test/libsolidity/semanticTests) and every project (all files of
+	a directory, e.g. a vendored external project, compiled together) in each pipeline
+	several times and reports the median wall time of the compilation and of its phases
+	together with the relative standard deviation.
+	Compilations that fail are reported and excluded.
+	If a baseline is given, all changes of the medians beyond the tolerance are reported
+	and the exit code is 2 if anything got slower or stopped compiling.
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			(
+				"input-file",
+				po::value<std::vector<std::string>>(&inputFiles),
+				"Solidity files or directories containing them, each file is a separate benchmark."
+			)
+			(
+				"test-cases",
+				po::value<std::vector<std::string>>(&testCaseDirectories),
+				"Test case files in the format of isoltest or directories containing them."
+			)
+			(
+				"project",
+				po::value<std::vector<std::string>>(&projectDirectories),
+				"Directory of a project whose files are compiled together. Imports are resolved relative to it."
+			)
+			(
+				"include-path",
+				po::value<std::vector<std::string>>(&includePaths),
+				"Additional directory to resolve imports of files and projects from."
+			)
+			(
+				"pipelines",
+				po::value<std::string>(&pipelineNames)->default_value("legacy,legacy-optimize,via-ir,via-ir-optimize"),
+				"Comma-separated list of the pipelines to benchmark."
+			)
+			(
+				"filter",
+				po::value<std::string>(&filter),
+				"Only run the benchmarks whose name contains the given string."
+			)
+			(
+				"evm-version",
+				po::value<std::string>(&evmVersionName),
+				"EVM version to compile for. Defaults to the default of the compiler."
+			)
+			(
+				"runs",
+				po::value<size_t>(&runs)->default_value(5),
+				"Number of measured compilations of every benchmark in every pipeline."
+			)
+			(
+				"warmup-runs",
+				po::value<size_t>(&warmupRuns)->default_value(1),
+				"Number of compilations before the measured ones."
+			)
+			(
+				"phases",
+				"Print the statistics of every phase of the compilation."
+			)
+			(
+				"output",
+				po::value<std::string>(&outputPath),
+				"Write the results as JSON to the given file, to be used as a baseline later."
+			)
+			(
+				"baseline",
+				po::value<std::string>(&baselinePath),
+				"Compare the results against the JSON file written by an earlier run with --output."
+			)
+			(
+				"tolerance",
+				po::value<double>(&tolerance)->default_value(10.0),
+				"Change of a median in percent that is reported when comparing against a baseline."
+			)
+			(
+				"min-difference",
+				po::value<double>(&minDifference)->default_value(1000.0),
+				"Change of a median in microseconds below which it is not reported, to ignore noise in short phases."
+			)
+			(
+				"model-checker-engine",
+				po::value<std::string>(&modelCheckerEngineName),
+				"Run the model checker with the given engine (all, bmc, chc or none), "
+				"e.g. to measure the modelChecker phase on test/libsolidity/smtCheckerTests."
+			)
+			("help,h", "Show this help screen.");
+		po::positional_options_description positionalOptions;
+		positionalOptions.add("input-file", -1);
+
+		po::variables_map arguments;
+		po::store(po::command_line_parser(argc, argv).options(options).positional(positionalOptions).run(), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help"))
+		{
+			std::cout << options;
+			return 0;
+		}
+
+		std::vector<Pipeline> pipelines;
+		std::vector<std::string> requestedPipelines;
+		boost::split(requestedPipelines, pipelineNames, boost::is_any_of(","));
+		for (std::string const& name: requestedPipelines)
+		{
+			auto pipeline = std::find_if(allPipelines.begin(), allPipelines.end(), [&](Pipeline const& _pipeline) {
+				return _pipeline.name == name;
+			});
+			if (pipeline == allPipelines.end())
+			{
+				std::cerr << "Invalid pipeline: " << name << std::endl;
+				return 1;
+			}
+			pipelines.push_back(*pipeline);
+		}
+
+		EVMVersion evmVersion;
+		if (!evmVersionName.empty())
+		{
+			std::optional<EVMVersion> version = EVMVersion::fromString(evmVersionName);
+			if (!version)
+			{
+				std::cerr << "Invalid EVM version: " << evmVersionName << std::endl;
+				return 1;
+			}
+			evmVersion = *version;
+		}
+
+		ModelCheckerSettings modelCheckerSettings;
+		if (!modelCheckerEngineName.empty())
+		{
+			std::optional<ModelCheckerEngine> engine = ModelCheckerEngine::fromString(modelCheckerEngineName);
+			if (!engine)
+			{
+				std::cerr << "Invalid model checker engine: " << modelCheckerEngineName << std::endl;
+				return 1;
+			}
+			modelCheckerSettings.engine = *engine;
+		}
+
+		std::vector<Benchmark> benchmarks;
+		for (std::string const& path: inputFiles)
+			addFiles(benchmarks, path);
+		for (std::string const& path: testCaseDirectories)
+			addTestCases(benchmarks, path);
+		for (std::string const& path: projectDirectories)
+			addProject(benchmarks, path);
+		if (!filter.empty())
+			benchmarks.erase(
+				std::remove_if(benchmarks.begin(), benchmarks.end(), [&](Benchmark const& _benchmark) {
+					return _benchmark.name.find(filter) == std::string::npos;
+				}),
+				benchmarks.end()
+			);
+		if (benchmarks.empty())
+		{
+			std::cerr << "No benchmarks given. Use --help for the available options." << std::endl;
+			return 1;
+		}
+
+		std::vector<fs::path> const includeDirectories(includePaths.begin(), includePaths.end());
+		bool const printPhases = arguments.count("phases") > 0;
+
+		Json results;
+		results["runs"] = runs;
+		results["evmVersion"] = evmVersion.name();
+		results["benchmarks"] = Json::object();
+		for (Benchmark const& benchmark: benchmarks)
+			for (Pipeline const& pipeline: pipelines)
+			{
+				Samples samples;
+				for (size_t i = 0; i < warmupRuns + runs && !samples.error; ++i)
+					samples.error = run(benchmark, pipeline, evmVersion, modelCheckerSettings, includeDirectories, i < warmupRuns ? nullptr : &samples);
+
+				Json& result = results["benchmarks"][benchmark.name][pipeline.name];
+				std::cout << std::left << std::setw(60) << benchmark.name << " " << std::setw(16) << pipeline.name << std::right;
+				if (samples.error)
+				{
+					result["error"] = *samples.error;
+					std::cout << "  compilation failed" << std::endl;
+					std::cerr << *samples.error << std::endl;
+					continue;
+				}
+
+				Statistics const total = statistics(samples.total);
+				result["total"] = toJson(total);
+				result["phases"] = Json::object();
+				std::cout << formatStatistics(total) << std::endl;
+
+				std::vector<std::pair<std::string, Statistics>> phases;
+				for (auto const& [phase, phaseSamples]: samples.phases)
+				{
+					phases.emplace_back(phase, statistics(phaseSamples));
+					result["phases"][phase] = toJson(phases.back().second);
+				}
+				if (printPhases)
+				{
+					std::stable_sort(phases.begin(), phases.end(), [](auto const& _a, auto const& _b) {
+						return _a.second.median > _b.second.median;
+					});
+					for (auto const& [phase, phaseStatistics]: phases)
+						std::cout << "    " << std::left << std::setw(73) << phase << std::right << formatStatistics(phaseStatistics) << std::endl;
+				}
+			}
+
+		if (!outputPath.empty())
+		{
+			std::ofstream output(outputPath);
+			output << util::jsonPrettyPrint(results) << std::endl;
+			if (!output)
+			{
+				std::cerr << "Could not write the results to " << outputPath << std::endl;
+				return 1;
+			}
+		}
+
+		if (!baselinePath.empty())
+		{
+			Json baseline;
+			std::string errors;
+			if (!util::jsonParseStrict(util::readFileAsString(baselinePath), baseline, &errors))
+			{
+				std::cerr << "Invalid baseline: " << errors << std::endl;
+				return 1;
+			}
+			std::cout << std::endl << "Comparison against " << baselinePath << ":" << std::endl;
+			if (!baseline.contains("benchmarks") || !baseline["benchmarks"].is_object())
+			{
+				std::cerr << "Invalid baseline: no benchmarks." << std::endl;
+				return 1;
+			}
+			if (baseline.value("evmVersion", "") != evmVersion.name())
+				std::cout << "The baseline was measured for a different EVM version." << std::endl;
+			size_t const regressions = compare(baseline, results, tolerance / 100.0, minDifference);
+			if (regressions > 0)
+			{
+				std::cout << regressions << " performance regression(s) found." << std::endl;
+				return 2;
+			}
+			std::cout << "No performance regressions found." << std::endl;
+		}
+		return 0;
+	}
+	catch (po::error const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+	catch (std::exception const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+}
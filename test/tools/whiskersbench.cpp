@@ -0,0 +1,155 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark for rendering Whiskers templates: generates the ABI encoding and decoding
+ * functions of a contract with complex parameter types over and over again, as the IR
+ * generator does for every contract.
+ */
+
+#include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+std::string const source = R"(
+	// SPDX-License-Identifier: GPL-3.0
+	pragma solidity >=0.0;
+	contract C {
+		struct S { uint8 a; bytes b; uint[2][] c; string[] d; }
+		struct T { S[] s; address[3] e; bytes32 f; int16 g; function() external h; }
+		function f1(uint a, bytes calldata b, string memory c) external returns (bytes memory, uint[] memory) {}
+		function f2(S calldata s, T memory t) external returns (T memory) {}
+		function f3(T[] calldata t, bool[][2] memory b) external returns (S[] memory, string memory) {}
+		function f4(uint8[][] memory a, bytes[] calldata b, int128[3][] memory c) external returns (S memory) {}
+		function f5(bytes4 a, address payable b, uint24[] calldata c, S[2] memory d) external returns (int[][] memory) {}
+	}
+)";
+
+/// Generates the ABI functions of all external functions of @a _contract.
+/// @returns the size of the generated code.
+size_t generate(ContractDefinition const& _contract, EVMVersion _evmVersion)
+{
+	MultiUseYulFunctionCollector functionCollector;
+	ABIFunctions abiFunctions(_evmVersion, RevertStrings::Default, functionCollector);
+	for (auto const& [selector, type]: _contract.interfaceFunctionList())
+	{
+		abiFunctions.tupleDecoder(type->parameterTypes());
+		abiFunctions.tupleDecoder(type->parameterTypes(), true /* _fromMemory */);
+		abiFunctions.tupleEncoder(type->returnParameterTypes(), type->returnParameterTypes());
+	}
+	return functionCollector.requestedFunctions().size();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		size_t rounds = 0;
+		size_t iterations = 0;
+		po::options_description options(
+			R"(whiskersbench, benchmark for rendering Whiskers templates.
+	Usage: whiskersbench [Options]
+	Generates the ABI encoding and decoding functions of a contract with complex parameter types
+	and reports the time of every round. The first round includes parsing the templates,
+	all later rounds take them from the template cache.
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			(
+				"rounds",
+				po::value<size_t>(&rounds)->default_value(5),
+				"number of rounds"
+			)
+			(
+				"iterations",
+				po::value<size_t>(&iterations)->default_value(200),
+				"number of times the functions are generated per round"
+			)
+			("help,h", "Show this help screen.");
+
+		po::variables_map arguments;
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help"))
+		{
+			std::cout << options;
+			return 0;
+		}
+
+		EVMVersion const evmVersion;
+		CompilerStack compilerStack;
+		compilerStack.setSources({{"bench.sol", source}});
+		compilerStack.setEVMVersion(evmVersion);
+		if (!compilerStack.compile(CompilerStack::State::AnalysisSuccessful))
+		{
+			SourceReferenceFormatter{std::cerr, compilerStack, false, false}.printErrorInformation(compilerStack.errors());
+			return 1;
+		}
+		ContractDefinition const& contract = compilerStack.contractDefinition("bench.sol:C");
+
+		double best = 0.0;
+		size_t codeSize = 0;
+		for (size_t round = 0; round < rounds; ++round)
+		{
+			auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < iterations; ++i)
+				codeSize = generate(contract, evmVersion);
+			auto end = std::chrono::steady_clock::now();
+			double time = std::chrono::duration<double, std::milli>(end - start).count();
+			std::cout << "round " << round << ": " << std::fixed << std::setprecision(1) << time << "ms" << std::endl;
+			if (round == 0 || time < best)
+				best = time;
+		}
+		if (rounds > 0 && best > 0.0)
+			std::cout <<
+				"best: " <<
+				std::fixed << std::setprecision(2) <<
+				static_cast<double>(iterations * codeSize) / best / 1000.0 <<
+				" MB/s of generated code (" << codeSize << " bytes per iteration)" <<
+				std::endl;
+		return 0;
+	}
+	catch (po::error const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,477 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark for individual Yul optimiser steps: runs every step on every object of a corpus
+ * of Yul code, e.g. the optimiser test cases or the IR generated for contracts, and reports
+ * the throughput and the heap allocations of every step.
+ */
+
+#include <test/TestCaseReader.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libyul/AST.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/Object.h>
+#include <libyul/YulStack.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+namespace fs = boost::filesystem;
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Number and total size of all heap allocations of the process so far.
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> allocatedBytes{0};
+
+void* allocate(std::size_t _size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	allocatedBytes.fetch_add(_size, std::memory_order_relaxed);
+	if (void* memory = std::malloc(_size == 0 ? 1 : _size))
+		return memory;
+	throw std::bad_alloc();
+}
+
+}
+
+// Replacing the global allocation functions is the only way to count all allocations
+// without an instrumented allocator. Aligned allocations are not counted.
+void* operator new(std::size_t _size) { return allocate(_size); }
+void* operator new[](std::size_t _size) { return allocate(_size); }
+void operator delete(void* _memory) noexcept { std::free(_memory); }
+void operator delete[](void* _memory) noexcept { std::free(_memory); }
+void operator delete(void* _memory, std::size_t) noexcept { std::free(_memory); }
+void operator delete[](void* _memory, std::size_t) noexcept { std::free(_memory); }
+
+namespace
+{
+
+/// Code of a single object, disambiguated and brought into the form the optimiser suite
+/// establishes before running any step.
+struct Input
+{
+	std::string name;
+	std::shared_ptr<yul::Block> code;
+	size_t nodes = 0;
+};
+
+struct StepResult
+{
+	std::string step;
+	char abbreviation = 0;
+	size_t nodes = 0;
+	/// Wall time of the fastest repetition in microseconds.
+	double bestDuration = 0.0;
+	/// Allocations of a single repetition.
+	size_t allocations = 0;
+	size_t bytes = 0;
+	size_t failures = 0;
+};
+
+/// @returns the number of statements and expressions of @a _ast.
+size_t nodeCount(yul::Block const& _ast)
+{
+	CodeWeights weights;
+	weights.expressionStatementCost = 1;
+	weights.assignmentCost = 1;
+	weights.variableDeclarationCost = 1;
+	weights.functionDefinitionCost = 1;
+	weights.ifCost = 1;
+	weights.switchCost = 1;
+	weights.caseCost = 1;
+	weights.forLoopCost = 1;
+	weights.breakCost = 1;
+	weights.continueCost = 1;
+	weights.leaveCost = 1;
+	weights.blockCost = 1;
+	weights.functionCallCost = 1;
+	weights.identifierCost = 1;
+	weights.literalCost = 1;
+	weights.literalZeroCost = 1;
+	return CodeSize::codeSizeIncludingFunctions(_ast, weights);
+}
+
+class Corpus
+{
+public:
+	Corpus(EVMVersion _evmVersion, bool _verbose):
+		m_evmVersion(_evmVersion),
+		m_dialect(EVMDialect::strictAssemblyForEVMObjects(_evmVersion)),
+		m_reservedIdentifiers(m_dialect.fixedFunctionNames()),
+		m_verbose(_verbose)
+	{}
+
+	/// Adds the objects of the Yul file or the IR of all contracts of the Solidity file at @a _path.
+	/// Both can be in the format of isoltest. Files that fail to compile are skipped.
+	void addFile(fs::path const& _path)
+	{
+		try
+		{
+			frontend::test::TestCaseReader reader(_path.string());
+			if (_path.extension() == ".sol")
+				addSolidity(_path.generic_string(), reader.sources().sources);
+			else
+				addYul(_path.generic_string(), reader.source());
+		}
+		catch (std::exception const& _exception)
+		{
+			skip(_path.generic_string(), _exception.what());
+		}
+	}
+
+	std::vector<Input> const& inputs() const { return m_inputs; }
+	size_t skipped() const { return m_skipped; }
+	Dialect const& dialect() const { return m_dialect; }
+	std::set<YulString> const& reservedIdentifiers() const { return m_reservedIdentifiers; }
+
+private:
+	void addSolidity(std::string const& _name, std::map<std::string, std::string> const& _sources)
+	{
+		CompilerStack compilerStack;
+		compilerStack.setSources(_sources);
+		compilerStack.setEVMVersion(m_evmVersion);
+		compilerStack.setViaIR(true);
+		compilerStack.enableEvmBytecodeGeneration(false);
+		compilerStack.enableIRGeneration(true);
+		if (!compilerStack.compile())
+		{
+			skip(_name, "compilation failed");
+			return;
+		}
+		for (std::string const& contract: compilerStack.contractNames())
+			if (!compilerStack.yulIR(contract).empty())
+				addYul(_name + ":" + contract, compilerStack.yulIR(contract));
+	}
+
+	void addYul(std::string const& _name, std::string const& _source)
+	{
+		YulStack stack(
+			m_evmVersion,
+			std::nullopt,
+			YulStack::Language::StrictAssembly,
+			OptimiserSettings::none(),
+			DebugInfoSelection::Default()
+		);
+		if (!stack.parseAndAnalyze(_name, _source))
+		{
+			skip(_name, "invalid Yul code");
+			return;
+		}
+		addObject(_name, *stack.parserResult());
+	}
+
+	void addObject(std::string const& _name, Object const& _object)
+	{
+		if (_object.code && _object.analysisInfo)
+		{
+			auto code = std::make_shared<yul::Block>(std::get<yul::Block>(
+				Disambiguator(m_dialect, *_object.analysisInfo, m_reservedIdentifiers)(*_object.code)
+			));
+			NameDispenser dispenser{m_dialect, *code, m_reservedIdentifiers};
+			OptimiserStepContext context{m_dialect, dispenser, m_reservedIdentifiers, std::nullopt};
+			// Some steps depend on the properties ensured by these steps, so the suite runs them first.
+			OptimiserSuite{context}.runSequence("hgfo", *code);
+			m_inputs.push_back({_name + "/" + _object.name.str(), code, nodeCount(*code)});
+		}
+		for (std::shared_ptr<ObjectNode> const& subNode: _object.subObjects)
+			if (Object const* subObject = dynamic_cast<Object const*>(subNode.get()))
+				addObject(_name, *subObject);
+	}
+
+	void skip(std::string const& _name, std::string const& _reason)
+	{
+		++m_skipped;
+		if (m_verbose)
+			std::cerr << "Skipping " << _name << ": " << _reason << std::endl;
+	}
+
+	EVMVersion m_evmVersion;
+	Dialect const& m_dialect;
+	std::set<YulString> const m_reservedIdentifiers;
+	bool m_verbose = false;
+	std::vector<Input> m_inputs;
+	size_t m_skipped = 0;
+};
+
+/// Runs @a _step on copies of all inputs of @a _corpus @a _repetitions times.
+StepResult benchmark(Corpus const& _corpus, std::string const& _step, size_t _repetitions)
+{
+	OptimiserStep const& step = *OptimiserSuite::allSteps().at(_step);
+	StepResult result;
+	result.step = _step;
+	result.abbreviation = OptimiserSuite::stepNameToAbbreviationMap().at(_step);
+	for (size_t repetition = 0; repetition < _repetitions; ++repetition)
+	{
+		double duration = 0.0;
+		size_t allocations = 0;
+		size_t bytes = 0;
+		size_t failures = 0;
+		for (Input const& input: _corpus.inputs())
+		{
+			yul::Block code = std::get<yul::Block>(ASTCopier{}(*input.code));
+			NameDispenser dispenser{_corpus.dialect(), code, _corpus.reservedIdentifiers()};
+			OptimiserStepContext context{
+				_corpus.dialect(),
+				dispenser,
+				_corpus.reservedIdentifiers(),
+				OptimiserSettings::standard().expectedExecutionsPerDeployment
+			};
+
+			size_t const allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+			size_t const bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+			auto const start = std::chrono::steady_clock::now();
+			try
+			{
+				step.run(context, code);
+			}
+			catch (std::exception const&)
+			{
+				++failures;
+			}
+			auto const end = std::chrono::steady_clock::now();
+			allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+			bytes += allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+			duration += std::chrono::duration<double, std::micro>(end - start).count();
+			if (repetition == 0)
+				result.nodes += input.nodes;
+		}
+		if (repetition == 0 || duration < result.bestDuration)
+			result.bestDuration = duration;
+		result.allocations = allocations;
+		result.bytes = bytes;
+		result.failures = failures;
+	}
+	return result;
+}
+
+/// @returns the files at @a _path, which is either a file or a directory searched recursively
+/// for Yul and Solidity files, in a deterministic order.
+std::vector<fs::path> inputFiles(fs::path const& _path)
+{
+	if (!fs::is_directory(_path))
+		return {_path};
+	std::vector<fs::path> files;
+	for (fs::directory_entry const& entry: fs::recursive_directory_iterator(_path))
+		if (fs::is_regular_file(entry.path()) && (entry.path().extension() == ".yul" || entry.path().extension() == ".sol"))
+			files.push_back(entry.path());
+	std::sort(files.begin(), files.end());
+	return files;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		std::vector<std::string> inputPaths;
+		std::string stepAbbreviations;
+		std::string evmVersionName;
+		std::string outputPath;
+		size_t repetitions = 0;
+		po::options_description options(
+			R"(yuloptbench, benchmark for individual Yul optimizer steps.
+	Usage: yuloptbench [Options] <file or directory>...
+	Runs every optimizer step on every object of the given Yul files (e.g. the optimizer tests
+	in test/libyul/yulOptimizerTests or IR written by solc --ir -o) and of the IR generated for
+	the contracts in the given Solidity files. Every object is disambiguated and brought into
+	the form the optimizer suite establishes before its sequence, i.e. the steps "hgfo" are run.
+	Then every step runs on a fresh copy of every object and the throughput of the fastest
+	repetition as well as the number and size of the heap allocations are reported.
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			(
+				"input-file",
+				po::value<std::vector<std::string>>(&inputPaths),
+				"Yul or Solidity files or directories containing them."
+			)
+			(
+				"steps",
+				po::value<std::string>(&stepAbbreviations),
+				"Abbreviations of the steps to benchmark. Defaults to all steps."
+			)
+			(
+				"repetitions",
+				po::value<size_t>(&repetitions)->default_value(5),
+				"Number of times every step runs on the whole corpus."
+			)
+			(
+				"evm-version",
+				po::value<std::string>(&evmVersionName),
+				"EVM version to use. Defaults to the default of the compiler."
+			)
+			(
+				"output",
+				po::value<std::string>(&outputPath),
+				"Also write the results as JSON to the given file."
+			)
+			("verbose,v", "Print the files and objects that are skipped.")
+			("help,h", "Show this help screen.");
+		po::positional_options_description positionalOptions;
+		positionalOptions.add("input-file", -1);
+
+		po::variables_map arguments;
+		po::store(po::command_line_parser(argc, argv).options(options).positional(positionalOptions).run(), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help") || inputPaths.empty() || repetitions == 0)
+		{
+			std::cout << options;
+			return arguments.count("help") ? 0 : 1;
+		}
+
+		EVMVersion evmVersion;
+		if (!evmVersionName.empty())
+		{
+			std::optional<EVMVersion> version = EVMVersion::fromString(evmVersionName);
+			if (!version)
+			{
+				std::cerr << "Invalid EVM version: " << evmVersionName << std::endl;
+				return 1;
+			}
+			evmVersion = *version;
+		}
+
+		std::vector<std::string> steps;
+		if (stepAbbreviations.empty())
+			for (auto const& step: OptimiserSuite::allSteps())
+				steps.push_back(step.first);
+		else
+			for (char abbreviation: stepAbbreviations)
+			{
+				auto const& stepNames = OptimiserSuite::stepAbbreviationToNameMap();
+				if (!stepNames.count(abbreviation))
+				{
+					std::cerr << "Invalid step abbreviation: " << abbreviation << std::endl;
+					return 1;
+				}
+				steps.push_back(stepNames.at(abbreviation));
+			}
+
+		Corpus corpus(evmVersion, arguments.count("verbose") > 0);
+		for (std::string const& path: inputPaths)
+			for (fs::path const& file: inputFiles(path))
+				corpus.addFile(file);
+		if (corpus.inputs().empty())
+		{
+			std::cerr << "No valid input found." << std::endl;
+			return 1;
+		}
+		std::cout <<
+			corpus.inputs().size() << " objects, " <<
+			corpus.skipped() << " files or objects skipped, " <<
+			repetitions << " repetitions" << std::endl << std::endl;
+
+		std::cout <<
+			std::left << std::setw(40) << "step" << std::right <<
+			std::setw(12) << "time (ms)" <<
+			std::setw(16) << "nodes/s" <<
+			std::setw(14) << "allocations" <<
+			std::setw(14) << "alloc/node" <<
+			std::setw(14) << "bytes/node" <<
+			std::setw(10) << "failures" << std::endl;
+
+		Json output;
+		output["objects"] = corpus.inputs().size();
+		output["repetitions"] = repetitions;
+		output["steps"] = Json::object();
+		for (std::string const& step: steps)
+		{
+			StepResult const result = benchmark(corpus, step, repetitions);
+			double const nodesPerSecond = result.bestDuration > 0.0 ? static_cast<double>(result.nodes) / result.bestDuration * 1e6 : 0.0;
+			double const nodes = static_cast<double>(std::max<size_t>(result.nodes, 1));
+			std::cout <<
+				std::left << std::setw(40) << (std::string(1, result.abbreviation) + " " + result.step) << std::right <<
+				std::fixed << std::setprecision(2) <<
+				std::setw(12) << result.bestDuration / 1000.0 <<
+				std::setprecision(0) << std::setw(16) << nodesPerSecond <<
+				std::setw(14) << result.allocations <<
+				std::setprecision(2) << std::setw(14) << static_cast<double>(result.allocations) / nodes <<
+				std::setprecision(1) << std::setw(14) << static_cast<double>(result.bytes) / nodes <<
+				std::setw(10) << result.failures << std::endl;
+
+			Json& stepOutput = output["steps"][result.step];
+			stepOutput["nodes"] = result.nodes;
+			stepOutput["durationMicroseconds"] = result.bestDuration;
+			stepOutput["nodesPerSecond"] = nodesPerSecond;
+			stepOutput["allocations"] = result.allocations;
+			stepOutput["allocatedBytes"] = result.bytes;
+			stepOutput["failures"] = result.failures;
+		}
+
+		if (!outputPath.empty())
+		{
+			std::ofstream file(outputPath);
+			file << util::jsonPrettyPrint(output) << std::endl;
+			if (!file)
+			{
+				std::cerr << "Could not write the results to " << outputPath << std::endl;
+				return 1;
+			}
+		}
+		return 0;
+	}
+	catch (po::error const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+	catch (std::exception const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,148 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Stress benchmark for the YulString repository: interns and resolves identifiers
+ * from many threads at once, similar to the access pattern of concurrent Yul optimisation.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Interns @a _count identifiers. Half of them are shared by all threads (as builtin and
+/// utility function names would be), the other half is private to the thread (as names
+/// created by the name dispenser would be). Every identifier is resolved again afterwards.
+size_t work(size_t _thread, size_t _count, size_t _round)
+{
+	size_t checksum = 0;
+	std::vector<YulString> names;
+	names.reserve(_count);
+	for (size_t i = 0; i < _count; ++i)
+		if (i % 2 == 0)
+			names.emplace_back("shared_identifier_" + std::to_string(i));
+		else
+			names.emplace_back("var_" + std::to_string(_round) + "_" + std::to_string(_thread) + "_" + std::to_string(i));
+	for (YulString const& name: names)
+		checksum += name.str().size();
+	return checksum;
+}
+
+double run(size_t _threads, size_t _count, size_t _round)
+{
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	std::vector<size_t> checksums(_threads);
+	for (size_t t = 0; t < _threads; ++t)
+		threads.emplace_back([&, t]() { checksums[t] = work(t, _count, _round); });
+	for (std::thread& thread: threads)
+		thread.join();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		std::vector<size_t> threadCounts;
+		size_t count = 0;
+		size_t repetitions = 0;
+		po::options_description options(
+			R"(yulstringbench, stress benchmark for the YulString repository.
+	Usage: yulstringbench [Options]
+	Interns identifiers from the given numbers of threads and reports the wall-clock
+	time of every round as well as the throughput of the fastest round.
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			(
+				"threads",
+				po::value<std::vector<size_t>>(&threadCounts)->multitoken()->default_value({1, 2, 4, 8}, "1 2 4 8"),
+				"numbers of threads to benchmark"
+			)
+			(
+				"strings",
+				po::value<size_t>(&count)->default_value(200000),
+				"number of identifiers interned by every thread per round"
+			)
+			(
+				"repetitions",
+				po::value<size_t>(&repetitions)->default_value(5),
+				"number of rounds per thread count"
+			)
+			("help,h", "Show this help screen.");
+
+		po::variables_map arguments;
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help"))
+		{
+			std::cout << options;
+			return 0;
+		}
+
+		size_t round = 0;
+		for (size_t threads: threadCounts)
+		{
+			if (threads == 0)
+				continue;
+			double best = 0.0;
+			std::cout << std::setw(3) << threads << " thread(s):";
+			for (size_t i = 0; i < repetitions; ++i)
+			{
+				double time = run(threads, count, round++);
+				std::cout << " " << std::fixed << std::setprecision(1) << time << "ms";
+				if (i == 0 || time < best)
+					best = time;
+			}
+			if (repetitions > 0)
+				std::cout <<
+					"  (best: " <<
+					std::fixed << std::setprecision(2) <<
+					static_cast<double>(threads * count) / best / 1000.0 <<
+					" M strings/s)";
+			std::cout << std::endl;
+		}
+		return 0;
+	}
+	catch (po::error const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+}